@@ -22,9 +22,11 @@
 #include "AST/ValueExpr.h"
 #include "../Objects/Callables/UserFunction.h"
 
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <stdexcept>
+#include <vector>
 
 #if !defined(_MSC_VER) and !defined(UNUSED_ATTRIBUTE)
 #define UNUSED_ATTRIBUTE __attribute__ ((unused))
@@ -46,18 +48,19 @@ Compiler::Compiler(Logger * _logger) : logger(_logger ? _logger : new StdLogger(
 }
 
 UserFunction * Compiler::compile(const CodeFragment & code){
+	// parse code and build syntax tree
+	Parser p(getLogger());
+	ERef<AST::Block> block = p.parse(code);
+	return compile(code,block.get());
+}
 
-	ERef<AST::Block> syntaxTreeRoot(AST::Block::createBlockStatement());
-
-	{// parse code and build syntax tree
-		Parser p(getLogger());
-		ERef<AST::Block> block = p.parse(code);
-		block->convertToExpression();
+UserFunction * Compiler::compile(const CodeFragment & code,AST::Block * syntaxTree){
 
-		// syntaxTreeRoot's outer Block is used to add a return statement: {return {block}}
-		syntaxTreeRoot->addStatement(new AST::ReturnStatement(block.get()));
-	}
+	ERef<AST::Block> syntaxTreeRoot(AST::Block::createBlockStatement());
+	syntaxTree->convertToExpression();
 
+	// syntaxTreeRoot's outer Block is used to add a return statement: {return {block}}
+	syntaxTreeRoot->addStatement(new AST::ReturnStatement(syntaxTree));
 
 	ERef<UserFunction> fun = new UserFunction;
 	fun->setCode(code);
@@ -158,6 +161,79 @@ void Compiler::throwError(FunCompileContext & ctxt,const std::string & msg)const
 
 // ------------------------------------------------------------------
 
+/*! (static,internal) If @p expr is a binary '+'-call ( a + b ), its left operand is returned; nullptr otherwise. */
+static EPtr<AST::ASTNode> getLeftSummand(EPtr<AST::ASTNode> expr){
+	using namespace AST;
+	FunctionCallExpr * fCall = expr.toType<FunctionCallExpr>();
+	if(fCall==nullptr || fCall->isSysCall() || fCall->isConstructorCall() || fCall->hasExpandingParameters() ||
+			fCall->getNumParams()!=1 || fCall->getParamExpression(0)==nullptr)
+		return nullptr;
+	GetAttributeExpr * gAttr = fCall->getGetFunctionExpression().toType<GetAttributeExpr>();
+	if(gAttr==nullptr || gAttr->getAttrId()!=Consts::IDENTIFIER_fn_plus)
+		return nullptr;
+	return gAttr->getObjectExpression();
+}
+
+/*! (static,internal) Returns true iff evaluating @p expr can not have side effects:
+	a constant or the value of a variable or of an attribute ( a.b.c ). */
+static bool isSideEffectFree(EPtr<AST::ASTNode> expr){
+	using namespace AST;
+	while(true){
+		switch(expr->getNodeType()){
+			case ASTNode::TYPE_VALUE_BOOL:
+			case ASTNode::TYPE_VALUE_FLOATING_POINT:
+			case ASTNode::TYPE_VALUE_IDENTIFIER:
+			case ASTNode::TYPE_VALUE_STRING:
+			case ASTNode::TYPE_VALUE_VOID:
+				return true;
+			case ASTNode::TYPE_GET_ATTRIBUTE_EXPRESSION:{
+				const EPtr<ASTNode> objExpr = expr.toType<GetAttributeExpr>()->getObjectExpression();
+				if(objExpr.isNull())
+					return true;
+				expr = objExpr;
+				break;
+			}
+			default:
+				return false;
+		}
+	}
+}
+
+/*! (static,internal) Compile a left-associative chain of binary '+'-calls ( leftmost + a + b ...).
+	@p calls are the '+'-calls in evaluation order (innermost first); the chain is walked only once
+	and its inner calls are not passed to the handler again.
+	If the chain starts with a string literal, the parts are joined by I_CONCAT ("<td>" + a + "</td>" + b).
+	As the parts are converted when they are joined, the pending parts are joined before a part with
+	possible side effects is evaluated; so the order of observable effects is the one of single '+'-calls.
+	Otherwise, the chain is compiled into regular '+' member calls. */
+static void addSummationChain(FunCompileContext & ctxt,EPtr<AST::ASTNode> leftmost,const std::vector<AST::FunctionCallExpr*> & calls){
+	using namespace AST;
+	ctxt.setLine(calls.front()->getLine());
+	ctxt.addExpression(leftmost);
+	if(leftmost->getNodeType()==ASTNode::TYPE_VALUE_STRING){
+		uint32_t numParts = 1;
+		for(const auto & call : calls){
+			const EPtr<ASTNode> summand = call->getParamExpression(0);
+			if(numParts>1 && !isSideEffectFree(summand)){
+				ctxt.setLine(call->getLine());
+				ctxt.addInstruction(Instruction::createConcat(numParts));
+				numParts = 1;
+			}
+			ctxt.addExpression(summand);
+			++numParts;
+		}
+		ctxt.setLine(calls.back()->getLine());
+		ctxt.addInstruction(Instruction::createConcat(numParts));
+	}else{
+		for(const auto & call : calls){
+			ctxt.addInstruction(Instruction::createDup());
+			ctxt.addInstruction(Instruction::createGetAttribute(Consts::IDENTIFIER_fn_plus));
+			ctxt.addExpression(call->getParamExpression(0));
+			ctxt.setLine(call->getLine()); // the operand may span several lines
+			ctxt.addInstruction(Instruction::createCall(1));
+		}
+	}
+}
 
 //! (static)
 bool initHandler(handlerRegistry_t & m){
@@ -327,6 +403,20 @@ bool initHandler(handlerRegistry_t & m){
 	ADD_HANDLER( ASTNode::TYPE_FUNCTION_CALL_EXPRESSION, FunctionCallExpr, {
 		ctxt.setLine(self->getLine());
 
+		{	// chain of '+'-calls: "foo" + a + "bar" + b ...
+			EPtr<ASTNode> leftmost = self;
+			std::vector<FunctionCallExpr*> calls;
+			for(EPtr<ASTNode> left = getLeftSummand(leftmost); left.isNotNull(); left = getLeftSummand(leftmost)){
+				calls.emplace_back(leftmost.toType<FunctionCallExpr>());
+				leftmost = left;
+			}
+			if(!calls.empty()){
+				std::reverse(calls.begin(),calls.end());
+				addSummationChain(ctxt,leftmost,calls);
+				break;
+			}
+		}
+
 		if(!self->isSysCall()){
 			do{
 				GetAttributeExpr * gAttr = self->getGetFunctionExpression().toType<GetAttributeExpr>();
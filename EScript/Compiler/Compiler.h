@@ -18,6 +18,7 @@ class FunCompileContext;
 class Logger;
 namespace AST{
 class ASTNode;
+class Block;
 }
 
 /*! Compiler
@@ -29,6 +30,9 @@ class Compiler {
 		Compiler(Logger * _logger = nullptr);
 
 		UserFunction * compile(const CodeFragment & code);
+		/*! Compile a syntax tree that has been created by Parser::parse(code) (e.g. on another thread).
+			\note The syntax tree is converted into an expression and attached to the compiled function's syntax tree.	*/
+		UserFunction * compile(const CodeFragment & code,AST::Block * syntaxTree);
 
 	// -------------
 
@@ -100,7 +100,7 @@ class FunCompileContext {
 		StringId getLocalVarName(const size_t index)const				{	return instructions.getLocalVarName(index);	}
 
 		size_t getNumLocalVars()const									{	return instructions.getNumLocalVars();	}
-		std::string getStringConstant(const uint32_t index)const		{	return instructions.getStringConstant(index);	}
+		std::string getStringConstant(const uint32_t index)const		{	return instructions.getStringConstant(index).str();	}
 		bool getUsesStaticVars()const									{	return usesStaticVars;	}
 
 		void markAsUsingStaticVars()									{	usesStaticVars = true;	}
@@ -12,71 +12,76 @@ Operator::operatorMap_t Operator::ops;
 
 //! (static)
 const Operator * Operator::getOperator(StringId id) {
-	if(ops.empty()){
-		int p=-1;
-		declareOperator(p   ,"UNKNOWN");
-		declareOperator(++p ,"_");
-		declareOperator(p ,"@",R);
-		declareOperator(++p ,".");
-		declareOperator(p   ,"[");
-		declareOperator(p   ,"]");
-		declareOperator(p   ,"(");
-		declareOperator(p   ,")");
+	static const bool initialized = declareOperators(); // thread safe initialization
+	(void)initialized;
+	operatorMap_t::const_iterator it = ops.find(id);
+	return  it==ops.end() ? nullptr : &it->second;
+}
 
-		declareOperator(++p ,"new");
-		declareOperator(++p ,"fn",R);
+//! (static,internal)
+bool Operator::declareOperators() {
+	int p=-1;
+	declareOperator(p   ,"UNKNOWN");
+	declareOperator(++p ,"_");
+	declareOperator(p ,"@",R);
+	declareOperator(++p ,".");
+	declareOperator(p   ,"[");
+	declareOperator(p   ,"]");
+	declareOperator(p   ,"(");
+	declareOperator(p   ,")");
+
+	declareOperator(++p ,"new");
+	declareOperator(++p ,"fn",R);
 //		declareOperator(++p ,"lambda",R);
 
-		declareOperator(++p ,"++",R);
-		declareOperator(p   ,"--",R);
-		declareOperator(p   ,"_-",R); // 2+-1
-		declareOperator(p   ,"~",R);
-		declareOperator(p   ,"!",R);
+	declareOperator(++p ,"++",R);
+	declareOperator(p   ,"--",R);
+	declareOperator(p   ,"_-",R); // 2+-1
+	declareOperator(p   ,"~",R);
+	declareOperator(p   ,"!",R);
 
-		declareOperator(++p ,"*");
-		declareOperator(p ,"/");
-		declareOperator(++p ,"%");
-		declareOperator(++p ,"+");
-		declareOperator(p ,"-");
-		declareOperator(++p ,"<<");
-		declareOperator(p ,">>");
-		declareOperator(++p ,"<");
-		declareOperator(p   ,">");
-		declareOperator(p   ,">=");
-		declareOperator(p   ,"<=");
-		declareOperator(p   ,"~=");
-		declareOperator(++p ,"==");
-		declareOperator(p   ,"!=");
-		declareOperator(p   ,"===");
-		declareOperator(p   ,"!==");
-		declareOperator(p   ,"---|>");
-		declareOperator(p   ,"isA");
-		declareOperator(p   ,"->"); // ??
-		declareOperator(++p ,"=>"); 
-		declareOperator(++p ,"&");
-		declareOperator(++p ,"^");
-		declareOperator(++p ,"|");
-		declareOperator(++p ,"&&",R);
-		declareOperator(++p ,"||",R);
+	declareOperator(++p ,"*");
+	declareOperator(p ,"/");
+	declareOperator(++p ,"%");
+	declareOperator(++p ,"+");
+	declareOperator(p ,"-");
+	declareOperator(++p ,"<<");
+	declareOperator(p ,">>");
+	declareOperator(++p ,"<");
+	declareOperator(p   ,">");
+	declareOperator(p   ,">=");
+	declareOperator(p   ,"<=");
+	declareOperator(p   ,"~=");
+	declareOperator(++p ,"==");
+	declareOperator(p   ,"!=");
+	declareOperator(p   ,"===");
+	declareOperator(p   ,"!==");
+	declareOperator(p   ,"---|>");
+	declareOperator(p   ,"isA");
+	declareOperator(p   ,"->"); // ??
+	declareOperator(++p ,"=>"); 
+	declareOperator(++p ,"&");
+	declareOperator(++p ,"^");
+	declareOperator(++p ,"|");
+	declareOperator(++p ,"&&",R);
+	declareOperator(++p ,"||",R);
 
-		//declareOperator(++p ,":");
-		declareOperator(++p ,"?");//R
-		declareOperator(++p ,"=",R);
-		declareOperator(++p ,":=",R);
-		declareOperator(++p ,"::=",R);
-		declareOperator(p   ,"*=",R);
-		declareOperator(p   ,"/=",R);
-		declareOperator(p   ,"%=",R);
-		declareOperator(p   ,"+=",R);
-		declareOperator(p   ,"-=",R);
-		declareOperator(p   ,"&=",R);
-		declareOperator(p   ,"^=",R);
-		declareOperator(p   ,"|=",R);
-		declareOperator(++p ,"...");
-		declareOperator(++p ,",");
-	}
-	operatorMap_t::const_iterator it = ops.find(id);
-	return  it==ops.end() ? nullptr : &it->second;
+	//declareOperator(++p ,":");
+	declareOperator(++p ,"?");//R
+	declareOperator(++p ,"=",R);
+	declareOperator(++p ,":=",R);
+	declareOperator(++p ,"::=",R);
+	declareOperator(p   ,"*=",R);
+	declareOperator(p   ,"/=",R);
+	declareOperator(p   ,"%=",R);
+	declareOperator(p   ,"+=",R);
+	declareOperator(p   ,"-=",R);
+	declareOperator(p   ,"&=",R);
+	declareOperator(p   ,"^=",R);
+	declareOperator(p   ,"|=",R);
+	declareOperator(++p ,"...");
+	declareOperator(++p ,",");
+	return true;
 }
 
 //! (static)
@@ -28,6 +28,7 @@ class Operator {
 		typedef std::unordered_map<StringId,Operator> operatorMap_t;
 		static operatorMap_t ops;
 		static void declareOperator(int precedence,const std::string & op,associativity_t associativity = L);
+		static bool declareOperators();
 
 		Operator(StringId id,int precedence,const std::string & _s,associativity_t associativity = L);
 
@@ -22,6 +22,7 @@
 #include "../Utils/IO/IO.h"
 
 #include <stdio.h>
+#include <mutex>
 #include <stack>
 #include <sstream>
 
@@ -64,7 +65,7 @@ Parser::Parser(Logger * _logger) :
 	//ctor
 }
 
-void Parser::log(ParsingContext & ctxt,Logger::level_t messageLevel, const std::string & msg,const _CountedRef<Token> & token)const{
+void Parser::log(ParsingContext & ctxt,Logger::level_t messageLevel, const std::string & msg,const Token * token)const{
 	std::ostringstream os;
 	os << "[Parser] " << msg << " (" << ctxt.code.getFilename();
 	if(token!=nullptr)
@@ -76,16 +77,19 @@ void Parser::log(ParsingContext & ctxt,Logger::level_t messageLevel, const std::
 ERef<AST::Block> Parser::parse(const CodeFragment & code) {
 	ERef<AST::Block> rootBlock = AST::Block::createBlockExpression();
 
-	tokenizer.defineToken("__FILE__",new TValueString(code.getFilename()));
-	tokenizer.defineToken("__DIR__",new TValueString(IO::dirname(code.getFilename())));
+	const std::string & filename = tokenizer.storeString(code.getFilename());
+	const std::string & dirname = tokenizer.storeString(IO::dirname(filename));
+	tokenizer.defineToken("__FILE__",TValueString::create(filename.data(),filename.length()));
+	tokenizer.defineToken("__DIR__",TValueString::create(dirname.data(),dirname.length()));
 
 	Tokenizer::tokenList_t tokens;
 	ParsingContext ctxt(tokens,code);
 	ctxt.rootBlock = rootBlock.get();
 
 	/// 1. Tokenize
+	const std::string codeString = code.getCodeString(); // referenced by the tokens
 	try {
-		tokenizer.getTokens(code.getCodeString(),tokens); //! \todo Use codeFragment for Tokenizer
+		tokenizer.getTokens(codeString,tokens); //! \todo Use codeFragment for Tokenizer
 		pass_1(ctxt);
 	} catch (Exception * e) {
 		//std::cerr << e->toString() << std::endl;
@@ -97,6 +101,7 @@ ERef<AST::Block> Parser::parse(const CodeFragment & code) {
 		pass_2(ctxt,enrichedTokens);
 		tokens.swap(enrichedTokens);
 	}
+	linkBrackets(ctxt);
 
 	/// 3. Parse expressions
 	int cursor = 0;
@@ -107,13 +112,13 @@ ERef<AST::Block> Parser::parse(const CodeFragment & code) {
 
 //! [Helper]
 struct _BracketInfo {
-	Token * token;
+	const Token * token;
 	unsigned int index;
 	bool isBlockOrMap, containsColon, containsCommands,
 		nextCBlockIsSwitchCaseBlock,isSwitchCaseBlock;
 	int shortIf; // a?b:c
 
-	_BracketInfo(unsigned int _index = 0,Token * _token = nullptr):
+	_BracketInfo(unsigned int _index = 0,const Token * _token = nullptr):
 			token(_token),index(_index),
 			isBlockOrMap(false),
 			containsColon(false),containsCommands(false),
@@ -136,7 +141,7 @@ void Parser::pass_1(ParsingContext & ctxt) {
 	bInfStack.push(_BracketInfo());
 
 	for(size_t cursor = 0;cursor<tokens.size();++cursor) {
-		Token * token = tokens.at(cursor).get();
+		const Token * token = &tokens.at(cursor);
 		/// currentBlockInfo
 		_BracketInfo & cbi = bInfStack.top();
 		switch(token->getType()){
@@ -180,16 +185,13 @@ void Parser::pass_1(ParsingContext & ctxt) {
 				/// Block is Map Constructor
 				if( cbi.containsColon && !cbi.isSwitchCaseBlock) {
 					unsigned int startIndex = cbi.index;
-					Token * t = new TStartMap;
-					if( !tokens.at(startIndex).isNull() )
-						t->setLine((tokens.at(startIndex))->getLine());
-
+					Token t = TStartMap::create();
+					t.setLine(tokens.at(startIndex).getLine());
 					tokens[startIndex] = t;
-					t = new TEndMap;
-					if( !tokens.at(cursor).isNull() )
-						t->setLine((tokens.at(cursor))->getLine());
 
-					tokens[cursor]=t;
+					t = TEndMap::create();
+					t.setLine(tokens.at(cursor).getLine());
+					tokens[cursor] = t;
 				}
 				bInfStack.pop();
 				continue;
@@ -214,14 +216,9 @@ void Parser::pass_1(ParsingContext & ctxt) {
 					throwError(ctxt,"Syntax error in Block: ':'",token);
 				} else { /// block is a map constructor
 					cbi.containsColon = true;
-					Token * t = new TMapDelimiter;
-
-					if((tokens.at(cursor))!=nullptr)
-						t->setLine((tokens.at(cursor).get())->getLine());
-//					Token::removeReference(tokens.at(cursor));
-
-					tokens[cursor]=t;
-//					Token::addReference(t);
+					Token t = TMapDelimiter::create();
+					t.setLine(tokens.at(cursor).getLine());
+					tokens[cursor] = t;
 					continue;
 				}
 			} else if(Token::isA<TEndCommand>(token)) {
@@ -254,7 +251,7 @@ void Parser::pass_1(ParsingContext & ctxt) {
  * ?????- TODO: Undefined scope for i: "{ var i;  do{ var i; }while(var i); }"
  */
 void Parser::pass_2(ParsingContext & ctxt,
-					Tokenizer::tokenList_t & enrichedTokens)const  {
+					Tokenizer::tokenList_t & enrichedTokens)  {
 
 	std::stack<Block *> blockStack;
 	blockStack.push(ctxt.rootBlock);
@@ -263,70 +260,64 @@ void Parser::pass_2(ParsingContext & ctxt,
 	/// If the top value reaches 0 after reading a TEndBlock, the fn-wrapper brackets have to be closed.
 	std::stack<int> functionBracketDepth;
 
-	std::stack<TStartBracket*> currentBracket;
-
 	/// for(...) ---> for{...}
-	std::stack<Token*> loopConditionEndingBrackets;
+	std::stack<size_t> loopConditionEndingBrackets;
 
-	enrichedTokens.reserve(ctxt.tokens.size());
+	enrichedTokens.reserve(ctxt.tokens.size()+ctxt.tokens.size()/8);
 
-	TStartBlock * tsb = new TStartBlock(ctxt.rootBlock);
-//	Token::addReference(tsb);
-	enrichedTokens.push_back(tsb);
+	enrichedTokens.push_back(TStartBlock::create(ctxt.rootBlock));
 
 	for(size_t cursor = 0;cursor<ctxt.tokens.size();++cursor) {
-		Token * token = ctxt.tokens.at(cursor).get();
+		Token token = ctxt.tokens.at(cursor);
 
 		/// for(...) ---> for{...}
-		if(!loopConditionEndingBrackets.empty() && token == loopConditionEndingBrackets.top()){
+		if(!loopConditionEndingBrackets.empty() && cursor == loopConditionEndingBrackets.top()){
 			loopConditionEndingBrackets.pop();
-			Token * t = new TEndBlock;
-			t->setLine(token->getLine());
-//			Token::addReference(t);
-			token = t;
+			const int line = token.getLine();
+			token = TEndBlock::create();
+			token.setLine(line);
 		}
 
 
-		switch(token->getType()){
+		switch(token.getType()){
 			case TControl::TYPE_ID:{
-				TControl * tc = Token::cast<TControl>(token);
 				/// Variable Declaration
-				if(tc->getId()==Consts::IDENTIFIER_var) {
-					if(TIdentifier * ti = Token::cast<TIdentifier>(ctxt.tokens.at(cursor+1))) {
+				if(token.getId()==Consts::IDENTIFIER_var) {
+					if(const Token * ti = Token::cast<TIdentifier>(ctxt.tokens.at(cursor+1))) {
 						if(!blockStack.top()->declareLocalVar(ti->getId())){
 							log(ctxt,Logger::LOG_WARNING, "Duplicate local variable '"+ti->toString()+'\'',ti);
 						}
 						continue;
 					} else
-						throwError(ctxt,"var expects identifier.",tc);
+						throwError(ctxt,"var expects identifier.",token);
 				}
 				/// Static variable Declaration
-				else if(tc->getId()==Consts::IDENTIFIER_static) {
-					if(TIdentifier * ti = Token::cast<TIdentifier>(ctxt.tokens.at(cursor+1))) {
+				else if(token.getId()==Consts::IDENTIFIER_static) {
+					if(const Token * ti = Token::cast<TIdentifier>(ctxt.tokens.at(cursor+1))) {
 						if(!blockStack.top()->declareStaticVar(ti->getId())){
 							log(ctxt,Logger::LOG_WARNING, "Duplicate static variable '"+ti->toString()+'\'',ti);
 						}
 						continue;
 					} else
-						throwError(ctxt,"static expects identifier.",tc);
+						throwError(ctxt,"static expects identifier.",token);
 				}
 				/// for(...) ---> for{...}
-				else if(tc->getId()==Consts::IDENTIFIER_for || tc->getId()==Consts::IDENTIFIER_foreach || tc->getId()==Consts::IDENTIFIER_while){
-					if( ctxt.tokens.at(cursor+1)->getType()!=TStartBracket::TYPE_ID )
-						throwError(ctxt,tc->toString()+" expects '('",tc);
+				else if(token.getId()==Consts::IDENTIFIER_for || token.getId()==Consts::IDENTIFIER_foreach || token.getId()==Consts::IDENTIFIER_while){
+					if( ctxt.tokens.at(cursor+1).getType()!=TStartBracket::TYPE_ID )
+						throwError(ctxt,token.toString()+" expects '('",token);
 					int endPos = findCorrespondingBracket<TStartBracket,TEndBracket>(ctxt,cursor+1);
 					if(endPos<0)
-						throwError(ctxt,"Error in loop condition",tc);
-					loopConditionEndingBrackets.push(ctxt.tokens.at(endPos).get());
+						throwError(ctxt,"Error in loop condition",token);
+					loopConditionEndingBrackets.push(endPos);
 
 					enrichedTokens.push_back(token);
 					++cursor;
-					Block * loopConditionBlock = Block::createBlockStatement(tc->getLine());
+					Block * loopConditionBlock = Block::createBlockStatement(token.getLine());
+					ctxt.tokenBlocks.push_back(loopConditionBlock);
 					blockStack.push(loopConditionBlock);
 
-					TStartBlock * sb = new TStartBlock(loopConditionBlock);
-					sb->setLine(token->getLine());
-//					Token::addReference(sb);
+					Token sb = TStartBlock::create(loopConditionBlock);
+					sb.setLine(token.getLine());
 					enrichedTokens.push_back(sb);
 
 					// count open bracket.
@@ -340,12 +331,11 @@ void Parser::pass_2(ParsingContext & ctxt,
 			}
 			/// Open new Block
 			case TStartBlock::TYPE_ID:{
-				TStartBlock * sb = Token::cast<TStartBlock>(token);
-
-				Block * currentBlock = Block::createBlockExpression(sb->getLine());
+				Block * currentBlock = Block::createBlockExpression(token.getLine());
+				ctxt.tokenBlocks.push_back(currentBlock);
 
 				blockStack.push(currentBlock);
-				sb->setBlock(currentBlock);
+				token.setBlock(currentBlock);
 				enrichedTokens.push_back(token);
 
 				if(!functionBracketDepth.empty())
@@ -366,22 +356,12 @@ void Parser::pass_2(ParsingContext & ctxt,
 
 					if(functionBracketDepth.top()==0){
 						functionBracketDepth.pop();
-						Token * t = new TEndBracket;
-						t->setLine(token->getLine());
-						enrichedTokens.push_back(t);
-
-						// add shortcut to the closing bracket
-						currentBracket.top()->endBracketIndex = enrichedTokens.size()-1;
-						currentBracket.pop();
+						Token t = TEndBracket::create();
+						t.setLine(token.getLine());
 
-						// second closing bracket
-						t = new TEndBracket;
-						t->setLine(token->getLine());
+						// closing bracket and second closing bracket
+						enrichedTokens.push_back(t);
 						enrichedTokens.push_back(t);
-
-						// add shortcut to the closing bracket
-						currentBracket.top()->endBracketIndex = enrichedTokens.size()-1;
-						currentBracket.pop();
 					}
 				}
 				continue;
@@ -391,7 +371,6 @@ void Parser::pass_2(ParsingContext & ctxt,
 				enrichedTokens.push_back(token);
 				if(!functionBracketDepth.empty())
 					++functionBracketDepth.top();
-				currentBracket.push(Token::cast<TStartBracket>(token));
 				continue;
 			}
 			/// )
@@ -399,51 +378,37 @@ void Parser::pass_2(ParsingContext & ctxt,
 				enrichedTokens.push_back(token);
 				if(!functionBracketDepth.empty())
 					--functionBracketDepth.top();
-				if(currentBracket.empty())
-					throwError(ctxt,"Missing opening bracket for ",token);
-
-				// add shortcut to the closing bracket
-				currentBracket.top()->endBracketIndex = enrichedTokens.size()-1;
-				currentBracket.pop();
 				continue;
 			}
 			// "part1" "part2"
 			case TValueString::TYPE_ID:{
-				enrichedTokens.push_back(token);
-
 				// no consecutive strings?
-				if( ctxt.tokens.at(cursor+1)->getType()!=TValueString::TYPE_ID ){
+				if( ctxt.tokens.at(cursor+1).getType()!=TValueString::TYPE_ID ){
+					enrichedTokens.push_back(token);
 					continue;
 				}
-				std::stringstream os;
-
-				TValueString * ts;
-				while( (ts = Token::cast<TValueString>(ctxt.tokens.at(cursor)))!=nullptr ){
-					os << ts->getValue();
-					++cursor;
-				}
+				std::string s;
+				for(;ctxt.tokens.at(cursor).getType()==TValueString::TYPE_ID; ++cursor)
+					s.append(ctxt.tokens.at(cursor).getStringBegin(),ctxt.tokens.at(cursor).getStringLength());
 				--cursor;
 
-				Token::cast<TValueString>(token)->setString(os.str());
+				const std::string & stored = tokenizer.storeString(std::move(s));
+				token.setString(stored.data(),stored.length());
+				enrichedTokens.push_back(token);
 				continue;
 			}
 			/// fn(foo,bar){...}  ---> (fn( (foo,bar){} ))
 			case TOperator::TYPE_ID:{
-				if( token->toString() == "fn"  ) {
+				if( token.toString() == "fn"  ) {
 					functionBracketDepth.push(0);
 
+					Token t = TStartBracket::create();
+					t.setLine(token.getLine());
+
 					// bracket before 'fn'
-					TStartBracket * t = new TStartBracket;
-					t->setLine(token->getLine());
-					currentBracket.push(t);
 					enrichedTokens.push_back(t);
-
 					enrichedTokens.push_back(token);
-
 					// bracket after 'fn'
-					t = new TStartBracket;
-					t->setLine(token->getLine());
-					currentBracket.push(t);
 					enrichedTokens.push_back(t);
 				}else{
 					enrichedTokens.push_back(token);
@@ -456,8 +421,8 @@ void Parser::pass_2(ParsingContext & ctxt,
 				if(!blockStack.empty())
 					throwError(ctxt,"Unclosed {");
 
-				Token * t = new TEndBlock;
-				t->setLine(token->getLine());
+				Token t = TEndBlock::create();
+				t.setLine(token.getLine());
 				enrichedTokens.push_back(t);
 				enrichedTokens.push_back(token);
 				return;
@@ -470,6 +435,36 @@ void Parser::pass_2(ParsingContext & ctxt,
 	}
 }
 
+/*!	Store the index of the corresponding closing token in each opening token ( ( [ { _{ ).
+	The brackets have already been checked by pass_1, so the kind of the brackets can be ignored here. */
+void Parser::linkBrackets(ParsingContext & ctxt)const{
+	Tokenizer::tokenList_t & tokens = ctxt.tokens;
+	std::vector<size_t> openBrackets;
+	for(size_t i = 0;i<tokens.size();++i){
+		switch(tokens[i].getType()){
+			case TStartBracket::TYPE_ID:
+			case TStartIndex::TYPE_ID:
+			case TStartBlock::TYPE_ID:
+			case TStartMap::TYPE_ID:{
+				openBrackets.push_back(i);
+				continue;
+			}
+			case TEndBracket::TYPE_ID:
+			case TEndIndex::TYPE_ID:
+			case TEndBlock::TYPE_ID:
+			case TEndMap::TYPE_ID:{
+				if(openBrackets.empty())
+					throwError(ctxt,"Missing opening bracket for ",tokens[i]);
+				tokens[openBrackets.back()].setEndBracketIndex(i);
+				openBrackets.pop_back();
+				continue;
+			}
+			default:{
+			}
+		}
+	}
+}
+
 /*! read an expression
  * \note @p cursor is moved to @p to, or an exception is thrown.
  */
@@ -500,25 +495,25 @@ EPtr<AST::ASTNode> Parser::readExpression(ParsingContext & ctxt,int & cursor,int
 	///  Single Element
 	/// -------------------
 	else if(to==cursor) {
-		Token *t =tokens.at(cursor).get();
+		const Token *t = &tokens.at(cursor);
 
 		/// Empty Command
 		if(Token::isA<TEndCommand>(t)) {
 			return nullptr;
-		}else if(TValueBool * tb = Token::cast<TValueBool>(t)) {
-			return new BoolValueExpr(tb->getValue());
-		}else if(TValueNumber * tn = Token::cast<TValueNumber>(t)) {
-			return new NumberValueExpr(tn->getValue());
-		}else if(TValueIdentifier * ti = Token::cast<TValueIdentifier>(t)) {
-			return new IdentifierValueExpr(ti->getValue());
-		}else if(TValueString * ts = Token::cast<TValueString>(t)) {
-			return new StringValueExpr(ts->getValue());
+		}else if(const Token * tb = Token::cast<TValueBool>(t)) {
+			return new BoolValueExpr(tb->getBool());
+		}else if(const Token * tn = Token::cast<TValueNumber>(t)) {
+			return new NumberValueExpr(tn->getNumber());
+		}else if(const Token * ti = Token::cast<TValueIdentifier>(t)) {
+			return new IdentifierValueExpr(ti->getId());
+		}else if(const Token * ts = Token::cast<TValueString>(t)) {
+			return new StringValueExpr(ts->getString());
 		}else if(Token::isA<TValueVoid>(t)) {
 			return new VoidValueExpr;
 		}
 		///  Identifier
 		/// "a" => "_.get('a')"
-		else if(TIdentifier * ident = Token::cast<TIdentifier>(t)) {
+		else if(const Token * ident = Token::cast<TIdentifier>(t)) {
 //			// is local variable?
 //			for(int i = ctxt.blocks.size()-1;i>=0;--i){
 //				Block * b = ctxt.blocks.at(i);
@@ -547,8 +542,7 @@ EPtr<AST::ASTNode> Parser::readExpression(ParsingContext & ctxt,int & cursor,int
 	/// "(a+2)"
 	/// --------------------------
 	else if(Token::isA<TStartBracket>(tokens.at(cursor)) &&
-			 Token::isA<TEndBracket>(tokens[to]) &&
-			 findCorrespondingBracket<TStartBracket,TEndBracket>(ctxt,cursor,to,1)==to) {
+			 tokens[cursor].getEndBracketIndex()==static_cast<size_t>(to)) {
 
 		++cursor; // step over '('
 		EPtr<AST::ASTNode> innerExpression = readExpression(ctxt,cursor,to-1);
@@ -561,8 +555,7 @@ EPtr<AST::ASTNode> Parser::readExpression(ParsingContext & ctxt,int & cursor,int
 	/// "{foo:bar,2:3}"
 	/// --------------------------
 	if(Token::isA<TStartMap>(tokens.at(cursor)) &&
-		Token::isA<TEndMap>(tokens[to]) &&
-		findCorrespondingBracket<TStartMap,TEndMap>(ctxt,cursor,to,1) == to) {
+		tokens[cursor].getEndBracketIndex()==static_cast<size_t>(to)) {
 		return readMap(ctxt,cursor);
 	}
 
@@ -630,7 +623,7 @@ EPtr<AST::ASTNode> Parser::readStatement(ParsingContext & ctxt,int & cursor)cons
 		block->convertToStatement();
 		return block;
 	} /// annotated statement
-	else if(Token::isA<TOperator>(token) && token->toString()=="@") {
+	else if(Token::isA<TOperator>(token) && token.toString()=="@") {
 		return readAnnotatedStatement(ctxt,cursor);
 	}/// expression
 	else{
@@ -639,10 +632,10 @@ EPtr<AST::ASTNode> Parser::readStatement(ParsingContext & ctxt,int & cursor)cons
 
 }
 
-void Parser::assertTokenIsStatemetEnding(ParsingContext& ctxt,Token* token)const{
+void Parser::assertTokenIsStatemetEnding(ParsingContext& ctxt,const Token & token)const{
 	/// Commands have to end on ";" or "}".
 	if(!(Token::isA<TEndCommand>(token) || Token::isA<TEndBlock>(token))) {
-		log(ctxt,Logger::LOG_DEBUG, token->toString(),token);
+		log(ctxt,Logger::LOG_DEBUG, token.toString(),token);
 		throwError(ctxt,"Syntax error in Block (Missing ';' ?).",token);
 	}
 }
@@ -651,10 +644,10 @@ void Parser::assertTokenIsStatemetEnding(ParsingContext& ctxt,Token* token)const
 	Used when reading blocks by readBlockExpression or when reading
 	a case block.
 	\note The issued warning has LOG_PEDANTIC_WARNING level.*/
-void Parser::warnOnShadowedLocalVars(ParsingContext & ctxt,TStartBlock * tBlock)const{
+void Parser::warnOnShadowedLocalVars(ParsingContext & ctxt,const Token & tBlock)const{
 	if(ctxt.blocks.empty())
 		return;
-	auto block = tBlock->getBlock();
+	auto block = tBlock.getBlock();
 	const auto & vars = block->getVars();
 	if(vars.empty())
 		return;
@@ -677,13 +670,13 @@ void Parser::warnOnShadowedLocalVars(ParsingContext & ctxt,TStartBlock * tBlock)
  */
 Block * Parser::readBlockExpression(ParsingContext & ctxt,int & cursor)const {
 	const Tokenizer::tokenList_t & tokens = ctxt.tokens;
-	TStartBlock * tsb = Token::cast<TStartBlock>(tokens.at(cursor));
+	const Token * tsb = Token::cast<TStartBlock>(tokens.at(cursor));
 	Block * b = tsb?reinterpret_cast<Block *>(tsb->getBlock()):nullptr;
 	if(b==nullptr)
 		throwError(ctxt,"No Block!",tokens.at(cursor));
 	++cursor;
 
-	warnOnShadowedLocalVars(ctxt,tsb);
+	warnOnShadowedLocalVars(ctxt,*tsb);
 	ctxt.blocks.push_back(b);
 
 	/// Read commands.
@@ -691,14 +684,14 @@ Block * Parser::readBlockExpression(ParsingContext & ctxt,int & cursor)const {
 		if(Token::isA<TEndScript>(tokens.at(cursor)))
 			throwError(ctxt,"Unclosed Block {...",tsb);
 
-		const int line = tokens.at(cursor)->getLine();
+		const int line = tokens.at(cursor).getLine();
 		EPtr<AST::ASTNode> stmt = readStatement(ctxt,cursor);
 
 		if(stmt.isNotNull()){
 			b->addStatement(stmt);
 			stmt->setLine(line);
 		}
-		assertTokenIsStatemetEnding(ctxt,tokens.at(cursor).get());
+		assertTokenIsStatemetEnding(ctxt,tokens.at(cursor));
 		++cursor;
 	}
 	ctxt.blocks.pop_back();
@@ -714,7 +707,7 @@ EPtr<AST::ASTNode> Parser::readMap(ParsingContext & ctxt,int & cursor)const  {
 	// for debugging
 	int currentLine=-1;
 	{
-		const Token * t = tokens.at(cursor).get();
+		const Token * t = &tokens.at(cursor);
 		if(t)
 			currentLine = t->getLine();
 	}
@@ -739,7 +732,7 @@ EPtr<AST::ASTNode> Parser::readMap(ParsingContext & ctxt,int & cursor)const  {
 
 		/// ii) read ":"
 		if(!Token::isA<TMapDelimiter>(tokens.at(cursor))) {
-			log(ctxt,Logger::LOG_DEBUG, tokens.at(cursor)->toString(),tokens.at(cursor));
+			log(ctxt,Logger::LOG_DEBUG, tokens.at(cursor).toString(),tokens.at(cursor));
 			throwError(ctxt,"Map: Expected : ",tokens.at(cursor));
 		}
 		++cursor;
@@ -768,55 +761,133 @@ EPtr<AST::ASTNode> Parser::readMap(ParsingContext & ctxt,int & cursor)const  {
 
 }
 
-/*!	read binary expression
-	\note called by readExpression
-	\note If the syntax is correct, @p cursor equals @p to after returning.
-			readExpression issues an SyntaxError otherwise.
-*/
-EPtr<AST::ASTNode> Parser::readBinaryExpression(ParsingContext & ctxt,int & cursor,int to)const  {
-	const Tokenizer::tokenList_t & tokens = ctxt.tokens;
-	int currentLine = tokens.at(cursor).isNull() ? -1 : tokens.at(cursor)->getLine();
+//! (internal) The splitting operators of the sub-ranges are only cached for expressions with more operators.
+static const int MIN_NUM_CACHED_OPERATORS = 8;
 
-	int opPosition=-1; /// Position of operator with lowest precedence
-	int opPrecedence=-1; /// Highest precedence
-	const Operator * op = nullptr;
+//! (internal) Key of the token range [from,to] in ParsingContext::splittingOperators
+static inline uint64_t rangeKey(int from,int to){
+	return (static_cast<uint64_t>(static_cast<uint32_t>(from))<<32) | static_cast<uint32_t>(to);
+}
 
-	/// search operator with lowest precedence
+/*!	Returns the position of the operator a binary expression in [from,to] is split at (or -1): the operator
+	with the lowest precedence outside of brackets. Of several such operators, the rightmost left associative one
+	is used or, if there is none, the leftmost one.
+	The expression's sub-ranges are split at the same operators as the whole range (the operators form a
+	Cartesian tree), so the splitting operators of all nested sub-ranges are determined by this single scan and are
+	stored in ctxt.splittingOperators. This way, long chains like "a+b+c+..." are read in linear time.
+	(Short expressions are simply scanned again.)	*/
+int Parser::findSplittingOperator(ParsingContext & ctxt,int from,int to)const{
+	const Tokenizer::tokenList_t & tokens = ctxt.tokens;
 
+	/// collect the operators outside of brackets
+	std::vector<int> & operators = ctxt.operatorPositions;
+	operators.clear();
 	int level = 0; /// BracketLevel ( ) [] {}
-	for(int i = cursor;i<=to;++i) {
-		Token * t = tokens.at(i).get();
-		if(level==0) {
-			TOperator * top = Token::cast<TOperator>(t);
-			if(top &&
-					(top->getAssociativity()==Operator::L?
-					 top->getPrecedence() >= opPrecedence :
-					 top->getPrecedence() > opPrecedence)) {
-				opPrecedence = top->getPrecedence();
-				opPosition = i;
-				op = top->getOperator();
-				currentLine = top->getLine();
+	for(int i = from;i<=to;++i) {
+		const Token & t = tokens[i];
+		if(level==0 && Token::isA<TOperator>(t))
+			operators.push_back(i);
+		switch(t.getType()){
+			case TStartBracket::TYPE_ID:
+			case TStartIndex::TYPE_ID:
+			case TStartBlock::TYPE_ID:
+			case TStartMap::TYPE_ID:{
+				/// skip the enclosed tokens
+				if(t.getEndBracketIndex()>static_cast<size_t>(i) && t.getEndBracketIndex()<=static_cast<size_t>(to)){
+					i = static_cast<int>(t.getEndBracketIndex());
+				}else{
+					++level;
+				}
+				continue;
+			}
+			case TEndBracket::TYPE_ID:
+			case TEndIndex::TYPE_ID:
+			case TEndBlock::TYPE_ID:
+			case TEndMap::TYPE_ID:{
+				--level;
+				if(level<0)
+					throwError(ctxt,"Error in binary expression",t);
+				continue;
+			}
+			default:{
 			}
 		}
-		if(Token::isA<TStartBlock>(t)
-				||Token::isA<TStartBracket>(t)
-				||Token::isA<TStartIndex>(t)
-				||Token::isA<TStartMap>(t)) {
-			++level;
+	}
+	if(operators.empty())
+		return -1;
+	else if(operators.size()==1)
+		return operators.front();
+
+	/// true iff the expression is rather split at operator a than at operator b
+	auto splitsFirst = [&tokens](int a,int b){
+		const Token & ta = tokens[a];
+		const Token & tb = tokens[b];
+		if(ta.getPrecedence()!=tb.getPrecedence())
+			return ta.getPrecedence() > tb.getPrecedence();
+		const bool aIsL = ta.getAssociativity()==Operator::L;
+		if(aIsL != (tb.getAssociativity()==Operator::L))
+			return aIsL;
+		return aIsL ? a>b : a<b;
+	};
+
+	/// For each operator, the nearest operators on the left and on the right the expression is split at first
+	/// bound the sub-range that is split at this operator.
+	const int numOperators = static_cast<int>(operators.size());
+	if(numOperators<MIN_NUM_CACHED_OPERATORS){
+		int opPosition = operators.front();
+		for(int j = 1;j<numOperators;++j){
+			if(splitsFirst(operators[j],opPosition))
+				opPosition = operators[j];
+		}
+		return opPosition;
+	}
+	std::vector<int> leftBound(numOperators,-1), rightBound(numOperators,numOperators);
+	std::vector<int> stack;
+	for(int j = 0;j<numOperators;++j){
+		while(!stack.empty() && splitsFirst(operators[j],operators[stack.back()])){
+			rightBound[stack.back()] = j;
+			stack.pop_back();
+		}
+		if(!stack.empty())
+			leftBound[j] = stack.back();
+		stack.push_back(j);
+	}
+	const int root = stack.front();
+	for(int j = 0;j<numOperators;++j){
+		if(j==root)
 			continue;
-		} else if(Token::isA<TEndBlock>(t)
-				   ||Token::isA<TEndBracket>(t)
-				   ||Token::isA<TEndIndex>(t)
-				   ||Token::isA<TEndMap>(t)) {
-			--level;
-			if(level<0) {
-				throwError(ctxt,"Error in binary expression",t);
-			}
+		/// A sub-range beginning inside of brackets is never read on its own.
+		if(leftBound[j]>=0 && (Token::isA<TStartBracket>(tokens[operators[leftBound[j]]]) ||
+								Token::isA<TStartIndex>(tokens[operators[leftBound[j]]])))
 			continue;
+		const int subFrom = leftBound[j]<0 ? from : operators[leftBound[j]]+1;
+		const int subTo = rightBound[j]>=numOperators ? to : operators[rightBound[j]]-1;
+		ctxt.splittingOperators[rangeKey(subFrom,subTo)] = operators[j];
+	}
+	return operators[root];
+}
 
-		}
+/*!	read binary expression
+	\note called by readExpression
+	\note If the syntax is correct, @p cursor equals @p to after returning.
+			readExpression issues an SyntaxError otherwise.
+*/
+EPtr<AST::ASTNode> Parser::readBinaryExpression(ParsingContext & ctxt,int & cursor,int to)const  {
+	const Tokenizer::tokenList_t & tokens = ctxt.tokens;
+
+	/// Position of operator with lowest precedence
+	int opPosition;
+	const auto cachedSplit = ctxt.splittingOperators.find(rangeKey(cursor,to));
+	if(cachedSplit!=ctxt.splittingOperators.end()){
+		opPosition = cachedSplit->second;
+		ctxt.splittingOperators.erase(cachedSplit);
+	}else{
+		opPosition = findSplittingOperator(ctxt,cursor,to);
 	}
-	if(opPosition<0 || !op) return nullptr;
+	if(opPosition<0) return nullptr;
+
+	const Operator * op = tokens[opPosition].getOperator();
+	const int currentLine = tokens[opPosition].getLine();
 
 	int rightExprFrom = opPosition+1;
 	int leftExprFrom = cursor,leftExprTo = opPosition-1;
@@ -855,7 +926,7 @@ EPtr<AST::ASTNode> Parser::readBinaryExpression(ParsingContext & ctxt,int & curs
 		///                       leftExpr      annotation        rightExpr
 		if( Token::isA<TEndBracket>(tokens[leftExprTo]) ){
 			int annotationStart = findCorrespondingBracket<TEndBracket,TStartBracket>(ctxt,leftExprTo,leftExprFrom,-1);
-			TOperator * atOp = Token::cast<TOperator>(tokens.at(annotationStart-1));
+			const Token * atOp = Token::cast<TOperator>(tokens.at(annotationStart-1));
 			if(annotationStart>0 && atOp!=nullptr && atOp->toString()=="@"){
 				const auto annotations = readAnnotation(ctxt,annotationStart+1,leftExprTo-1);
 				leftExprTo = annotationStart-2;
@@ -946,10 +1017,10 @@ EPtr<AST::ASTNode> Parser::readBinaryExpression(ParsingContext & ctxt,int & curs
 			return new GetAttributeExpr(leftExpression,Token::cast<TOperator>(tokens[cursor])->toString());
 		} /// "a.'+'"
 		else if(Token::isA<TValueString>(tokens[cursor])) {
-			return new GetAttributeExpr(leftExpression,Token::cast<TValueString>(tokens[cursor])->getValue());
+			return new GetAttributeExpr(leftExpression,tokens[cursor].getString());
 		}/// "a.$b"
 		else if(Token::isA<TValueIdentifier>(tokens[cursor])){
-			return new GetAttributeExpr(leftExpression,Token::cast<TValueIdentifier>(tokens[cursor])->getValue());
+			return new GetAttributeExpr(leftExpression,tokens[cursor].getId());
 		}
 		log(ctxt,Logger::LOG_DEBUG, "Error .2 ",tokens[opPosition]);
 		throwError(ctxt,"Syntax error after '.'.",tokens[opPosition]);
@@ -1132,7 +1203,7 @@ EPtr<AST::ASTNode> Parser::readBinaryExpression(ParsingContext & ctxt,int & curs
 	*/
 EPtr<AST::ASTNode> Parser::readFunctionDeclaration(ParsingContext & ctxt,int & cursor)const{
 	const Tokenizer::tokenList_t & tokens = ctxt.tokens;
-	Token * t = tokens.at(cursor).get();
+	const Token * t = &tokens.at(cursor);
 
 	if(t->toString()!="fn"){
 		throwError(ctxt,"No function! ",tokens.at(cursor));
@@ -1146,7 +1217,7 @@ EPtr<AST::ASTNode> Parser::readFunctionDeclaration(ParsingContext & ctxt,int & c
 	++cursor;
 
 	UserFunctionExpr::parameterList_t params = readFunctionParameters(ctxt,cursor);
-	TOperator * superOp = Token::cast<TOperator>(tokens.at(cursor));
+	const Token * superOp = Token::cast<TOperator>(tokens.at(cursor));
 
 	/// fn(a).(a+1,2){} \deprecated
 	ASTNode::refArray_t superConCallExpressions;
@@ -1187,7 +1258,7 @@ EPtr<AST::ASTNode> Parser::readFunctionDeclaration(ParsingContext & ctxt,int & c
 	block->convertToStatement();
 	ctxt.blocks.pop_back(); // remove marking for local namespace
 
-	const size_t codeEndPos = tokens.at(cursor)->getStartingPos(); // position of '}'
+	const size_t codeEndPos = tokens.at(cursor).getStartingPos(); // position of '}'
 
 	/// step over ')' inserted at pass_2(...)
 	++cursor;
@@ -1215,7 +1286,7 @@ EPtr<AST::ASTNode> Parser::readFunctionDeclaration(ParsingContext & ctxt,int & c
  */
 EPtr<AST::ASTNode> Parser::readControl(ParsingContext & ctxt,int & cursor)const  {
 	const Tokenizer::tokenList_t & tokens = ctxt.tokens;
-	TControl * tc = Token::cast<TControl>(tokens.at(cursor));
+	const Token * tc = Token::cast<TControl>(tokens.at(cursor));
 	if(!tc)
 		throwError(ctxt,"No control found.",tokens.at(cursor));
 	++cursor;
@@ -1426,8 +1497,8 @@ EPtr<AST::ASTNode> Parser::readControl(ParsingContext & ctxt,int & cursor)const
 			throwError(ctxt,"[foreach] expects as",tokens.at(cursor));
 		++cursor;
 
-		TIdentifier * valueIdent = nullptr;
-		TIdentifier * keyIdent = nullptr;
+		const Token * valueIdent = nullptr;
+		const Token * keyIdent = nullptr;
 		if(!(valueIdent = Token::cast<TIdentifier>(tokens.at(cursor))))
 			throwError(ctxt,"[foreach] expects Identifier-1",tokens.at(cursor));
 		++cursor;
@@ -1458,7 +1529,7 @@ EPtr<AST::ASTNode> Parser::readControl(ParsingContext & ctxt,int & cursor)const
 		loopInitParams.push_back(arrayExpression);
 		EPtr<AST::ASTNode> loopInit =
 			SetAttributeExpr::createAssignment(nullptr,itId,
-				FunctionCallExpr::createSysCall(Consts::SYS_CALL_GET_ITERATOR,loopInitParams,tokens.at(cursor)->getLine()));
+				FunctionCallExpr::createSysCall(Consts::SYS_CALL_GET_ITERATOR,loopInitParams,tokens.at(cursor).getLine()));
 
 		// ! __it.end()
 		EPtr<AST::ASTNode> checkExpression = LogicOpExpr::createNot(
@@ -1478,7 +1549,7 @@ EPtr<AST::ASTNode> Parser::readControl(ParsingContext & ctxt,int & cursor)const
 				SetAttributeExpr::createAssignment(nullptr,keyIdent->getId(),
 					FunctionCallExpr::createFunctionCall(
 						new GetAttributeExpr(
-							new GetAttributeExpr(nullptr,itId), Consts::IDENTIFIER_fn_it_key),ASTNode::refArray_t() ),tokens.at(cursor)->getLine()));
+							new GetAttributeExpr(nullptr,itId), Consts::IDENTIFIER_fn_it_key),ASTNode::refArray_t() ),tokens.at(cursor).getLine()));
 		}
 
 		// value = __it.value();
@@ -1487,7 +1558,7 @@ EPtr<AST::ASTNode> Parser::readControl(ParsingContext & ctxt,int & cursor)const
 				SetAttributeExpr::createAssignment(nullptr,valueIdent->getId(),
 					FunctionCallExpr::createFunctionCall(
 						new GetAttributeExpr(
-							new GetAttributeExpr(nullptr,itId), Consts::IDENTIFIER_fn_it_value),ASTNode::refArray_t() ),tokens.at(cursor)->getLine()));
+							new GetAttributeExpr(nullptr,itId), Consts::IDENTIFIER_fn_it_value),ASTNode::refArray_t() ),tokens.at(cursor).getLine()));
 		}
 		actionWrapper->addStatement(action);
 
@@ -1517,13 +1588,13 @@ EPtr<AST::ASTNode> Parser::readControl(ParsingContext & ctxt,int & cursor)const
 		}
 		++cursor;
 
-		TStartBlock * tsb = Token::cast<TStartBlock>(tokens.at(cursor));
+		const Token * tsb = Token::cast<TStartBlock>(tokens.at(cursor));
 		Block * block = tsb?reinterpret_cast<Block *>(tsb->getBlock()):nullptr;
 		if(block==nullptr)
 			throwError(ctxt,"[switch] expects {...}",tokens.at(cursor));
 		++cursor;
 
-		warnOnShadowedLocalVars(ctxt,tsb);
+		warnOnShadowedLocalVars(ctxt,*tsb);
 		ctxt.blocks.push_back(block);
 
 		std::vector<std::pair<size_t,ERef<AST::ASTNode>>> caseDescriptions;
@@ -1534,7 +1605,7 @@ EPtr<AST::ASTNode> Parser::readControl(ParsingContext & ctxt,int & cursor)const
 			if(Token::isA<TEndScript>(tokens.at(cursor)))
 				throwError(ctxt,"Unclosed Block {...",tsb);
 
-			const int line = tokens.at(cursor)->getLine();
+			const int line = tokens.at(cursor).getLine();
 			if(Token::isA<TIdentifier>(tokens.at(cursor))){
 				/// case <expression> :
 				if(Token::cast<TIdentifier>(tokens.at(cursor))->getId() == Consts::IDENTIFIER_case){
@@ -1571,7 +1642,7 @@ EPtr<AST::ASTNode> Parser::readControl(ParsingContext & ctxt,int & cursor)const
 				block->addStatement(stmt);
 				stmt->setLine(line);
 			}
-			assertTokenIsStatemetEnding(ctxt,tokens.at(cursor).get());
+			assertTokenIsStatemetEnding(ctxt,tokens.at(cursor));
 			++cursor;
 		}
 		if(!defaultCaseRead){
@@ -1607,7 +1678,7 @@ EPtr<AST::ASTNode> Parser::readControl(ParsingContext & ctxt,int & cursor)const
 		if(!Token::isA<TStartBracket>(tokens.at(cursor)))
 			throwError(ctxt,"[try-catch] expects (",tokens.at(cursor));
 		++cursor;
-		TIdentifier * tIdent = nullptr;
+		const Token * tIdent = nullptr;
 
 		StringId varName;
 		if((tIdent = Token::cast<TIdentifier>(tokens.at(cursor)))) {
@@ -1683,8 +1754,8 @@ Parser::lValue_t Parser::getLValue(ParsingContext & ctxt,int from,int to,EPtr<AS
 	}
 	/// ".'a'"
 	/// "a.b.'c'"
-	else if(TValueString * s = Token::cast<TValueString>(tokens[to])) {
-		TOperator * top = Token::cast<TOperator>(tokens[to-1]);
+	else if(const Token * s = Token::cast<TValueString>(tokens[to])) {
+		const Token * top = Token::cast<TOperator>(tokens[to-1]);
 
 		if(top && top->getOperator()->getString()==".") {
 			obj = readExpression(ctxt,from,to-2);
@@ -1694,12 +1765,12 @@ Parser::lValue_t Parser::getLValue(ParsingContext & ctxt,int from,int to,EPtr<AS
 	}
 	/// ".$a"
 	/// "a.b.$c"
-	else if(TValueIdentifier * i = Token::cast<TValueIdentifier>(tokens[to])) {
-		TOperator * top = Token::cast<TOperator>(tokens[to-1]);
+	else if(const Token * i = Token::cast<TValueIdentifier>(tokens[to])) {
+		const Token * top = Token::cast<TOperator>(tokens[to-1]);
 
 		if(top && top->getOperator()->getString()==".") {
 			obj = readExpression(ctxt,from,to-2);
-			identifier = i->getValue();
+			identifier = i->getId();
 			return LVALUE_MEMBER;
 		}
 
@@ -1736,25 +1807,22 @@ int Parser::findExpression(ParsingContext & ctxt,int cursor)const {
 	int lastIdentifier=-10;
 	int cond = 0; // number of open conditionals '?'
 
-	Token * t = nullptr;
+	const Token * t = nullptr;
 	while(true) {
 		++to;
-		t = tokens.at(to).get();
+		t = &tokens.at(to);
 
 		switch(t->getType()){
-			case TStartBracket::TYPE_ID:{
-				TStartBracket * sb = Token::cast<TStartBracket>(t);
-				if(sb->endBracketIndex>1){
-					to = sb->endBracketIndex;
-				}else {
-					++level;
-				}
-				continue;
-			}
+			case TStartBracket::TYPE_ID:
 			case TStartBlock::TYPE_ID:
 			case TStartMap::TYPE_ID:
 			case TStartIndex::TYPE_ID:{
-				++level;
+				/// skip the enclosed tokens
+				if(t->getEndBracketIndex()>static_cast<size_t>(to)){
+					to = t->getEndBracketIndex();
+				}else {
+					++level;
+				}
 				continue;
 			}
 			case TEndBlock::TYPE_ID:
@@ -1844,8 +1912,8 @@ UserFunctionExpr::parameterList_t Parser::readFunctionParameters(ParsingContext
 		first = false;
 
 //		{ // ignore additional parameters: ...)
-//			Token * t = tokens.at(cursor).get();
-//			if(Token::isA<TOperator>(t) && (t->toString()=="...") && Token::isA<TEndBracket>(tokens.at(cursor+1).get()) ){
+//			const Token * t = &tokens.at(cursor);
+//			if(Token::isA<TOperator>(t) && (t->toString()=="...") && Token::isA<TEndBracket>(&tokens.at(cursor+1)) ){
 //				params.emplace_back(StringId()); // add empty parameter
 //				params.back().setMultiParam(true);
 //				if(multiParamState!=0)
@@ -1864,20 +1932,20 @@ UserFunctionExpr::parameterList_t Parser::readFunctionParameters(ParsingContext
 		EPtr<AST::ASTNode> defaultExpression = nullptr;
 
 		while(true){
-			Token * t = tokens.at(c).get();
+			const Token * t = &tokens.at(c);
 			if(Token::isA<TIdentifier>(t)) {
 				// this may not be the final identifier...
 				name = Token::cast<TIdentifier>(t)->getId();
 				idPos = c;
 
-				Token * tNext = tokens.at(c+1).get();
+				const Token * tNext = &tokens.at(c+1);
 				// '*'|'...' ?
 				if(  Token::isA<TOperator>(tNext) && (tNext->toString()=="..." || tNext->toString()=="*" )){
 					if(multiParamState!=0)
 						throwError(ctxt,"[fn] Only one multi parameter (...) allowed.",tokens.at(cursor));
 					multiParamState = 1;
 					++c;
-					tNext = tokens.at(c+1).get();
+					tNext = &tokens.at(c+1);
 				}
 				// ',' | ')'
 				if( Token::isA<TEndBracket>(tNext)){
@@ -1917,7 +1985,7 @@ UserFunctionExpr::parameterList_t Parser::readFunctionParameters(ParsingContext
 		ASTNode::refArray_t typeExpressions;
 		if(	idPos>cursor ){
 			int c2 = cursor;
-			Token * t = tokens.at(c2).get();
+			const Token * t = &tokens.at(c2);
 
 			// multiple possibilities: fn([Number,'yes'] a){...}
 			if(Token::isA<TStartIndex>(t)){
@@ -1974,7 +2042,7 @@ UserFunctionExpr::parameterList_t Parser::readFunctionParameters(ParsingContext
 ASTNode::refArray_t Parser::readExpressionsInBrackets(ParsingContext & ctxt,int & cursor)const{
 	ASTNode::refArray_t expressions;
 	const Tokenizer::tokenList_t & tokens = ctxt.tokens;
-	Token * t = tokens.at(cursor).get();
+	const Token * t = &tokens.at(cursor);
 	if(t->toString()!="(") {
 		throwError(ctxt,"Expression list error.",t);
 	}
@@ -2029,8 +2097,8 @@ Parser::annotations_t Parser::readAnnotation(ParsingContext & ctxt,int from,int
 	annotations_t annotations;
 	const Tokenizer::tokenList_t & tokens = ctxt.tokens;
 	for(int cursor = from;cursor<=to;++cursor){
-		Token * t = tokens.at(cursor).get();
-		const TIdentifier * tid = Token::cast<TIdentifier>(t);
+		const Token * t = &tokens.at(cursor);
+		const Token * tid = Token::cast<TIdentifier>(t);
 		if( tid==nullptr )
 			throwError(ctxt,"Identifier expected in annotation",t);
 
@@ -2052,9 +2120,13 @@ Parser::annotations_t Parser::readAnnotation(ParsingContext & ctxt,int from,int
 }
 
 
-void Parser::throwError(ParsingContext & ctxt,const std::string & msg,Token * token)const{
-	ParserException * e = new ParserException(msg,token);
-	e->setFilename(ctxt.code.getFilename());
+void Parser::throwError(ParsingContext & ctxt,const std::string & msg,const Token * token)const{
+	ParserException * e;
+	{
+		std::lock_guard<std::mutex> lock(Tokenizer::getErrorMutex());
+		e = new ParserException(msg,token);
+		e->setFilename(ctxt.code.getFilename());
+	}
 	throw e;
 }
 
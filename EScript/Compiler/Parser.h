@@ -12,6 +12,7 @@
 #include "AST/UserFunctionExpr.h"
 #include "../Utils/Logger.h"
 
+#include <unordered_map>
 #include <vector>
 
 #if defined(_MSC_VER)
@@ -31,11 +32,11 @@ class Parser {
 			ES_PROVIDES_TYPE_NAME(ParserException)
 
 			public:
-				explicit ParserException(const std::string  & _msg,Token * token = nullptr):
+				explicit ParserException(const std::string  & _msg,const Token * token = nullptr):
 					Exception(_msg,  (token==nullptr? -1 : token->getLine())) {
 				}
-				explicit ParserException(const std::string  & _msg,const _CountedRef<Token> & token):
-					Exception(_msg,  (token.isNull() ? -1 : token->getLine())) {
+				explicit ParserException(const std::string  & _msg,const Token & token):
+					Exception(_msg,  token.getLine()) {
 				}
 		};
 		//-----------
@@ -49,6 +50,10 @@ class Parser {
 			Tokenizer::tokenList_t & tokens;
 			AST::Block * rootBlock;
 			std::deque<AST::Block*> blocks; // used as a stack
+			std::vector<ERef<AST::Block>> tokenBlocks; //!< keeps the Blocks referenced by TStartBlock-tokens alive
+			//! (from,to) -> position of the operator splitting the binary expression in that range (see readBinaryExpression)
+			std::unordered_map<uint64_t,int> splittingOperators;
+			std::vector<int> operatorPositions; //!< buffer used by findSplittingOperator
 			CodeFragment code;
 			ParsingContext(Tokenizer::tokenList_t & _tokens,const CodeFragment & _code ) : tokens(_tokens),rootBlock(nullptr),code(_code){}
 		};
@@ -56,16 +61,19 @@ class Parser {
 	private:
 
 		_CountedRef<Logger> logger;
-		void log(ParsingContext & ctxt,Logger::level_t messageLevel, const std::string & msg,const _CountedRef<Token> & token = nullptr)const;
+		void log(ParsingContext & ctxt,Logger::level_t messageLevel, const std::string & msg,const Token * token = nullptr)const;
+		void log(ParsingContext & ctxt,Logger::level_t messageLevel, const std::string & msg,const Token & token)const	{	log(ctxt,messageLevel,msg,&token);	}
 
 		Tokenizer tokenizer;
 		void pass_1(ParsingContext & ctxt);
-		void pass_2(ParsingContext & ctxt, Tokenizer::tokenList_t  & enrichedTokens)const;
+		void pass_2(ParsingContext & ctxt, Tokenizer::tokenList_t  & enrichedTokens);
+		void linkBrackets(ParsingContext & ctxt)const;
 		EPtr<AST::ASTNode> readAnnotatedStatement(ParsingContext & ctxt,int & cursor)const;
 		EPtr<AST::ASTNode> readControl(ParsingContext & ctxt,int & cursor)const;
 		EPtr<AST::ASTNode> readStatement(ParsingContext & ctxt,int & cursor)const;
 		EPtr<AST::ASTNode> readExpression(ParsingContext & ctxt,int & cursor,int to=-1)const;
 		EPtr<AST::ASTNode> readBinaryExpression(ParsingContext & ctxt,int & cursor,int to)const;
+		int findSplittingOperator(ParsingContext & ctxt,int from,int to)const;
 		AST::Block * readBlockExpression(ParsingContext & ctxt,int & cursor)const ;
 		EPtr<AST::ASTNode> readMap(ParsingContext & ctxt,int & cursor)const;
 		EPtr<AST::ASTNode> readFunctionDeclaration(ParsingContext & ctxt,int & cursor)const;
@@ -80,12 +88,12 @@ class Parser {
 		lValue_t getLValue(ParsingContext & ctxt,int from,int to,EPtr<AST::ASTNode> & obj,StringId & identifier,EPtr<AST::ASTNode> &indexExpression)const;
 		int findExpression(ParsingContext & ctxt,int cursor)const;
 
-		void throwError(ParsingContext & ctxt,const std::string & msg,Token * token = nullptr)const;
-		void throwError(ParsingContext & ctxt,const std::string & msg,const _CountedRef<Token> & token)const	{	throwError(ctxt,msg,token.get());	}
+		void throwError(ParsingContext & ctxt,const std::string & msg,const Token * token = nullptr)const;
+		void throwError(ParsingContext & ctxt,const std::string & msg,const Token & token)const	{	throwError(ctxt,msg,&token);	}
 
-		void assertTokenIsStatemetEnding(ParsingContext &,Token*)const;
+		void assertTokenIsStatemetEnding(ParsingContext &,const Token &)const;
 
-		void warnOnShadowedLocalVars(ParsingContext & ctxt,TStartBlock * tBlock)const;
+		void warnOnShadowedLocalVars(ParsingContext & ctxt,const Token & tBlock)const;
 
 };
 }
@@ -5,5 +5,63 @@
 #include "Token.h"
 
 namespace EScript {
-	int Token::tokenCount = 0;
+
+std::string Token::toString()const{
+	switch(typeId){
+		case TIdentifier::TYPE_ID:
+		case TControl::TYPE_ID:
+		case TValueIdentifier::TYPE_ID:
+			return getId().toString();
+		case TEndCommand::TYPE_ID:
+			return ";";
+		case TEndScript::TYPE_ID:
+			return "EndScript";
+		case TStartBlock::TYPE_ID:
+			return "{";
+		case TEndBlock::TYPE_ID:
+			return "}";
+		case TStartMap::TYPE_ID:
+			return "_{";
+		case TEndMap::TYPE_ID:
+			return "}_";
+		case TMapDelimiter::TYPE_ID:
+			return "_:_";
+		case TColon::TYPE_ID:
+			return ":";
+		case TValueBool::TYPE_ID:
+			return getBool() ? "true" : "false";
+		case TValueNumber::TYPE_ID:
+			return "Number";
+		case TValueString::TYPE_ID:
+			return getString();
+		case TValueVoid::TYPE_ID:
+			return "void";
+		default:
+			if(isA<TOperator>(*this) && op!=nullptr)
+				return op->getString();
+			return "Token";
+	}
+}
+
+Token TStartBracket::create(){
+	static const Operator * op = Operator::getOperator("(");
+	return TOperator::create(op,TYPE_ID);
+}
+Token TEndBracket::create(){
+	static const Operator * op = Operator::getOperator(")");
+	return TOperator::create(op,TYPE_ID);
+}
+Token TDelimiter::create(){
+	static const Operator * op = Operator::getOperator(",");
+	return TOperator::create(op,TYPE_ID);
+}
+Token TStartIndex::create(){
+	static const Operator * op = Operator::getOperator("[");
+	return TOperator::create(op,TYPE_ID);
+}
+Token TEndIndex::create(){
+	static const Operator * op = Operator::getOperator("]");
+	return TOperator::create(op,TYPE_ID);
+}
+
 }
@@ -6,280 +6,255 @@
 #define TOKENS_H
 
 #include "AST/Block.h"
-#include "../Utils/EReferenceCounter.h"
-#include "../Utils/Hashing.h"
-#include "../Utils/ObjRef.h"
+#include "../Utils/StringId.h"
 #include "Operators.h"
 
 #include <cstddef>
-#include <cstdlib>
 #include <cstdint>
 #include <string>
 
 namespace EScript {
 
-//! [Token]
-class Token:public EReferenceCounter<Token> {
+/*! [Token]
+	Plain token record. The tokens of a script are stored by value in a flat array (Tokenizer::tokenList_t).
+	The kind of a token is given by its type id; the payload depends on the kind:
+	- TIdentifier, TControl, TValueIdentifier: getId()
+	- TOperator (and the brackets, TDelimiter and the index brackets): getOperator()
+	- TStartBracket, TStartIndex, TStartBlock, TStartMap: getEndBracketIndex(); the index of the corresponding
+		closing token (set by the Parser)
+	- TStartBlock: additionally getBlock() (set by the Parser)
+	- TValueBool: getBool(); TValueNumber: getNumber()
+	- TValueString: getString(); the characters are not owned by the token but lie in the code or
+		in the string table of the Tokenizer.
+	The token kinds are declared as tag types providing the type id and a factory ( e.g. TIdentifier::create(id) ).	*/
+class Token {
 	public:
 		static const uint32_t TYPE_ID = 0x00;
 		static uint32_t getTypeId()			{	return 0x00;	}
 
 		template<class TokenType_t>
-		static bool isA(Token * t){
-			return t==nullptr ? false : ( (TokenType_t::getTypeId() & t->typeId) == TokenType_t::getTypeId());
+		static bool isA(const Token * t){
+			return t==nullptr ? false : isA<TokenType_t>(*t);
 		}
 		template<class TokenType_t>
-		static bool isA(const _CountedRef<Token> & t){
-			return t.isNull() ? false : ( (TokenType_t::getTypeId() & t->typeId) == TokenType_t::getTypeId());
+		static bool isA(const Token & t){
+			return (TokenType_t::getTypeId() & t.typeId) == TokenType_t::getTypeId();
 		}
 		template<class TokenType_t>
-		static TokenType_t * cast(const _CountedRef<Token>  & t){
-			return isA<TokenType_t>(t) ? static_cast<TokenType_t*>(t.get()) :  nullptr;
+		static Token * cast(Token * t){
+			return isA<TokenType_t>(t) ? t : nullptr;
 		}
 		template<class TokenType_t>
-		static TokenType_t * cast(Token * t){
-			return isA<TokenType_t>(t) ? static_cast<TokenType_t*>(t) : nullptr ;
+		static const Token * cast(const Token * t){
+			return isA<TokenType_t>(t) ? t : nullptr;
+		}
+		template<class TokenType_t>
+		static Token * cast(Token & t){
+			return isA<TokenType_t>(t) ? &t : nullptr;
+		}
+		template<class TokenType_t>
+		static const Token * cast(const Token & t){
+			return isA<TokenType_t>(t) ? &t : nullptr;
 		}
 // --------------
 
-		static int tokenCount;
+		explicit Token(const uint32_t _type = getTypeId()) :
+				typeId(_type),line(0),startingPos(std::string::npos),endBracketIndex(0),op(nullptr)	{	}
+		std::string toString()const;
 
-		Token(const uint32_t _type = getTypeId()) :
-				typeId(_type),line(0),startingPos(std::string::npos)		{	++tokenCount;	}
-		virtual ~Token()					{	tokenCount--;	}
-		virtual std::string toString()const		{	return std::string("Token");	}
-
-		void setLine(int _line)			{	line = _line;	}
+		void setLine(int _line)				{	line = _line;	}
 		int getLine()const					{	return line;	}
 
-		// ---o
-		virtual Token * clone()const	 	{	return new Token;	}
-
 		uint32_t getType()const				{	return typeId;	}
-		const uint32_t typeId;
 
 		void setStaringPos(size_t p)		{	startingPos = p;	}
 		size_t getStartingPos()const		{	return startingPos; }
 
+		//! @name Payload
+		//	@{
+		StringId getId()const						{	return StringId(idValue);	}
+		void setId(StringId id)						{	idValue = id.getValue();	}
+
+		const Operator * getOperator()const			{	return op;	}
+		void setOperator(const Operator * _op)		{	op = _op;	}
+		int getPrecedence()const					{	return op->getPrecedence();	}
+		int getAssociativity()const					{	return op->getAssociativity();	}
+
+		size_t getEndBracketIndex()const			{	return endBracketIndex;	}
+		void setEndBracketIndex(size_t i)			{	endBracketIndex = i;	}
+
+		AST::Block * getBlock()const				{	return block;	}
+		void setBlock(AST::Block * _block)			{	block = _block;	}
+
+		bool getBool()const							{	return boolValue;	}
+		void setBool(bool b)						{	boolValue = b;	}
+
+		double getNumber()const						{	return number;	}
+		void setNumber(double n)					{	number = n;	}
+
+		std::string getString()const				{	return std::string(stringBegin,stringLength);	}
+		const char * getStringBegin()const			{	return stringBegin;	}
+		size_t getStringLength()const				{	return stringLength;	}
+		//! The characters are not copied and have to outlive the token.
+		void setString(const char * begin,size_t length)	{	stringBegin = begin;	stringLength = length;	}
+		//	@}
+
 	private:
+		uint32_t typeId;
 		int line;
 		size_t startingPos;
+		union{
+			size_t endBracketIndex;
+			bool boolValue;
+			double number;
+			uint32_t idValue;
+			const char * stringBegin;
+		};
+		union{
+			const Operator * op;
+			AST::Block * block;
+			size_t stringLength;
+		};
 };
 // -----
-class TIdentifier :  public Token {
-	private:
-		StringId id;
-	public:
-		static const uint32_t TYPE_ID = 0x01 << 0;
-		static uint32_t getTypeId()			{	return TYPE_ID;	}
-
-		TIdentifier(StringId _id) : Token(getTypeId()),id(_id)	{	 }
-		virtual std::string toString()const	{	return id.toString();	}
-
-		StringId getId()const				{	return id;	 }
-		virtual Token * clone()const		{	return new TIdentifier(id);	}
-
+struct TIdentifier {
+	static const uint32_t TYPE_ID = 0x01 << 0;
+	static uint32_t getTypeId()				{	return TYPE_ID;	}
+	static Token create(StringId id)		{	Token t(TYPE_ID);	t.setId(id);	return t;	}
 };
 
 // -----
-class TControl :  public Token {
-	public:
-		static const uint32_t TYPE_ID = 0x01 << 1;
-		static uint32_t getTypeId()				{	return TYPE_ID;	}
-		TControl(const char * _name) : id(_name) {	}
-		TControl(StringId _id) : Token(getTypeId()),id(_id) {	}
-		virtual std::string toString()const	{	return id.toString();	}
-		StringId getId()const		 		{	return id;	}
-		virtual Token * clone()const			{	return new TControl(id);	}
-	private:
-		StringId id;
+struct TControl {
+	static const uint32_t TYPE_ID = 0x01 << 1;
+	static uint32_t getTypeId()				{	return TYPE_ID;	}
+	static Token create(StringId id)		{	Token t(TYPE_ID);	t.setId(id);	return t;	}
 };
 // -----
-struct TEndCommand :  public Token {
+struct TEndCommand {
 	static const uint32_t TYPE_ID = 0x01 << 2;
-	TEndCommand() : Token(getTypeId())		{	}
-	virtual std::string toString()const		{	return ";";	}
-	virtual Token * clone()const			{	return new TEndCommand;	}
-
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
+	static Token create()					{	return Token(TYPE_ID);	}
 };
 
 // -----
-struct TEndScript :  public Token	{
+struct TEndScript {
 	static const uint32_t TYPE_ID = 0x01 << 3;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TEndScript() : Token(getTypeId())		{	}
-	virtual std::string toString()const		{	return "EndScript";	}
-	virtual Token * clone()const			{	return new TEndScript;	}
+	static Token create()					{	return Token(TYPE_ID);	}
 };
 
 // -----
-struct TStartBlock :  public Token {
+struct TStartBlock {
 	static const uint32_t TYPE_ID = 0x01 << 4;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TStartBlock(AST::Block * _block = nullptr) : Token(getTypeId()),block(_block) {}
-	void setBlock(AST::Block * _block)		{	block = _block;	}
-	AST::Block * getBlock()const			{	return block.get();	}
-	virtual std::string toString()const		{	return "{"; }
-	virtual Token * clone()const 			{	return new TStartBlock(block.get());	}
-
-	private:
-		ERef<AST::Block> block;
+	static Token create(AST::Block * block = nullptr)	{	Token t(TYPE_ID);	t.setBlock(block);	return t;	}
 };
 
 // -----
-struct TEndBlock :  public Token {
+struct TEndBlock {
 	static const uint32_t TYPE_ID = 0x01 << 5;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TEndBlock() : Token(getTypeId())		{	}
-	virtual std::string toString()const		{	return "}";	}
-	virtual Token * clone()const			{	return new TEndBlock;	}
+	static Token create()					{	return Token(TYPE_ID);	}
 };
 // -----
 
-struct TStartMap :  public Token {
+struct TStartMap {
 	static const uint32_t TYPE_ID = 0x01 << 6;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TStartMap()  : Token(getTypeId())		{	}
-	virtual std::string toString()const		{	return "_{";	}
-	virtual Token * clone()const			{	return new TStartMap;	}
+	static Token create()					{	return Token(TYPE_ID);	}
 };
 
 // -----
-struct TEndMap :  public Token {
+struct TEndMap {
 	static const uint32_t TYPE_ID = 0x01 << 7;
-	static uint32_t getTypeId()					{	return TYPE_ID;	}
-	TEndMap()  : Token(getTypeId())			{	}
-	virtual std::string toString()const		{	return "}_";	}
-	virtual Token * clone()const			{	return new TEndMap;	}
+	static uint32_t getTypeId()				{	return TYPE_ID;	}
+	static Token create()					{	return Token(TYPE_ID);	}
 };
 // -----
-struct TMapDelimiter :  public Token {
+struct TMapDelimiter {
 	static const uint32_t TYPE_ID = 0x01 << 8;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TMapDelimiter()  : Token(getTypeId())	{	}
-	virtual std::string toString()const		{	return "_:_";	}
-	virtual Token * clone()const			{	return new TMapDelimiter;	}
+	static Token create()					{	return Token(TYPE_ID);	}
 };
 
 
 // -----
-struct TColon :  public Token {
+struct TColon {
 	static const uint32_t TYPE_ID = 0x01 << 9;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TColon()  : Token(getTypeId())			{	}
-	virtual std::string toString()const		{	return ":";	}
-	virtual Token * clone()const			{	return new TColon;	}
+	static Token create()					{	return Token(TYPE_ID);	}
 };
 
 // -----
-struct TOperator :  public Token {
+struct TOperator {
 	static const uint32_t TYPE_ID = 0x01 << 11;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TOperator(const std::string & s,const uint32_t _type = getTypeId())  : Token(_type)	{	op = Operator::getOperator(s);	}
-	TOperator(StringId id)  : Token(getTypeId())					{	op = Operator::getOperator(id);	}
-	TOperator(const Operator * _op) : Token(getTypeId()),op(_op) {}
-
-	int getPrecedence()						{	return op->getPrecedence();	}
-	int getAssociativity()					{	return op->getAssociativity();	}
-	const Operator * getOperator()const		{	return op;	}
-
-	virtual std::string toString()const		{	return op->getString();	}
-	virtual Token * clone()const			{	return new TOperator(op);	}
-
-	private:
-		const Operator * op;
+	static Token create(const Operator * op,const uint32_t type = TYPE_ID){
+		Token t(type);
+		t.setOperator(op);
+		return t;
+	}
 };
 
 
 // -----
-struct TStartBracket :  public TOperator {
+struct TStartBracket {
 	static const uint32_t TYPE_ID = 0x01 << 12 | TOperator::TYPE_ID;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-
-	size_t endBracketIndex;
-	TStartBracket() : TOperator("(",getTypeId()),endBracketIndex(0)	{}
-	virtual Token * clone()const			{	return new TStartBracket;	}
+	static Token create();
 };
 
 // -----
-struct TEndBracket :  public TOperator { // Token: there may be a reason why TEndBrakcet should directly inherit from Token!?!
+struct TEndBracket {
 	static const uint32_t TYPE_ID = 0x01 << 13 | TOperator::TYPE_ID;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TEndBracket() : TOperator(")",getTypeId())	{}
-//	virtual std::string toString()const		{	return ")";	}
-	virtual Token * clone()const			{	return new TEndBracket;	}
+	static Token create();
 };
 // -----
-struct TDelimiter :  public TOperator {
+struct TDelimiter {
 	static const uint32_t TYPE_ID = 0x01 << 14 | TOperator::TYPE_ID;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TDelimiter() : TOperator(",",getTypeId())	{}
-	virtual Token * clone()const			{	return new TDelimiter;	}
+	static Token create();
 };
 
 // -----
-struct TStartIndex :public TOperator {
+struct TStartIndex {
 	static const uint32_t TYPE_ID = 0x01 << 15 | TOperator::TYPE_ID;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TStartIndex() : TOperator("[",getTypeId())	{}
-	virtual Token * clone()const			{	return new TStartIndex;	}
+	static Token create();
 };
 // -----
-struct TEndIndex :public TOperator {
+struct TEndIndex {
 	static const uint32_t TYPE_ID = 0x01 << 16 | TOperator::TYPE_ID;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TEndIndex() : TOperator("]",getTypeId())	{}
-	virtual Token * clone()const			{	return new TEndIndex;	}
+	static Token create();
 };
 // -----
-struct TValueBool :  public Token {
+struct TValueBool {
 	static const uint32_t TYPE_ID = 0x01 << 17;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TValueBool(bool v)  : Token(getTypeId()), value(v){	}
-	virtual std::string toString()const		{	return value ? "true" : "false";	}
-	virtual Token * clone()const			{	return new TValueBool(value);	}
-	bool getValue()const					{	return value;	}
-	
-	bool value;
+	static Token create(bool v)				{	Token t(TYPE_ID);	t.setBool(v);	return t;	}
 };
-struct TValueIdentifier :  public Token {
+struct TValueIdentifier {
 	static const uint32_t TYPE_ID = 0x01 << 18;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TValueIdentifier(const StringId & v) : Token(getTypeId()), value(v){	}
-	virtual std::string toString()const		{	return value.toString();	}
-	virtual Token * clone()const			{	return new TValueIdentifier(value);	}
-	const StringId & getValue()const		{	return value;	}
-	
-	StringId value;
+	static Token create(StringId id)		{	Token t(TYPE_ID);	t.setId(id);	return t;	}
 };
-struct TValueNumber :  public Token {
+struct TValueNumber {
 	static const uint32_t TYPE_ID = 0x01 << 19;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TValueNumber(double v)  : Token(getTypeId()), value(v){	}
-	virtual std::string toString()const		{	return "Number";	}
-	virtual Token * clone()const			{	return new TValueNumber(value);	}
-	double getValue()const					{	return value;	}
-	
-	double value;
+	static Token create(double v)			{	Token t(TYPE_ID);	t.setNumber(v);	return t;	}
 };
-struct TValueString :  public Token {
+struct TValueString {
 	static const uint32_t TYPE_ID = 0x01 << 20;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TValueString(const std::string &v) : Token(getTypeId()), value(v){	}
-	virtual std::string toString()const		{	return value;	}
-	virtual Token * clone()const			{	return new TValueString(value);	}
-	const std::string & getValue()const		{	return value;	}
-	void setString(const std::string & s)	{	value = s;	}
-	
-	std::string value;
+	//! The characters are not copied and have to outlive the token.
+	static Token create(const char * begin,size_t length)	{	Token t(TYPE_ID);	t.setString(begin,length);	return t;	}
 };
-struct TValueVoid :  public Token {
+struct TValueVoid {
 	static const uint32_t TYPE_ID = 0x01 << 21;
 	static uint32_t getTypeId()				{	return TYPE_ID;	}
-	TValueVoid()  : Token(getTypeId())		{	}
-	virtual std::string toString()const		{	return "void";	}
-	virtual Token * clone()const			{	return new TValueVoid;	}
+	static Token create()					{	return Token(TYPE_ID);	}
 };
 
 }
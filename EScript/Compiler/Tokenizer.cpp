@@ -9,71 +9,93 @@
 #include "Operators.h"
 
 #include <iostream>
-#include <sstream>
 #include <utility>
 
 namespace EScript {
 
-//! (static)
-Token * Tokenizer::identifyStaticToken(StringId id){
-	static tokenMap_t constants;
-	// init
-	if(constants.empty()){
-		constants[Consts::IDENTIFIER_if] = new TControl(Consts::IDENTIFIER_if);
-		constants[Consts::IDENTIFIER_else] = new TControl(Consts::IDENTIFIER_else);
-		constants[Consts::IDENTIFIER_do] = new TControl(Consts::IDENTIFIER_do);
+//! (static,internal)
+static Tokenizer::tokenMap_t createStaticTokens(){
+	Tokenizer::tokenMap_t constants;
+	constants[Consts::IDENTIFIER_if] = TControl::create(Consts::IDENTIFIER_if);
+	constants[Consts::IDENTIFIER_else] = TControl::create(Consts::IDENTIFIER_else);
+	constants[Consts::IDENTIFIER_do] = TControl::create(Consts::IDENTIFIER_do);
 
-		constants[Consts::IDENTIFIER_while] = new TControl(Consts::IDENTIFIER_while);
-		constants[Consts::IDENTIFIER_break] = new TControl(Consts::IDENTIFIER_break);
-		constants[Consts::IDENTIFIER_static] = new TControl(Consts::IDENTIFIER_static);
-		constants[Consts::IDENTIFIER_var] = new TControl(Consts::IDENTIFIER_var);
+	constants[Consts::IDENTIFIER_while] = TControl::create(Consts::IDENTIFIER_while);
+	constants[Consts::IDENTIFIER_break] = TControl::create(Consts::IDENTIFIER_break);
+	constants[Consts::IDENTIFIER_static] = TControl::create(Consts::IDENTIFIER_static);
+	constants[Consts::IDENTIFIER_var] = TControl::create(Consts::IDENTIFIER_var);
 
-		constants[Consts::IDENTIFIER_continue] = new TControl(Consts::IDENTIFIER_continue);
-		constants[Consts::IDENTIFIER_return] = new TControl(Consts::IDENTIFIER_return);
-		constants[Consts::IDENTIFIER_exit] = new TControl(Consts::IDENTIFIER_exit);
-		constants[Consts::IDENTIFIER_foreach] = new TControl(Consts::IDENTIFIER_foreach);
-		constants[Consts::IDENTIFIER_as] = new TControl(Consts::IDENTIFIER_as);
-		constants[Consts::IDENTIFIER_for] = new TControl(Consts::IDENTIFIER_for);
-		constants[Consts::IDENTIFIER_switch] = new TControl(Consts::IDENTIFIER_switch);
+	constants[Consts::IDENTIFIER_continue] = TControl::create(Consts::IDENTIFIER_continue);
+	constants[Consts::IDENTIFIER_return] = TControl::create(Consts::IDENTIFIER_return);
+	constants[Consts::IDENTIFIER_exit] = TControl::create(Consts::IDENTIFIER_exit);
+	constants[Consts::IDENTIFIER_foreach] = TControl::create(Consts::IDENTIFIER_foreach);
+	constants[Consts::IDENTIFIER_as] = TControl::create(Consts::IDENTIFIER_as);
+	constants[Consts::IDENTIFIER_for] = TControl::create(Consts::IDENTIFIER_for);
+	constants[Consts::IDENTIFIER_switch] = TControl::create(Consts::IDENTIFIER_switch);
 
-		constants[Consts::IDENTIFIER_try] = new TControl(Consts::IDENTIFIER_try);
-		constants[Consts::IDENTIFIER_catch] = new TControl(Consts::IDENTIFIER_catch);
-		constants[Consts::IDENTIFIER_throw] = new TControl(Consts::IDENTIFIER_throw);
-		constants[Consts::IDENTIFIER_yield] = new TControl(Consts::IDENTIFIER_yield);
-		constants[Consts::IDENTIFIER_namespace] = new TControl(Consts::IDENTIFIER_namespace);
+	constants[Consts::IDENTIFIER_try] = TControl::create(Consts::IDENTIFIER_try);
+	constants[Consts::IDENTIFIER_catch] = TControl::create(Consts::IDENTIFIER_catch);
+	constants[Consts::IDENTIFIER_throw] = TControl::create(Consts::IDENTIFIER_throw);
+	constants[Consts::IDENTIFIER_yield] = TControl::create(Consts::IDENTIFIER_yield);
+	constants[Consts::IDENTIFIER_namespace] = TControl::create(Consts::IDENTIFIER_namespace);
 
-		constants[Consts::IDENTIFIER_true] = new TValueBool(true);
-		constants[Consts::IDENTIFIER_false] = new TValueBool(false);
-		constants[Consts::IDENTIFIER_void] = new TValueVoid;
-		constants[Consts::IDENTIFIER_null] = new TValueVoid;
+	constants[Consts::IDENTIFIER_true] = TValueBool::create(true);
+	constants[Consts::IDENTIFIER_false] = TValueBool::create(false);
+	constants[Consts::IDENTIFIER_void] = TValueVoid::create();
+	constants[Consts::IDENTIFIER_null] = TValueVoid::create();
+	return constants;
+}
 
-	}
+//! (static)
+const Token * Tokenizer::identifyStaticToken(StringId id){
+	static const tokenMap_t constants = createStaticTokens(); // thread safe initialization
 	const tokenMap_t::const_iterator it = constants.find(id);
-	return it==constants.end() ? nullptr : it->second.get();
+	return it==constants.end() ? nullptr : &it->second;
+}
+
+//! (static)
+std::mutex & Tokenizer::getErrorMutex(){
+	static std::mutex mutex;
+	return mutex;
+}
+
+//! (static,internal)
+Tokenizer::Error * Tokenizer::createError(const std::string & msg,int line){
+	std::lock_guard<std::mutex> lock(getErrorMutex());
+	return new Error(msg,line);
 }
 
 //! (internal)
-Token * Tokenizer::identifyToken(StringId id)const{
-	const tokenMap_t::const_iterator it = customTokens.find(id);
-	return it==customTokens.end() ? identifyStaticToken(id) : it->second.get();
+const Token * Tokenizer::identifyToken(StringId id)const{
+	if(!customTokens.empty()){
+		const tokenMap_t::const_iterator it = customTokens.find(id);
+		if(it!=customTokens.end())
+			return &it->second;
+	}
+	return identifyStaticToken(id);
 }
 
 //! (internal)
-void Tokenizer::defineToken(const std::string & name,Token * value){
+void Tokenizer::defineToken(const std::string & name,const Token & value){
 	customTokens[StringId(name)] = value;
 }
 
+const std::string & Tokenizer::storeString(std::string && s){
+	stringTable.emplace_back(std::move(s));
+	return stringTable.back();
+}
+
 void Tokenizer::getTokens( const std::string & codeU8,tokenList_t & tokens){
 	std::size_t cursor = 0;
 	int line = 1;
 	size_t startPos = std::string::npos;
 
-	Token * token;
+	tokens.reserve(tokens.size() + codeU8.length()/2 + 1); // dense code has about one token per three characters; untouched capacity costs only address space
+	Token token;
 	do {
-		token = readNextToken(codeU8,cursor,line,startPos,tokens);
-		if(token!=nullptr) {
-			token->setLine(line);
-			token->setStaringPos(startPos);
+		if(readNextToken(codeU8,cursor,line,startPos,tokens,token)) {
+			token.setLine(line);
+			token.setStaringPos(startPos);
 			tokens.push_back(token);
 		}
 	} while(! Token::isA<TEndScript>(token) );
@@ -87,10 +109,13 @@ static bool strBeginsWith(const char * subject,const char * find) {
 	}
 	return true;
 }
-//!	Reads the next Token from prog beginning with position cursor and moves cursor to the next Token.
-Token * Tokenizer::readNextToken(const std::string & codeU8, std::size_t & cursor,int &line,size_t & startPos,tokenList_t & tokens) {
-	if(cursor>=codeU8.length())
-		return new TEndScript;
+/*!	Reads the next Token from prog beginning with position cursor and moves cursor to the next Token.
+	Returns false if no token has been read (e.g. for a comment).	*/
+bool Tokenizer::readNextToken(const std::string & codeU8, std::size_t & cursor,int &line,size_t & startPos,const tokenList_t & tokens,Token & token) {
+	if(cursor>=codeU8.length()){
+		token = TEndScript::create();
+		return true;
+	}
 
 	const char * prog = codeU8.c_str();
 	char c = prog[cursor];
@@ -99,9 +124,10 @@ Token * Tokenizer::readNextToken(const std::string & codeU8, std::size_t & curso
 	while( isWhitechar(c) ) {
 		if(c=='\n') ++line;
 		++cursor;
-		if(cursor>=codeU8.length())
-			return new TEndScript;
-
+		if(cursor>=codeU8.length()){
+			token = TEndScript::create();
+			return true;
+		}
 		c = codeU8[cursor];
 	}
 	startPos = static_cast<size_t>(cursor);
@@ -109,37 +135,33 @@ Token * Tokenizer::readNextToken(const std::string & codeU8, std::size_t & curso
 	// Raw strings:   R"Delimiter(my string dum di du)Delimiter"
 	if(c=='R' && codeU8[cursor+1]=='"' ) {
 		cursor+=2;
-		std::ostringstream delimiter;
-		delimiter << ')';
+		std::string d(1,')');
 		for(c = codeU8[cursor]; c!='('; ++cursor,c = codeU8[cursor]){
 			if(cursor>=codeU8.length())
-				throw new Error(std::string("Unclosed Raw String; missing '('."),line);
+				throw createError(std::string("Unclosed Raw String; missing '('."),line);
 			else if(isWhitechar(c))
-				throw new Error(std::string("No whitespace allowed in raw string delimiter."),line);
-			delimiter << c;
+				throw createError(std::string("No whitespace allowed in raw string delimiter."),line);
+			d += c;
 		}
-		delimiter<<'"';
+		d += '"';
 		++cursor; // step over '('
 
-		const std::string d(delimiter.str());
-
 		const auto first = cursor;
-		size_t length = 0;
 		while(cursor<codeU8.length()){
 			c = codeU8[cursor];
 			if(c==')'&& strBeginsWith(prog+cursor,d.c_str())){
+				token = TValueString::create(prog+first,cursor-first);
 				cursor+=d.length();
-				return new TValueString((std::string(prog+first,length)));
+				return true;
 			}else if(c=='\n'){
 				++line;
 			}
 			++cursor;
-			++length;
 		}
-		throw new Error(std::string("Unclosed Raw String; missing '"+d+"'"),line);
+		throw createError(std::string("Unclosed Raw String; missing '"+d+"'"),line);
 	}
 
-	// Multi line comment (returns nullptr)
+	// Multi line comment
 	if(c=='/' && codeU8[cursor+1]=='*') {
 		cursor+=2;
 		while(cursor<codeU8.length()) {
@@ -147,18 +169,17 @@ Token * Tokenizer::readNextToken(const std::string & codeU8, std::size_t & curso
 				++line;
 			}else if( codeU8[cursor] =='*' && codeU8[cursor+1] =='/') {
 				cursor+=2;
-				return nullptr;
+				return false;
 			}
 			++cursor;
 		}
-		throw new Error("Unclosed Comment",line);
+		throw createError("Unclosed Comment",line);
 	}
-	// Single line comment (returns nullptr)
+	// Single line comment
 	else if(c=='/' && codeU8[cursor+1]=='/') {
-		++cursor;
-		while(cursor<codeU8.length() && codeU8[cursor]!='\n')
-			++cursor;
-		return nullptr;
+		const char * lineEnd = static_cast<const char*>(std::memchr(prog+cursor,'\n',codeU8.length()-cursor));
+		cursor = lineEnd==nullptr ? codeU8.length() : static_cast<size_t>(lineEnd-prog);
+		return false;
 
 	}
 	// Numbers
@@ -167,94 +188,106 @@ Token * Tokenizer::readNextToken(const std::string & codeU8, std::size_t & curso
 		const double number = StringUtils::readNumber(prog,to);
 		if(to>cursor && !isChar(codeU8[to])) {
 			cursor = to;
-			return new TValueNumber(number);
+			token = TValueNumber::create(number);
+			return true;
 		} else {
 			std::cout << number ;
-			throw new Error(  std::string("Syntax Error in Number."),line);
+			throw createError(  std::string("Syntax Error in Number."),line);
 		}
 
 		// Identifiers, Control commands, true/false
 	} else if(isChar(c)) {
-		std::string accum;
-		while( isNumber(c) || isChar(c)) {
-			accum+=c;
+		const auto first = cursor;
+		do{
 			++cursor;
 			c = codeU8[cursor];
-		}
-		const StringId id(accum);
-		Token * o = identifyToken(id);
+		}while( isNumber(c) || isChar(c));
+		const StringId id(std::string(prog+first,cursor-first));
+		const Token * o = identifyToken(id);
 		if(o!=nullptr) {
-			return o->clone();
+			token = *o;
 		}else if(id==Consts::IDENTIFIER_LINE) { // __LINE__
-			return new TValueNumber(line);
+			token = TValueNumber::create(line);
 		}  else  {
 			const Operator *op = Operator::getOperator(id);
-			if(op!=nullptr)
-				return new TOperator(op);
-			return new TIdentifier(id);
+			token = op!=nullptr ? TOperator::create(op) : TIdentifier::create(id);
 		}
-	} else if(c==';') {
-		++cursor;
-		return new TEndCommand;
-	} else if(c=='{') {
-		++cursor;
-		return new TStartBlock;
-	} else if(c=='}') {
-		++cursor;
-		return new TEndBlock;
-	} else if(c=='(') {
-		++cursor;
-		return new TStartBracket;
-	} else if(c==')') {
-		++cursor;
-		return new TEndBracket;
-	} else if(c==',') {
-		++cursor;
-		return new TDelimiter;
-	} else if(c=='[') {
-		++cursor;
-		return new TStartIndex;
-	} else if(c==']') {
-		++cursor;
-		return new TEndIndex;
-	} else if(c==':' && codeU8[cursor+1]!='=' && codeU8[cursor+1]!=':' ) {
+		return true;
+	}
+	switch(c){
+		case ';':
+			++cursor;
+			token = TEndCommand::create();
+			return true;
+		case '{':
+			++cursor;
+			token = TStartBlock::create();
+			return true;
+		case '}':
+			++cursor;
+			token = TEndBlock::create();
+			return true;
+		case '(':
+			++cursor;
+			token = TStartBracket::create();
+			return true;
+		case ')':
+			++cursor;
+			token = TEndBracket::create();
+			return true;
+		case ',':
+			++cursor;
+			token = TDelimiter::create();
+			return true;
+		case '[':
+			++cursor;
+			token = TStartIndex::create();
+			return true;
+		case ']':
+			++cursor;
+			token = TEndIndex::create();
+			return true;
+		default:
+			break;
+	}
+	if(c==':' && codeU8[cursor+1]!='=' && codeU8[cursor+1]!=':' ) {
 		++cursor;
-		return new TColon;
+		token = TColon::create();
+		return true;
 	} else if(c=='$' && isChar(codeU8[cursor+1]) ){
-		c = codeU8[++cursor]; // consume '$'
-		std::string accum;
+		const auto first = ++cursor; // consume '$'
+		c = codeU8[cursor];
 		while( isNumber(c) || isChar(c)) {
-			accum+=c;
 			++cursor;
 			c = codeU8[cursor];
 		}
-//        std::cout << "FOUND ID :"<<accum<<":"<<cursor<<"\n";
-		return new TValueIdentifier(StringId(accum));
+		token = TValueIdentifier::create(StringId(std::string(prog+first,cursor-first)));
+		return true;
 
 	} else if( isOperator(c) ) {
-		std::string accum;
 		size_t cursor2 = cursor;
 		while(isOperator(c)) {
-			accum += c;
 			++cursor2;
 			c = codeU8[cursor2];
 		}
+		const std::string accum(prog+cursor,cursor2-cursor);
 
 		const Operator * op = nullptr;
 		for(size_t operatorLength = accum.length(); true; --operatorLength) {
-			op = Operator::getOperator(accum.substr(0,operatorLength));
+			op = Operator::getOperator(operatorLength==accum.length() ? accum : accum.substr(0,operatorLength));
 			if(op!=nullptr) {
 				cursor+=operatorLength;
 				break;
 			}
 			if(operatorLength<=1) {
 				std::cout  << std::endl<< accum << std::endl;
-				throw new Error(std::string("Unknown Operator: ")+accum,line);
+				throw createError(std::string("Unknown Operator: ")+accum,line);
 			}
 		}
 		// test for unary minus
-		if(op->getString()=="-") {
-			Token * last = tokens.empty()? nullptr : tokens.back().get(); // Bugfix[BUG:20090107]
+		static const Operator * minusOp = Operator::getOperator("-");
+		if(op==minusOp) {
+			const Token * last = tokens.empty()? nullptr : &tokens.back(); // Bugfix[BUG:20090107]
 			if( last==nullptr ||
 					(!(Token::isA<TEndBracket>(last)	|| Token::isA<TEndIndex>(last)||
 						Token::isA<TIdentifier>(last)	||
@@ -262,23 +295,40 @@ Token * Tokenizer::readNextToken(const std::string & codeU8, std::size_t & curso
 						Token::isA<TValueString>(last)	|| Token::isA<TValueNumber>(last) ||
 						Token::isA<TValueVoid>(last) ))){
 				// TODO ++,--
-
-				op = Operator::getOperator("_-");
+				static const Operator * unaryMinusOp = Operator::getOperator("_-");
+				op = unaryMinusOp;
 			}
 		}
 
-		return new TOperator(op);
+		token = TOperator::create(op);
+		return true;
 	}
 	// String: ".*" | '.*'
 	else if(c=='"' || c=='\'') {
 		const char stringEncloser = c;
-		++cursor;
-		c = codeU8[cursor];
-		std::ostringstream s;
+		const auto first = ++cursor;
+		// strings without escape sequences are referenced in the code
+		while(cursor<codeU8.length()) {
+			c = codeU8[cursor];
+			if(c==stringEncloser){
+				token = TValueString::create(prog+first,cursor-first);
+				++cursor;
+				return true;
+			}else if(c=='\n'){
+				++line;
+			}else if(c=='\\'){
+				break;
+			}
+			++cursor;
+		}
+		std::string s(prog+first,cursor-first);
 		while(cursor<codeU8.length()) {
+			c = codeU8[cursor];
 			if(c==stringEncloser){
 				++cursor;
-				return new TValueString(s.str());
+				const std::string & stored = storeString(std::move(s));
+				token = TValueString::create(stored.data(),stored.length());
+				return true;
 			}else if(c=='\n'){
 				++line;
 			}else if(c=='\\' ) { // http://de.wikipedia.org/wiki/Steuerzeichen
@@ -298,21 +348,20 @@ Token * Tokenizer::readNextToken(const std::string & codeU8, std::size_t & curso
 					default:	c = codeU8[cursor];
 				}
 			}
-			s<<c;
+			s += c;
 			++cursor;
-			c = codeU8[cursor];
 		}
-		throw new Error(std::string("Unclosed String. 2")+s.str().substr(0,10),line);
+		throw createError(std::string("Unclosed String. 2")+s.substr(0,10),line);
 
 	}else if(line==1 && c=='#' && codeU8[cursor+1]=='!') {
 		++cursor;
 		while(cursor<codeU8.length() && codeU8[cursor]!='\n')
 			++cursor;
-		return nullptr;
+		return false;
 
 	}
-	throw new Error(std::string("Unknown syntax error near: \n...")+(prog+ (cursor>10?(cursor-10):0) ),line);
-	return nullptr;
+	throw createError(std::string("Unknown syntax error near: \n...")+(prog+ (cursor>10?(cursor-10):0) ),line);
+	return false;
 }
 
 }
@@ -8,22 +8,26 @@
 #include "Token.h"
 #include "../Objects/Exception.h"
 #include "../Utils/StringId.h"
-#include "../Utils/ObjRef.h"
 
 #include <cstddef>
 #include <string>
 #include <cstring>
+#include <deque>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
 namespace EScript {
 
-//! [Tokenizer]
+/*! [Tokenizer]
+	Splits a script into a flat array of Tokens. The string payload of the tokens points into the code
+	(or, for strings containing escape sequences, into the string table of the Tokenizer); so the code and
+	the Tokenizer have to outlive the tokens.	*/
 class Tokenizer {
 	public:
-		typedef std::unordered_map<StringId, _CountedRef<Token> > tokenMap_t;
-		typedef std::vector<_CountedRef<Token> > tokenList_t;
-		static Token * identifyStaticToken(StringId id);
+		typedef std::unordered_map<StringId, Token> tokenMap_t;
+		typedef std::vector<Token> tokenList_t;
+		static const Token * identifyStaticToken(StringId id);
 
 		//!	[Tokenizer::Error] ---|> [Exception] ---|> [Object]
 		class Error : public Exception {
@@ -35,12 +39,22 @@ class Tokenizer {
 		// ---
 
 		void getTokens( const std::string & codeU8,tokenList_t & tokens);
-		void defineToken(const std::string & name,Token * value);
+		void defineToken(const std::string & name,const Token & value);
+
+		/*! Store a string that is referenced by a token (e.g. TValueString::create(...)) and
+			that lives as long as the Tokenizer.	*/
+		const std::string & storeString(std::string && s);
+
+		/*! Has to be locked while creating the exceptions thrown by the Tokenizer and the Parser:
+			Files may be parsed on several threads (see precompileFiles(...)) and creating an Object
+			changes the reference counter of its Type.	*/
+		static std::mutex & getErrorMutex();
 
 	private:
+		static Error * createError(const std::string & msg,int line);
 
-		Token * readNextToken(const std::string & codeU8, std::size_t & cursor,int &line,size_t & startPos,tokenList_t & tokens);
-		Token * identifyToken(StringId id)const;
+		bool readNextToken(const std::string & codeU8, std::size_t & cursor,int &line,size_t & startPos,const tokenList_t & tokens,Token & token);
+		const Token * identifyToken(StringId id)const;
 
 		static bool isNumber(const char c)	{	return c>='0' && c<='9';	}
 		static bool isChar(char c)			{	return (c>='a' && c<='z') || (c>='A' && c<='Z') || c=='_' || c<0; }
@@ -48,6 +62,7 @@ class Tokenizer {
 		static bool isOperator(char c)		{	return strchr("+-/*|%&!<>=^.?:~@",c)!=nullptr;	}
 
 		tokenMap_t customTokens;
+		std::deque<std::string> stringTable; //!< deque: the strings keep their addresses
 };
 
 }
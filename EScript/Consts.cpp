@@ -16,6 +16,7 @@ const StringId Consts::IDENTIFIER_fn_call("_call");
 const StringId Consts::IDENTIFIER_fn_constructor("_constructor");
 const StringId Consts::IDENTIFIER_fn_less("<");
 const StringId Consts::IDENTIFIER_fn_greater(">");
+const StringId Consts::IDENTIFIER_fn_plus("+");
 const StringId Consts::IDENTIFIER_fn_equal("==");
 const StringId Consts::IDENTIFIER_fn_identical("===");
 const StringId Consts::IDENTIFIER_fn_getIterator("getIterator");
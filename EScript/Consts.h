@@ -26,6 +26,7 @@ struct Consts{
 	static const StringId IDENTIFIER_fn_it_key;
 	static const StringId IDENTIFIER_fn_it_value;
 	static const StringId IDENTIFIER_fn_less;
+	static const StringId IDENTIFIER_fn_plus;
 	static const StringId IDENTIFIER_fn_equal;
 	static const StringId IDENTIFIER_fn_identical;
 	static const StringId IDENTIFIER_fn_getIterator;
@@ -35,6 +35,13 @@ void init() {
 	Iterator::init(*SGLOBALS);
 	Array::init(*SGLOBALS);
 	Map::init(*SGLOBALS);
+	SortedMap::init(*SGLOBALS);
+	Set::init(*SGLOBALS);
+	PriorityQueue::init(*SGLOBALS);
+	Float64Array::init(*SGLOBALS);
+	Float32Array::init(*SGLOBALS);
+	Int32Array::init(*SGLOBALS);
+	UInt8Array::init(*SGLOBALS);
 	Exception::init(*SGLOBALS);
 	Delegate::init(*SGLOBALS);
 	Namespace::init(*SGLOBALS);
@@ -45,6 +45,13 @@ Instruction Instruction::createCheckType(const uint32_t localVarIdx){
 	return i;
 }
 
+//! (static)
+Instruction Instruction::createConcat(const uint32_t numParts){
+	Instruction i(I_CONCAT);
+	i.setValue_uint32(numParts);
+	return i;
+}
+
 //! (static)
 Instruction Instruction::createCreateInstance(const uint32_t numParams){
 	Instruction i(I_CREATE_INSTANCE);
@@ -212,6 +219,10 @@ std::string Instruction::toString(const InstructionBlock & ctxt)const{
 		out << "checkType $" << getValue_uint32() <<" // '" << ctxt.getLocalVarName(getValue_uint32()).toString()<<"'";
 		break;
 	}
+	case I_CONCAT:{
+		out << "concat (numParts) " << getValue_uint32();
+		break;
+	}
 	case I_CREATE_INSTANCE:{
 		out << "createInstance (numParams) " << getValue_uint32();
 		break;
@@ -297,7 +308,7 @@ std::string Instruction::toString(const InstructionBlock & ctxt)const{
 		break;
 	}
 	case I_PUSH_STRING:{
-		out << "push (String) #"<<getValue_uint32()<<" // \"" << ctxt.getStringConstant(getValue_uint32())  << "\"";
+		out << "push (String) #"<<getValue_uint32()<<" // \"" << ctxt.getStringConstant(getValue_uint32()).str()  << "\"";
 		break;
 	}
 	case I_PUSH_UINT:{
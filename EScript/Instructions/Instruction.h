@@ -24,6 +24,7 @@ class Instruction {
 			I_CALL,							// -2+x +1
 			I_CREATE_INSTANCE,				// -1+x +1
 			I_CHECK_TYPE,					// -1   +1
+			I_CONCAT,						// -x +1
 			I_DUP,							// +1
 			I_FIND_VARIABLE,				// +2
 			I_GET_ATTRIBUTE,				// -1 +1
@@ -79,6 +80,7 @@ class Instruction {
 		static Instruction createAssignVariable(const StringId & varName);
 		static Instruction createCall(const uint32_t numParams);
 		static Instruction createCheckType(const uint32_t localVarIdx);
+		static Instruction createConcat(const uint32_t numParts);
 		static Instruction createCreateInstance(const uint32_t numParams);
 		static Instruction createDup()				{	return Instruction(I_DUP);	}
 		static Instruction createFindVariable(const StringId & id);
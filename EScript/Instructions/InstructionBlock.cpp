@@ -48,13 +48,12 @@ std::string InstructionBlock::toString()const{
 		out << "String constants:";
 		uint32_t i = 0;
 		for(const auto & stringConst : stringConstants) {
-			out << " #"<<i<<"(\"" << stringConst << "\")";
+			out << " #"<<i<<"(\"" << stringConst.str() << "\")";
 			++i;
 		}
 		out << "\n";
 	}
 	out << "---\n";
-//		std::vector<std::string> stringConstants;
 	{
 		uint32_t i = 0;
 		for(const auto & instruction : instructions) {
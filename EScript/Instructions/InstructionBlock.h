@@ -6,6 +6,7 @@
 #define INSTRUCTION_BLOCK_H
 
 #include "Instruction.h"
+#include "../Utils/StringData.h"
 #include "../Utils/StringId.h"
 #include "../Objects/Object.h"
 
@@ -18,7 +19,7 @@ class UserFunction;
 //! Collection of (assembler-)instructions and the corresponding data.
 class InstructionBlock {
 		std::vector<StringId> localVariables;
-		std::vector<std::string> stringConstants;  //! \todo --> StringData
+		std::vector<StringData> stringConstants;  //!< shared by all String objects created from the literals
 		std::vector<Instruction> instructions;
 		std::vector<ObjRef > internalFunctions; //! UserFunction
 		// flags...
@@ -36,7 +37,8 @@ class InstructionBlock {
 		}
 
 		uint32_t declareString(const std::string & str){
-			stringConstants.push_back(str);
+			stringConstants.emplace_back(str);
+			stringConstants.back().getNumCodepoints(); // classify the encoding once when compiling
 			return static_cast<uint32_t>(stringConstants.size()-1);
 		}
 		uint32_t declareLocalVariable(const StringId & name){
@@ -52,7 +54,7 @@ class InstructionBlock {
 
 		size_t getNumLocalVars()const								{	return localVariables.size();	}
 		size_t getNumInstructions()const							{	return instructions.size();	}
-		std::string getStringConstant(const uint32_t index)const	{	return index<=stringConstants.size() ? stringConstants[index] : "";	}
+		StringData getStringConstant(const uint32_t index)const		{	return index<stringConstants.size() ? stringConstants[index] : StringData();	}
 		UserFunction * getUserFunction(const uint32_t index)const;
 
 		std::vector<Instruction> & _accessInstructions()			{	return instructions;	}
@@ -5,6 +5,7 @@
 #include "Delegate.h"
 
 #include "../../Basics.h"
+#include "../ObjectCounters.h"
 
 namespace EScript{
 
@@ -22,27 +23,31 @@ Delegate * Delegate::create(ObjPtr object,ObjPtr function){
 	return new Delegate(object,function);
 	#endif
 	if(pool.empty()){
+		++ObjectCounters::pools[ObjectCounters::DELEGATE].misses;
 		for(int i = 0;i<32;++i){
 			pool.push(new Delegate(nullptr,nullptr));
 		}
-		return create(object,function);
 	}else{
-		Delegate * o = pool.top();
-		pool.pop();
-		o->myObjectRef = object;
-		o->functionRef = function;
-//        std::cout << ".";
-		return o;
+		++ObjectCounters::pools[ObjectCounters::DELEGATE].hits;
 	}
+	Delegate * o = pool.top();
+	pool.pop();
+	o->myObjectRef = object;
+	o->functionRef = function;
+	return o;
 
 }
 void Delegate::release(Delegate * o){
+	++ObjectCounters::pools[ObjectCounters::DELEGATE].released;
 	#ifdef ES_DEBUG_MEMORY
 	delete o;
 	return;
 	#endif
 	pool.push(o);
 }
+size_t Delegate::_getPoolSize(){
+	return pool.size();
+}
 
 //! initMembers
 void Delegate::init(EScript::Namespace & globals) {
@@ -19,6 +19,8 @@ class Delegate : public Object {
 
 		static Delegate * create(ObjPtr object,ObjPtr function);
 		static void release(Delegate * b);
+		//! (internal) Number of objects in the pool of unused objects.
+		static size_t _getPoolSize();
 		virtual ~Delegate()	{ }
 
 		Object * getObject()const				{	return myObjectRef.get();	}
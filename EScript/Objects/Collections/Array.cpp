@@ -5,18 +5,70 @@
 #include "Array.h"
 
 #include "../../Basics.h"
+#include "../ObjectCounters.h"
 #include "../../StdObjects.h"
 #include "../../Utils/StdConversions.h"
 #include "../../Consts.h"
 
+#include <algorithm>
 #include <iterator>
-#include <sstream>
 #include <string>
 #include <stack>
 #include <iostream>
 #include <random>
+#include <system_error>
+#include <thread>
 namespace EScript{
-	
+
+//! (internal) The native operators of the element types; used to detect operators replaced by a script.
+struct NativeOperators{
+	Object * equal,* less,* greater;
+	NativeOperators() : equal(nullptr),less(nullptr),greater(nullptr){}
+};
+static NativeOperators nativeNumberOperators;
+static NativeOperators nativeStringOperators;
+
+//! (static,internal)
+static Object * getTypeFunction(Type * type,StringId id){
+	Attribute * attr = type->findTypeAttribute(id);
+	return attr ? attr->getValue() : nullptr;
+}
+
+//! (static,internal)
+static NativeOperators getNativeOperators(Type * type){
+	NativeOperators operators;
+	operators.equal = getTypeFunction(type,Consts::IDENTIFIER_fn_equal);
+	operators.less = getTypeFunction(type,Consts::IDENTIFIER_fn_less);
+	operators.greater = getTypeFunction(type,Consts::IDENTIFIER_fn_greater);
+	return operators;
+}
+
+//! (static,internal) Returns true iff the operator of the elements of the given kind is the native one.
+static bool hasNativeOperator(Array::elementKind_t kind,StringId id){
+	Type * type;
+	const NativeOperators * operators;
+	if(kind==Array::ELEMENTS_NUMBERS){
+		type = Number::getTypeObject();
+		operators = &nativeNumberOperators;
+	}else if(kind==Array::ELEMENTS_STRINGS){
+		type = String::getTypeObject();
+		operators = &nativeStringOperators;
+	}else{
+		return false;
+	}
+	Object * nativeFunction = id==Consts::IDENTIFIER_fn_equal ? operators->equal :
+							id==Consts::IDENTIFIER_fn_less ? operators->less :
+							id==Consts::IDENTIFIER_fn_greater ? operators->greater : nullptr;
+	return nativeFunction!=nullptr && getTypeFunction(type,id)==nativeFunction;
+}
+
+//! (static,internal) a == b for two elements of the given kind (Numbers or Strings).
+static inline bool isNativeEqual(Array::elementKind_t kind,const Object * a,const Object * b){
+	return kind==Array::ELEMENTS_NUMBERS ?
+			static_cast<const Number*>(a)->getValue()==static_cast<const Number*>(b)->getValue() :
+			static_cast<const String*>(a)->getStringData()==static_cast<const String*>(b)->getStringData();
+}
+
 //! (static)
 Type * Array::getTypeObject(){
 	static Type * typeObject = new Type(Collection::getTypeObject()); // ---|> Collection
@@ -30,6 +82,9 @@ void Array::init(EScript::Namespace & globals) {
 
 	declareConstant(&globals,getClassName(),typeObject);
 
+	nativeNumberOperators = getNativeOperators(Number::getTypeObject());
+	nativeStringOperators = getNativeOperators(String::getTypeObject());
+
 	//! [ESMF] Array new Array([Obj*]);*/
 	ES_CTOR(typeObject,0,-1,Array::create(parameter))
 
@@ -108,26 +163,27 @@ void Array::init(EScript::Namespace & globals) {
 
 	//! [ESMF] thisObj Array.resize(Number[, Object fillValue] )
 	ES_MFUNCTION(typeObject,Array,"resize",1,2,{
-		const size_t oldSize = thisObj->size();
 		const size_t newSize = static_cast<size_t>(parameter[0].to<uint32_t>(rt)); // \todo set uint32_t to size_t when it compiles on a mac
-		thisObj->resize(newSize);
-		if(parameter.count()>1){
-			for(size_t i = oldSize;i<newSize;++i){
-				thisObj->at(i) = parameter[1]->getRefOrCopy();
-			}
-		}
+		thisObj->resize(newSize,parameter[1]);
 		return thisEObj;
 	})
 
 	//! [ESMF] thisObj Array.reverse()
 	ES_MFUN(typeObject,Array,"reverse",0,0,(thisObj->reverse(),thisEObj))
 
-	/*! [ESMF] thisObj Array.rSort( [comparementFunction]);
+	/*! [ESMF] thisObj Array.rSort( [comparementFunction [,Bool stable]] );
 		Like Array.sort, but the array is sorted in reverse order. */
-	ES_MFUN(typeObject,Array,"rSort",0,1,(thisObj->rt_sort(rt,parameter[0].get(),true),thisEObj))
+	ES_MFUN(typeObject,Array,"rSort",0,2,(thisObj->rt_sort(rt,parameter[0].toBool() ? parameter[0].get() : nullptr,true,parameter[1].toBool(false)),thisEObj))
+
+	/*! [ESMF] thisObj Array.sort( [comparementFunction [,Bool stable]] );
+		\param comparementFunction false/void for the default '<' comparison
+		\param stable keep the order of equivalent elements	*/
+	ES_MFUN(typeObject,Array,"sort",0,2,(thisObj->rt_sort(rt,parameter[0].toBool() ? parameter[0].get() : nullptr,false,parameter[1].toBool(false)),thisEObj))
 
-	//! [ESMF] thisObj Array.sort( [comparementFunction]);
-	ES_MFUN(typeObject,Array,"sort",0,1,(thisObj->rt_sort(rt,parameter[0].get(),false),thisEObj))
+	/*! [ESMF] thisObj Array.sortBy( keyFunction [,Bool reverseOrder] );
+		Stable sort by keyFunction(element); the function is called once per element.
+		\code [ {"n":3}, {"n":1} ].sortBy( fn(m){ return m["n"]; } ) // -> [ {"n":1}, {"n":3} ]	*/
+	ES_MFUN(typeObject,Array,"sortBy",1,2,(thisObj->rt_sortBy(rt,parameter[0],parameter[1].toBool(false)),thisEObj))
 
 	//! [ESMF] thisObj Array.splice( start,length [,Array replacement] );
 	ES_MFUN(typeObject,Array,"splice",2,3,(thisObj->splice(parameter[0].to<int>(rt),parameter[1].to<int>(rt),parameter.count()>2 ? assertType<Array>(rt,parameter[2]) : nullptr),thisEObj))
@@ -151,8 +207,10 @@ std::stack<Array *> Array::pool;
 Array * Array::create(Type * type){
 	Array * a = nullptr;
 	if( !(type==nullptr || type==Array::getTypeObject()) || pool.empty()){
+		++ObjectCounters::pools[ObjectCounters::ARRAY].misses;
 		a = new Array;
 	}else{
+		++ObjectCounters::pools[ObjectCounters::ARRAY].hits;
 		a = pool.top();
 		pool.pop();
 	}
@@ -182,6 +240,7 @@ Array * Array::create(size_t num,char ** strings,Type * type){
 
 //! (static)
 void Array::release(Array * a){
+	++ObjectCounters::pools[ObjectCounters::ARRAY].released;
 	#ifdef ES_DEBUG_MEMORY
 	delete a;
 	return;
@@ -199,6 +258,11 @@ void Array::release(Array * a){
 //	}
 }
 
+//! (static)
+size_t Array::_getPoolSize(){
+	return pool.size();
+}
+
 // -----------------------------------------------------------------------
 
 //! (internal)
@@ -206,6 +270,7 @@ void Array::init(const ParameterValues & p) {
 	data.clear();
 	data.reserve(p.count());
 	for(size_t i = 0; i < p.count(); ++i) {
+		addElementKind(p[i].get());
 		data.emplace_back(p[i]);
 	}
 //	data.assign(std::begin(p), std::end(p));
@@ -214,6 +279,7 @@ void Array::init(const ParameterValues & p) {
 //! (internal)
 void Array::init(size_t num, Object* const* objs) {
 	data.assign(objs, objs + num);
+	updateElementKind();
 }
 //! (internal)
 void Array::init(size_t num, char ** strings) {
@@ -222,6 +288,44 @@ void Array::init(size_t num, char ** strings) {
 	for(size_t i = 0; i < num; ++i) {
 		data.emplace_back(EScript::create(std::string(strings[i])));
 	}
+	elementKind = data.empty() ? ELEMENTS_EMPTY : ELEMENTS_STRINGS;
+}
+
+//! (static,internal)
+Array::elementKind_t Array::getElementKind(const Object * obj){
+	if(obj==nullptr)
+		return ELEMENTS_GENERIC;
+	else if(obj->getType()==Number::getTypeObject())
+		return ELEMENTS_NUMBERS;
+	else if(obj->getType()==String::getTypeObject())
+		return ELEMENTS_STRINGS;
+	else
+		return ELEMENTS_GENERIC;
+}
+
+//! (static,internal)
+Array::elementKind_t Array::combineElementKinds(elementKind_t a,elementKind_t b){
+	if(a==ELEMENTS_EMPTY)
+		return b;
+	else if(b==ELEMENTS_EMPTY || a==b)
+		return a;
+	else
+		return ELEMENTS_GENERIC;
+}
+
+//! (internal)
+void Array::updateElementKind(){
+	elementKind = ELEMENTS_EMPTY;
+	for(const auto & element : data){
+		elementKind = combineElementKinds(elementKind,getElementKind(element.get()));
+		if(elementKind==ELEMENTS_GENERIC)
+			break;
+	}
+}
+
+//! (internal)
+bool Array::hasNativeEquality(const Object * obj)const{
+	return getElementKind(obj)==elementKind && hasNativeOperator(elementKind,Consts::IDENTIFIER_fn_equal);
 }
 
 //! ---|> [Object]
@@ -233,6 +337,7 @@ Object * Array::clone()const {
 	for(const auto & element : data) {
 		newArray->data[i++] = element->getRefOrCopy();
 	}
+	newArray->elementKind = elementKind;
 	return newArray;
 }
 
@@ -248,6 +353,9 @@ Object * Array::getValue(ObjPtr key) {
 void Array::setValue(ObjPtr key,ObjPtr value) {
 	if(key.isNull() ) return;
 	size_t index = static_cast<size_t>(key->toInt());
+	addElementKind(value.get());
+	if(index>data.size()) // gap filled with nullptr
+		elementKind = ELEMENTS_GENERIC;
 	if(index>=data.size())
 		data.resize(index + 1, nullptr);
 	data[index]=value;
@@ -266,14 +374,62 @@ Array::ArrayIterator * Array::getIterator() {
 //! ---|> Collection
 void Array::clear(){
 	data.clear();
+	elementKind = ELEMENTS_EMPTY;
+}
+
+//! ---|> Collection
+Object * Array::rt_findValue(Runtime & runtime,ObjPtr value){
+	const int index = rt_indexOf(runtime,value);
+	return index<0 ? nullptr : EScript::create(static_cast<uint32_t>(index));
+}
+
+//! ---|> Collection
+bool Array::rt_contains(Runtime & runtime,ObjPtr value){
+	return rt_indexOf(runtime,value)>=0;
+}
+
+//! (static,internal) Position of the element that remains when comparing all elements as Collection::rt_extract does.
+template<typename value_t,typename Getter_T>
+static size_t extractPosition(const Array::container_t & data,Getter_T getValue,bool greater,bool decision){
+	size_t position = 0;
+	for(size_t i = 1; i<data.size(); ++i){
+		const value_t & value = getValue(data[i]);
+		const value_t & current = getValue(data[position]);
+		if( (greater ? current<value : value<current) == decision )
+			position = i;
+	}
+	return position;
+}
+
+//! ---|> Collection
+Object * Array::rt_extract(Runtime & runtime,StringId functionId,bool decision/*=true*/){
+	if(data.empty() || !hasNativeOperator(elementKind,functionId))
+		return Collection::rt_extract(runtime,functionId,decision);
+	const bool greater = functionId==Consts::IDENTIFIER_fn_greater;
+	if(elementKind==ELEMENTS_NUMBERS){
+		return data[extractPosition<double>(data,
+				[](const ObjRef & element) -> double {	return static_cast<const Number*>(element.get())->getValue();	},
+				greater,decision)].get();
+	}else{
+		return data[extractPosition<std::string>(data,
+				[](const ObjRef & element) -> const std::string & {	return static_cast<const String*>(element.get())->getString();	},
+				greater,decision)].get();
+	}
 }
 
 int Array::rt_indexOf(Runtime & runtime,ObjPtr search,size_t index){
 	if(index>=count()||search.isNull()) return -1;
 
-	const_iterator it = begin();
+	if(hasNativeEquality(search.get())){
+		for(; index<data.size(); ++index){
+			if(isNativeEqual(elementKind,search.get(),data[index].get()))
+				return index;
+		}
+		return -1;
+	}
+	const_iterator it = data.cbegin();
 	std::advance(it, index);
-	for(; it != end(); ++it) {
+	for(; it != data.cend(); ++it) {
 		if( search->isEqual(runtime,*it) )
 			return index;
 		++index;
@@ -285,12 +441,14 @@ size_t Array::rt_removeValue(Runtime & runtime,const ObjPtr value,const int limi
 	if(start > size() || value.isNull() || limit==0)
 		return 0;
 
+	const bool nativeEquality = hasNativeEquality(value.get());
 	size_t numberOfDeletions = 0;
 	std::vector<ObjRef> tempArray;
-	std::vector<ObjRef>::const_iterator startIt = begin();
+	std::vector<ObjRef>::const_iterator startIt = data.cbegin();
 	std::advance(startIt, start);
-	for(const_iterator it = begin();it!=end();++it) {
-		if( it>=startIt && (limit<0 || numberOfDeletions<static_cast<size_t>(limit)) && value->isEqual(runtime,*it) ){
+	for(const_iterator it = data.cbegin();it!=data.cend();++it) {
+		if( it>=startIt && (limit<0 || numberOfDeletions<static_cast<size_t>(limit)) &&
+				(nativeEquality ? isNativeEqual(elementKind,value.get(),it->get()) : value->isEqual(runtime,*it)) ){
 			++numberOfDeletions;
 		}else{
 			tempArray.push_back(*it);
@@ -322,20 +480,20 @@ void Array::reverse(){
 }
 
 std::string Array::implode(const std::string & delimiter/*=";"*/){
-	std::ostringstream sprinter;
-
-	ERef<Iterator> iRef = getIterator();
-	int j = 0;
-	while(! iRef->end()) {
-		ObjRef value = iRef->value();
-		if(!value.isNull()) {
-			if(j++>0)
-				sprinter << delimiter;
-			sprinter << value.toString();
-		}
-		iRef->next();
+	std::string result;
+	bool first = true;
+	for(const auto & value : data){
+		if(value.isNull())
+			continue;
+		if(!first)
+			result += delimiter;
+		first = false;
+		if(elementKind==ELEMENTS_STRINGS)
+			result += static_cast<const String*>(value.get())->getString();
+		else
+			result += value->toString();
 	}
-	return sprinter.str();
+	return result;
 }
 
 static bool compare(Runtime & runtime,Object * function,Object * a,Object * b){
@@ -347,10 +505,193 @@ static bool compare(Runtime & runtime,Object * function,Object * a,Object * b){
 }
 
 
-//! (implements quicksort)
-void Array::rt_sort(Runtime & runtime,Object * function/*=nullptr*/,bool reverseOrder ) {
+//! (internal) Element of an Array sorted natively by its key.
+template<typename key_t>
+struct SortEntry{
+	key_t key;
+	size_t index;
+	SortEntry(key_t _key,size_t _index) : key(_key),index(_index){}
+};
+
+//! (static,internal) NaNs are sorted behind all other Numbers.
+static bool isLessNumberEntry(const SortEntry<double> & a,const SortEntry<double> & b){
+	return a.key<b.key || (b.key!=b.key && a.key==a.key);
+}
+
+//! (static,internal)
+static bool isLessStringEntry(const SortEntry<const std::string *> & a,const SortEntry<const std::string *> & b){
+	return *a.key < *b.key;
+}
+
+static const size_t PARALLEL_SORT_THRESHOLD = 1<<16;
+static const size_t MAX_SORT_THREADS = 8;
+
+/*! (static,internal) Sort the entries using std::sort or std::stable_sort. Large ranges are split into chunks
+	that are sorted in parallel and then merged. The entries contain no references, so this is thread safe.	*/
+template<typename Entry_T,typename Less_T>
+static void nativeSort(std::vector<Entry_T> & entries,Less_T isLess,bool stable){
+	const size_t numChunks = entries.size()<PARALLEL_SORT_THRESHOLD ? 1 :
+			std::max<size_t>(1,std::min(static_cast<size_t>(std::thread::hardware_concurrency()),MAX_SORT_THREADS));
+	std::vector<size_t> bounds;
+	for(size_t i = 0; i<=numChunks; ++i)
+		bounds.push_back( entries.size()*i/numChunks );
+
+	auto sortChunk = [&](size_t chunk){
+		if(stable)
+			std::stable_sort(entries.begin()+bounds[chunk],entries.begin()+bounds[chunk+1],isLess);
+		else
+			std::sort(entries.begin()+bounds[chunk],entries.begin()+bounds[chunk+1],isLess);
+	};
+	if(numChunks<=1){
+		sortChunk(0);
+		return;
+	}
+	std::vector<std::thread> threads;
+	for(size_t chunk = 1; chunk<numChunks; ++chunk){
+		try{
+			threads.emplace_back(sortChunk,chunk);
+		}catch(const std::system_error &){ // no more threads available
+			sortChunk(chunk);
+		}
+	}
+	sortChunk(0);
+	for(auto & thread : threads)
+		thread.join();
+	// std::inplace_merge is stable
+	for(size_t width = 1; width<numChunks; width*=2){
+		for(size_t chunk = 0; chunk+width<numChunks; chunk+=2*width){
+			std::inplace_merge(entries.begin()+bounds[chunk],entries.begin()+bounds[chunk+width],
+								entries.begin()+bounds[std::min(chunk+2*width,numChunks)],isLess);
+		}
+	}
+}
+
+/*! (static,internal) Stable bottom-up merge sort of the indices. Unlike std::stable_sort, this works for
+	inconsistent comparison functions. Returns false if the sorting has been aborted by an exception.	*/
+template<typename Less_T>
+static bool rt_mergeSort(Runtime & runtime,std::vector<size_t> & indices,Less_T isLess){
+	const size_t size = indices.size();
+	std::vector<size_t> buffer(size);
+	for(size_t width = 1; width<size; width*=2){
+		for(size_t left = 0; left<size; left+=2*width){
+			const size_t middle = std::min(left+width,size);
+			const size_t right = std::min(left+2*width,size);
+			size_t i = left, j = middle, k = left;
+			while(i<middle && j<right){
+				buffer[k++] = isLess(indices[j],indices[i]) ? indices[j++] : indices[i++];
+				if(!runtime.checkNormalState())
+					return false;
+			}
+			while(i<middle)
+				buffer[k++] = indices[i++];
+			while(j<right)
+				buffer[k++] = indices[j++];
+		}
+		indices.swap(buffer);
+	}
+	return true;
+}
+
+//! (static,internal) Reorder the elements; the i-th element becomes the element at position indices[i].
+static void permute(Array::container_t & data,const std::vector<size_t> & indices){
+	Array::container_t sortedData;
+	sortedData.reserve(data.size());
+	for(const auto & index : indices)
+		sortedData.emplace_back(std::move(data[index]));
+	data.swap(sortedData);
+}
+
+/*! (static,internal) Sort the data natively by the given keys (Numbers or Strings).
+	Returns false if the keys are not all Numbers or all Strings or if their '<' operator has been replaced.	*/
+static bool sortByNativeKeys(Array::container_t & data,const Array::container_t & keys,Array::elementKind_t kind,
+								bool reverseOrder,bool stable){
+	if(!hasNativeOperator(kind,Consts::IDENTIFIER_fn_less))
+		return false;
+	std::vector<size_t> indices;
+	indices.reserve(keys.size());
+	if(kind==Array::ELEMENTS_NUMBERS){
+		std::vector<SortEntry<double>> entries;
+		entries.reserve(keys.size());
+		for(size_t i = 0; i<keys.size(); ++i)
+			entries.emplace_back(static_cast<const Number*>(keys[i].get())->getValue(),i);
+		if(reverseOrder)
+			nativeSort(entries,[](const SortEntry<double> & a,const SortEntry<double> & b){	return isLessNumberEntry(b,a);	},stable);
+		else
+			nativeSort(entries,isLessNumberEntry,stable);
+		for(const auto & entry : entries)
+			indices.push_back(entry.index);
+	}else{
+		std::vector<SortEntry<const std::string *>> entries;
+		entries.reserve(keys.size());
+		for(size_t i = 0; i<keys.size(); ++i)
+			entries.emplace_back(&static_cast<const String*>(keys[i].get())->getString(),i);
+		if(reverseOrder)
+			nativeSort(entries,[](const SortEntry<const std::string *> & a,const SortEntry<const std::string *> & b){	return isLessStringEntry(b,a);	},stable);
+		else
+			nativeSort(entries,isLessStringEntry,stable);
+		for(const auto & entry : entries)
+			indices.push_back(entry.index);
+	}
+	permute(data,indices);
+	return true;
+}
+
+void Array::rt_sort(Runtime & runtime,Object * function/*=nullptr*/,bool reverseOrder,bool stable) {
+	if(count()<=1) return;
+
+	if(function==nullptr && sortByNativeKeys(data,data,elementKind,reverseOrder,stable))
+		return;
+	if(stable){
+		container_t elements(data); // the comparison function could modify the array
+		std::vector<size_t> indices(elements.size());
+		for(size_t i = 0; i<indices.size(); ++i)
+			indices[i] = i;
+		const bool finished = rt_mergeSort(runtime,indices,[&](size_t a,size_t b){
+			return reverseOrder ? compare(runtime,function,elements[b].get(),elements[a].get()) :
+									compare(runtime,function,elements[a].get(),elements[b].get());
+		});
+		if(finished && elements.size()==data.size()){
+			permute(elements,indices);
+			data.swap(elements);
+		}
+		return;
+	}
+	rt_quickSort(runtime,function,reverseOrder);
+}
+
+void Array::rt_sortBy(Runtime & runtime,ObjPtr keyFunction,bool reverseOrder){
 	if(count()<=1) return;
 
+	container_t keys;
+	keys.reserve(data.size());
+	elementKind_t keyKind = ELEMENTS_EMPTY;
+	const size_t size = data.size();
+	for(size_t i = 0; i<size && i<data.size(); ++i){ // the key function could modify the array
+		ObjRef key = callFunction(runtime,keyFunction.get(),ParameterValues(data[i].get()));
+		if(!runtime.checkNormalState())
+			return;
+		keyKind = combineElementKinds(keyKind,getElementKind(key.get()));
+		keys.emplace_back(std::move(key));
+	}
+	if(keys.size()!=data.size()){
+		runtime.setException("Array.sortBy: The array has been modified by the key function.");
+		return;
+	}
+	if(sortByNativeKeys(data,keys,keyKind,reverseOrder,true))
+		return;
+	std::vector<size_t> indices(data.size());
+	for(size_t i = 0; i<indices.size(); ++i)
+		indices[i] = i;
+	const bool finished = rt_mergeSort(runtime,indices,[&](size_t a,size_t b){
+		return reverseOrder ? compare(runtime,nullptr,keys[b].get(),keys[a].get()) : compare(runtime,nullptr,keys[a].get(),keys[b].get());
+	});
+	if(finished)
+		permute(data,indices);
+}
+
+//! (internal,implements quicksort)
+void Array::rt_quickSort(Runtime & runtime,Object * function,bool reverseOrder ) {
+
 	//quicksort(runtime,0,count()-1);
 	std::stack<std::pair<size_t,size_t> > pos;
 	pos.push(std::make_pair(0,count()-1));
@@ -449,21 +790,32 @@ void Array::rt_filter(Runtime & runtime,ObjPtr function, const ParameterValues &
 void Array::append(Collection * c){
 	if(c==nullptr || c==this)
 		return;
-	size_t i = count();
-	resize( count()+c->count() );
+	reserve( count()+c->count() );
 	for(ERef<Iterator> iRef = c->getIterator(); !iRef->end() ;iRef->next()){
 		ObjRef value = iRef->value();
 		if(!value.isNull())
-			data[i++]=value->getRefOrCopy();
+			pushBack(value->getRefOrCopy());
 	}
 }
 
 void Array::swap(Array * other){
 	data.swap(other->data);
+	std::swap(elementKind,other->elementKind);
 }
 
-void Array::resize(size_t newSize){
+void Array::resize(size_t newSize,ObjPtr fillValue){
+	const size_t oldSize = data.size();
+	if(newSize>oldSize){
+		if(fillValue.isNull())
+			elementKind = ELEMENTS_GENERIC;
+		else
+			addElementKind(fillValue.get());
+	}
 	data.resize(newSize);
+	if(fillValue.isNotNull()){
+		for(size_t i = oldSize; i<newSize; ++i)
+			data[i] = fillValue->getRefOrCopy();
+	}
 }
 
 void Array::reserve(size_t capacity){
@@ -499,6 +851,8 @@ void Array::splice(int startIndex,int length,Array * replacement){
 		tmp.push_back(data[i]);
 	}
 	data.swap(tmp);
+	if(replacement!=nullptr)
+		elementKind = data.empty() ? ELEMENTS_EMPTY : combineElementKinds(elementKind,replacement->elementKind);
 }
 
 
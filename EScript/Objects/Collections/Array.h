@@ -9,12 +9,16 @@
 #include "../Iterator.h"
 #include "../../Utils/ObjArray.h"
 #include "../../Utils/StdFactories.h"
+#include <cstdint>
 #include <vector>
 #include <stack>
 
 namespace EScript {
 
-//! [Array]  ---|> [Collection] ---|> [Object]
+/*! [Array]  ---|> [Collection] ---|> [Object]
+	The Array keeps track of the kind of its elements. If all elements are Numbers (or all are Strings),
+	indexOf, contains, findValue, removeValue, max, min, implode and sort use native loops instead of calling
+	the elements' operators -- as long as these operators have not been replaced by a script.	*/
 class Array : public Collection {
 		ES_PROVIDES_TYPE_NAME(Array)
 
@@ -37,6 +41,17 @@ class Array : public Collection {
 		typedef std::ptrdiff_t							difference_type;
 		typedef std::reverse_iterator<iterator>			reverse_iterator;
 		typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+
+		/*! Kind of the contained elements. ELEMENTS_NUMBERS (ELEMENTS_STRINGS) guarantees that all elements
+			are of exactly the type Number (String); the types of the elements can not change in place.
+			The kind is determined conservatively: removing elements does not change the kind and accessing
+			the elements via a non-const reference (begin(),at(),...) sets it to ELEMENTS_GENERIC.	*/
+		enum elementKind_t : uint8_t{
+			ELEMENTS_EMPTY,
+			ELEMENTS_NUMBERS,
+			ELEMENTS_STRINGS,
+			ELEMENTS_GENERIC
+		};
 	//	@}
 
 	//---------------------
@@ -46,7 +61,7 @@ class Array : public Collection {
 	private:
 		static std::stack<Array *> pool;
 
-		Array(Type * type = nullptr) : Collection(type?type:getTypeObject()){}
+		Array(Type * type = nullptr) : Collection(type?type:getTypeObject()),elementKind(ELEMENTS_EMPTY){}
 
 		void init(const ParameterValues & p);
 		void init(size_t num,Object* const* objs);
@@ -67,6 +82,8 @@ class Array : public Collection {
 		}
 		
 		static void release(Array * b);
+		//! (internal) Number of objects in the pool of unused objects.
+		static size_t _getPoolSize();
 		virtual ~Array()	{ }
 	//	@}
 
@@ -85,20 +102,33 @@ class Array : public Collection {
 	// @{
 	private:
 		container_t data;
+		elementKind_t elementKind;
+
+		static elementKind_t getElementKind(const Object * obj);
+		static elementKind_t combineElementKinds(elementKind_t a,elementKind_t b);
+		//! Has to be called before obj is added.
+		void addElementKind(const Object * obj)	{
+			if(elementKind!=ELEMENTS_GENERIC || data.empty())
+				elementKind = data.empty() ? getElementKind(obj) : combineElementKinds(elementKind,getElementKind(obj));
+		}
+		void updateElementKind();
+		void rt_quickSort(Runtime & runtime,Object * function,bool reverseOrder);
+		//! Returns true iff the elements can be compared to obj without calling its '==' operator.
+		bool hasNativeEquality(const Object * obj)const;
 	public:
-		iterator begin()						{	return data.begin(); }
+		iterator begin()						{	elementKind = ELEMENTS_GENERIC;	return data.begin(); }
 		const_iterator begin()const				{	return data.begin(); }
-		iterator end()							{	return data.end(); }
+		iterator end()							{	elementKind = ELEMENTS_GENERIC;	return data.end(); }
 		const_iterator end()const				{	return data.end(); }
-		reverse_iterator rbegin()				{	return data.rbegin(); }
+		reverse_iterator rbegin()				{	elementKind = ELEMENTS_GENERIC;	return data.rbegin(); }
 		const_reverse_iterator rbegin()const	{	return data.rbegin(); }
-		reverse_iterator rend()					{	return data.rend(); }
+		reverse_iterator rend()					{	elementKind = ELEMENTS_GENERIC;	return data.rend(); }
 		const_reverse_iterator rend()const		{	return data.rend(); }
 
-		container_t & operator*()				{	return data;	}
+		container_t & operator*()				{	elementKind = ELEMENTS_GENERIC;	return data;	}
 		const container_t & operator*()const	{	return data;	}
 
-		ObjRef & at(size_t idx)					{	return data.at(idx);	}
+		ObjRef & at(size_t idx)					{	elementKind = ELEMENTS_GENERIC;	return data.at(idx);	}
 		const ObjRef & at(size_t idx)const		{	return data.at(idx);	}
 		void append(Collection * c);
 		Object * back()const					{	return empty() ? nullptr : (*(end()-1)).get();	}
@@ -107,20 +137,29 @@ class Array : public Collection {
 		iterator erase(iterator i,iterator j)	{	return data.erase(i,j);	}
 		Object * front()const					{	return empty() ? nullptr : (*(begin())).get();	}
 		Object * get(size_t index) const		{	return index<data.size() ?  data.at(index).get():nullptr;	}
+		elementKind_t getElementKind()const		{	return elementKind;	}
 		std::string implode(const std::string & delimiter=";");
 		void popBack()							{	data.pop_back();	}
-		void popFront()							{	data.erase(begin());	}
-		void pushBack(const ObjPtr & obj)		{	if(!obj.isNull()) data.push_back(obj);	}
-		void pushFront(const ObjPtr & obj)		{	if(!obj.isNull())	data.insert(begin(),obj.get());	}
+		void popFront()							{	data.erase(data.begin());	}
+		void pushBack(const ObjPtr & obj)		{	if(!obj.isNull()){	addElementKind(obj.get());	data.push_back(obj);	}	}
+		void pushFront(const ObjPtr & obj)		{	if(!obj.isNull()){	addElementKind(obj.get());	data.insert(data.begin(),obj.get());	}	}
 		void removeIndex(size_t index);
 		void reserve(size_t capacity);
-		void resize(size_t newSize);
+		//! New elements are set to copies of the fillValue (or nullptr).
+		void resize(size_t newSize,ObjPtr fillValue = nullptr);
 		void reverse();
 		void rt_filter(Runtime & runtime,ObjPtr function, const ParameterValues & additionalValues);
 		//! returns -1 if not found
 		int rt_indexOf(Runtime & runtime,ObjPtr search,size_t begin = 0);
 		size_t rt_removeValue(Runtime & runtime,const ObjPtr value,const int limit=-1,const size_t begin = 0);
-		void rt_sort(Runtime & runtime,Object * function = nullptr,bool reverseOrder = false);
+		/*! Sort the array using the comparison function (or the '<' operator of the elements).
+			- Without a comparison function, Numbers and Strings are sorted natively (in parallel for large arrays).
+			- The stable sort is a merge sort that keeps the order of equivalent elements.
+			- If an exception occurs, the array is left unchanged (stable or native sort) or partially sorted. */
+		void rt_sort(Runtime & runtime,Object * function = nullptr,bool reverseOrder = false,bool stable = false);
+		/*! Stable sort by the keys keyFunction(element), which are evaluated only once per element.
+			If all keys are Numbers or all are Strings, they are sorted natively; otherwise, by their '<' operator. */
+		void rt_sortBy(Runtime & runtime,ObjPtr keyFunction,bool reverseOrder = false);
 		size_t size() const						{	return data.size();		}
 		Array * slice(int startIndex,int length);
 		void splice(int startIndex,int length,Array * replacement);
@@ -157,6 +196,9 @@ class Array : public Collection {
 		virtual size_t count()const;
 		virtual ArrayIterator * getIterator();
 		virtual void clear();
+		virtual Object * rt_findValue(Runtime & runtime,ObjPtr value);
+		virtual bool rt_contains(Runtime & runtime,ObjPtr value);
+		virtual Object * rt_extract(Runtime & runtime,StringId functionId,bool decision = true);
 	//	@}
 
 	//---------------------
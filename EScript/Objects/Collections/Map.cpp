@@ -7,6 +7,7 @@
 #include "../../StdObjects.h"
 
 #include <string>
+#include <utility>
 
 namespace EScript{
 
@@ -47,12 +48,20 @@ void Map::init(EScript::Namespace & globals) {
 
 	//! [ESMF] bool Collection.containsKey(Object)
 	ES_MFUN(typeObject,Map,"containsKey",1,1,
-				thisObj->getValue(parameter[0].toString())!=nullptr)
+				thisObj->getValue(parameter[0])!=nullptr)
 
 	//! [ESMF] thisObj Map.merge( Collection [,bool overwrite = true] )
 	ES_MFUN(typeObject,Map,"merge",1,2,
 				(thisObj->merge(assertType<Collection>(rt,parameter[0]),parameter[1].toBool(true)),thisEObj))
 
+	//! [ESMF] Bool Map.isInsertionOrdered()
+	ES_MFUN(typeObject,const Map,"isInsertionOrdered",0,0,
+				thisObj->isInsertionOrdered())
+
+	//! [ESMF] thisObj Map.setInsertionOrdered( [Bool=true] )
+	ES_MFUN(typeObject,Map,"setInsertionOrdered",0,1,
+				(thisObj->setInsertionOrdered(parameter[0].toBool(true)),thisEObj))
+
 	//! [ESMF] thisObj swap.swap( Map other )
 	ES_MFUN(typeObject,Map,"swap",1,1,
 				(thisObj->swap(assertType<Map>(rt,parameter[0])),thisEObj))
@@ -78,7 +87,7 @@ Map * Map::create(const std::unordered_map<StringId,Object *> & attr){
 
 void Map::unset(ObjPtr key){
 	if(!key.isNull())
-		data.erase(key.toString());
+		data.erase(MapKey(key),numIterators==0);
 }
 
 void Map::merge(Collection * c,bool overwrite/*=true*/){
@@ -100,38 +109,70 @@ void Map::merge(Collection * c,bool overwrite/*=true*/){
 	}
 }
 
+void Map::setInsertionOrdered(bool b){
+	insertionOrdered = b;
+	if(b)
+		sorted = false; // the order is not tracked while the map is insertion ordered
+}
+
 void Map::swap(Map * other){
 	data.swap(other->data);
+	std::swap(sorted,other->sorted);
+}
+
+void Map::updateOrder(){
+	if(!insertionOrdered && !sorted){
+		data.sortByKey([this](const MapKey & a,const MapKey & b){	return isKeyLess(a,b);	});
+		sorted = true;
+	}
+}
+
+size_t Map::findPosition(const MapKey & key)const{
+	const size_t pos = data.find(key);
+	if(pos!=container_t::INVALID_POSITION)
+		return pos;
+	size_t next = data.getEndPosition();
+	if(insertionOrdered)
+		return next;
+	for(size_t p = data.getValidPosition(0); p<data.getEndPosition(); p = data.getValidPosition(p+1)){
+		if(isKeyLess(key,data.getKey(p)) && (next==data.getEndPosition() || isKeyLess(data.getKey(p),data.getKey(next))))
+			next = p;
+	}
+	return next;
 }
 
 //! ---|> Collection
 Object * Map::getValue(ObjPtr key) {
-	return key.isNull() ? nullptr : getValue(key.toString());
+	return key.isNull() ? nullptr : getValue(MapKey(key));
 }
 
-
 Object * Map::getValue(const std::string & key) {
-	container_t::iterator it = data.find(key);
-	return it==data.end() ? nullptr : (*it).second.value.get();
+	return getValue(MapKey(key));
+}
+
+Object * Map::getValue(const MapKey & key) {
+	const MapEntry * entry = data.findValue(key);
+	return entry ? entry->value.get() : nullptr;
 }
 
 Object * Map::getKeyObject(const std::string & key) {
-	container_t::iterator it = data.find(key);
-	return it==data.end() ? nullptr : (*it).second.key.get();
+	const MapEntry * entry = data.findValue(MapKey(key));
+	return entry ? entry->key.get() : nullptr;
 }
 
 //! ---|> Collection
 void Map::setValue(ObjPtr key,ObjPtr value) {
 	if(key.isNull()) return ;
-	std::string ident = key->toString();
-
-	container_t::iterator it = data.find(ident);
-	if(it!=data.end()){
-		it->second.key = key;
-		it->second.value = value;
-	}else{
-		data[ident]=MapEntry(key,value);
+	const MapKey mapKey(key);
+	const auto result = data.insert(mapKey,numIterators==0);
+	if(result.second && sorted){ // still sorted if appended behind a smaller key
+		const size_t pos = data.getEndPosition()-1;
+		sorted = !insertionOrdered &&
+				(pos==0 || (data.getValidPosition(pos-1)==pos-1 && !isKeyLess(mapKey,data.getKey(pos-1))));
 	}
+	MapEntry & entry = *result.first;
+	entry.key = key;
+	entry.value = value;
 }
 
 //! ---|> Collection
@@ -141,21 +182,23 @@ size_t Map::count() const{
 
 //! ---|> Collection
 Map::MapIterator * Map::getIterator() {
+	updateOrder();
 	return new MapIterator(this);
 }
 
 //! ---|> Collection
 void  Map::clear() {
 	data.clear();
+	sorted = !insertionOrdered;
 }
 
 //! ---|> [Object]
 Object * Map::clone()const {
 	Map *newMap= new Map(getType());
-	for(const auto & keyEntryPair : data) {
-		const MapEntry & sourceEntry = keyEntryPair.second;
+	newMap->insertionOrdered = insertionOrdered;
+	newMap->data.reserve(data.size());
+	for(const auto & sourceEntry : data)
 		newMap->setValue(sourceEntry.key->getRefOrCopy(), sourceEntry.value->getRefOrCopy());
-	}
 	return newMap;
 }
 
@@ -166,52 +209,76 @@ void Map::rt_filter(Runtime & runtime,ObjPtr function, const ParameterValues & a
 	if(!additionalValues.empty())
 		std::copy(additionalValues.begin(),additionalValues.end(),parameters.begin()+2);
 
-	for(const auto & keyEntryPair : data) {
-		const MapEntry & sourceEntry = keyEntryPair.second;
+	// the function may modify the map, so the entries are accessed by an iterator
+	for(ERef<MapIterator> it = getIterator(); !it->end(); it->next()) {
+		const MapEntry sourceEntry(it->key(),it->value());
 		parameters.set(0,sourceEntry.key);
 		parameters.set(1,sourceEntry.value);
 		if( callFunction(runtime,function.get(),parameters).toBool() ){
-			tempMap[keyEntryPair.first] = sourceEntry;
+			*tempMap.insert(MapKey(sourceEntry.key)).first = sourceEntry;
 		}
 	}
 	data.swap(tempMap);
+	sorted = false; // keys added by the function may have been visited out of order
 }
 // ------- MapIterator
 
 //! (ctor)
-Map::MapIterator::MapIterator(Map * _map):Iterator(),mapRef(_map) {
-	it = mapRef->data.begin();
+Map::MapIterator::MapIterator(Map * _map):Iterator(),mapRef(_map),position(0),
+		layoutVersion(_map->data.getLayoutVersion()),keyPosition(container_t::INVALID_POSITION) {
+	++mapRef->numIterators;
 }
 
+//! (dtor)
+Map::MapIterator::~MapIterator() {
+	--mapRef->numIterators;
+}
+
+//! (internal) Skip removed entries and follow reordered entries; the map may have been changed since the last call.
+void Map::MapIterator::updatePosition() {
+	const container_t & data = mapRef->data;
+	if(layoutVersion!=data.getLayoutVersion()){
+		layoutVersion = data.getLayoutVersion();
+		if(keyPosition!=container_t::INVALID_POSITION)
+			position = mapRef->findPosition(currentKey);
+		keyPosition = container_t::INVALID_POSITION;
+	}
+	position = data.getValidPosition(position);
+	if(position<data.getEndPosition() && position!=keyPosition){
+		currentKey = data.getKey(position);
+		keyPosition = position;
+	}
+}
 
 //! ---|> [Iterator]
 Object * Map::MapIterator::key() {
 	if(end()) return nullptr;
-	MapEntry & op=(*it).second;
-	return op.key.get();
+	return mapRef->data.getValue(position).key.get();
 }
 
 //! ---|> [Iterator]
 Object * Map::MapIterator::value() {
 	if(end()) return nullptr;
-	MapEntry & op=(*it).second;
-	return op.value.get();
+	return mapRef->data.getValue(position).value.get();
 }
 
 //! ---|> [Iterator]
 void Map::MapIterator::next() {
 	if(!end())
-		++it;
+		++position;
 }
 
 //! ---|> [Iterator]
 void Map::MapIterator::reset() {
-	it = mapRef->data.begin();
+	position = 0;
+	layoutVersion = mapRef->data.getLayoutVersion();
+	keyPosition = container_t::INVALID_POSITION;
 }
 
 //! ---|> [Iterator]
 bool Map::MapIterator::end() {
-	return it==mapRef->data.end();
+	updatePosition();
+	return position>=mapRef->data.getEndPosition();
 }
 
 //template<> Map* convertTo<Map*>(Runtime& runtime,ObjPtr src)		{	return assertType<Map>(runtime,src);	}
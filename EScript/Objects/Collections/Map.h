@@ -6,13 +6,18 @@
 #define MAP_H
 
 #include "Collection.h"
+#include "MapKey.h"
 #include "../Iterator.h"
+#include "../../Utils/OrderedHashTable.h"
 #include "../../Utils/StdFactories.h"
-#include <map>
 
 namespace EScript {
 
-//! [Map] ---|> [Collection] ---|> [Object]
+/*! [Map] ---|> [Collection] ---|> [Object]
+	Hash table whose keys are compared by their MapKey.
+	By default, the entries are iterated ordered by the string representation of their keys ("10" before "9");
+	they are sorted when they are iterated after new keys have been added out of order.
+	An insertion ordered Map keeps the order in which the keys have been added.	*/
 class Map : public Collection {
 		ES_PROVIDES_TYPE_NAME(Map)
 
@@ -36,18 +41,10 @@ class Map : public Collection {
 			ObjRef key;
 			ObjRef value;
 		};
-		typedef std::map<std::string,MapEntry>	container_t;
-		typedef container_t::iterator			iterator;
-		typedef container_t::pointer			pointer;
-		typedef container_t::const_pointer		const_pointer;
-		typedef container_t::const_iterator		const_iterator;
-		typedef container_t::reference			reference;
-		typedef container_t::const_reference	const_reference;
-		typedef container_t::size_type			size_type;
-
-		typedef std::ptrdiff_t							difference_type;
-		typedef std::reverse_iterator<iterator>			reverse_iterator;
-		typedef std::reverse_iterator<const_iterator>	const_reverse_iterator;
+		typedef OrderedHashTable<MapKey,MapEntry>	container_t;
+		typedef container_t::iterator				iterator;
+		typedef container_t::const_iterator			const_iterator;
+		typedef container_t::size_type				size_type;
 	//	@}
 
 	//---------------------
@@ -66,7 +63,7 @@ class Map : public Collection {
 			return eM.detachAndDecrease();
 		}
 		// ---
-		Map(Type * type = nullptr) : Collection(type?type:getTypeObject()){}
+		Map(Type * type = nullptr) : Collection(type?type:getTypeObject()),insertionOrdered(false),sorted(true),numIterators(0){}
 		virtual ~Map(){}
 	//	@}
 
@@ -83,27 +80,41 @@ class Map : public Collection {
 
 	//! @name Data
 	// @{
-	private:
+	protected:
 		container_t data;
+	private:
+		bool insertionOrdered;
+		bool sorted; //!< true if the entries are known to be ordered by isKeyLess(...)
+		size_t numIterators; //!< while MapIterators exist, the entries are not compacted
+	protected:
+		//! Bring the entries into the iteration order (if necessary); called before the entries are iterated.
+		void updateOrder();
+		//! ---o The order of the keys (if the map is not insertion ordered): by their string representations.
+		virtual bool isKeyLess(const MapKey & a,const MapKey & b)const	{	return a.isRepresentationLess(b);	}
+		/*! Position of the entry with the given key. If there is none, the position of the first entry
+			whose key follows the given key (or the end position, if the map is insertion ordered).	*/
+		size_t findPosition(const MapKey & key)const;
 	public:
-		container_t & operator*()				{	return data;	}
+		//! The entries in iteration order.
+		container_t & operator*()				{	updateOrder(); return data;	}
+		//! The entries in their current order (which may not be the iteration order).
 		const container_t & operator*()const	{	return data;	}
 
-		iterator begin()						{	return data.begin(); }
+		iterator begin()						{	updateOrder(); return data.begin(); }
 		const_iterator begin()const				{	return data.begin(); }
 		iterator end()							{	return data.end(); }
 		const_iterator end()const				{	return data.end(); }
-		reverse_iterator rbegin()				{	return data.rbegin(); }
-		const_reverse_iterator rbegin()const	{	return data.rbegin(); }
-		reverse_iterator rend()					{	return data.rend(); }
-		const_reverse_iterator rend()const		{	return data.rend(); }
 
 		bool empty()const						{	return data.empty();	}
-		size_type erase(const std::string & key){	return data.erase(key);	}
+		size_type erase(const std::string & key){	return data.erase(MapKey(key),numIterators==0) ? 1 : 0;	}
 		Object * getValue(const std::string & key);
+		Object * getValue(const MapKey & key);
 		Object * getKeyObject(const std::string & key);
+		bool isInsertionOrdered()const			{	return insertionOrdered;	}
 		void merge(Collection * c,bool overwrite = true);
 		void rt_filter(Runtime & runtime,ObjPtr function, const ParameterValues & additionalValues);
+		//! If @p b is true, the entries are iterated in insertion order; the current order is kept.
+		void setInsertionOrdered(bool b);
 		void unset(ObjPtr key);
 		void swap(Map * other);
 	//	@}
@@ -112,12 +123,14 @@ class Map : public Collection {
 
 	//! @name ---|> [Collection]
 	// @{
-		//!	[MapIterator] ---|> [Iterator]
+		/*!	[MapIterator] ---|> [Iterator]
+			The iterator remembers the key of its current entry. If the map's entries are reordered
+			(e.g. sorted by another iterator), the iteration continues at that key.	*/
 		class MapIterator : public Iterator {
 				ES_PROVIDES_TYPE_NAME(MapIterator)
 			public:
 				MapIterator(Map * ar);
-				virtual ~MapIterator() { }
+				virtual ~MapIterator();
 
 				//! ---|> [Iterator]
 				virtual Object * key();
@@ -128,7 +141,11 @@ class Map : public Collection {
 
 			private:
 				ERef<Map> mapRef;
-				container_t::iterator it;
+				size_t position;
+				size_t layoutVersion;
+				size_t keyPosition; //!< position of currentKey when it was stored (or INVALID_POSITION)
+				MapKey currentKey;
+				void updatePosition();
 		};
 		virtual void clear();
 		virtual size_t count()const;
@@ -142,6 +159,7 @@ class Map : public Collection {
 	//! @name ---|> [Object]
 	// @{
 		Object * clone()const;
+		virtual internalTypeId_t _getInternalTypeId()const	{	return _TypeIds::TYPE_MAP;	}
 	//	@}
 
 	//---------------------
@@ -0,0 +1,171 @@
+// MapKey.cpp
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#include "MapKey.h"
+#include "../Identifier.h"
+#include "../Values/Number.h"
+#include "../Values/String.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace EScript{
+
+//! Integral Numbers up to this limit are integer keys (they can be represented exactly as double).
+static const double MAX_INTEGER_KEY = 1.0e15;
+static const size_t MAX_INTEGER_KEY_DIGITS = 15;
+
+//! (internal) Mix the bits of an integer (finalizer of splitmix64).
+static size_t mixBits(uint64_t x){
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+	return static_cast<size_t>(x);
+}
+
+/*! (internal) Returns true iff @p s is an integer in canonical form (no '+', no leading zeros, no "-0")
+	with at most MAX_INTEGER_KEY_DIGITS digits.	*/
+static bool parseCanonicalInteger(const std::string & s, int64_t & value){
+	const size_t length = s.length();
+	if(length==0 || length>MAX_INTEGER_KEY_DIGITS+1)
+		return false;
+	size_t cursor = 0;
+	const bool negative = s[0]=='-';
+	if(negative)
+		++cursor;
+	const size_t numDigits = length-cursor;
+	if(numDigits==0 || numDigits>MAX_INTEGER_KEY_DIGITS || (s[cursor]=='0' && (numDigits>1 || negative)) )
+		return false;
+	int64_t v = 0;
+	for(; cursor<length; ++cursor){
+		const char c = s[cursor];
+		if(c<'0' || c>'9')
+			return false;
+		v = v*10 + (c-'0');
+	}
+	value = negative ? -v : v;
+	return true;
+}
+
+/*! (internal) Write the decimal representation of @p value into the buffer ending at @p end;
+	returns the position of the first character.	*/
+static char * formatInteger(int64_t value, char * end){
+	uint64_t v = value<0 ? static_cast<uint64_t>(-value) : static_cast<uint64_t>(value);
+	char * cursor = end;
+	do{
+		*--cursor = static_cast<char>('0' + v%10);
+		v /= 10;
+	}while(v!=0);
+	if(value<0)
+		*--cursor = '-';
+	return cursor;
+}
+
+MapKey::MapKey(double value) : type(INTEGER),intValue(0){
+	if(std::abs(value)<MAX_INTEGER_KEY && value==std::floor(value)){
+		intValue = static_cast<int64_t>(value); // -0.0 becomes 0
+	}else{ // same key as the Number's string representation (see Number::toString())
+		std::ostringstream sprinter;
+		sprinter << value;
+		initString(StringData(sprinter.str()));
+	}
+}
+
+MapKey::MapKey(const ObjPtr & obj) : type(INTEGER),intValue(0){
+	if(obj.isNull()){
+		initString(StringData());
+		return;
+	}
+	switch(obj->_getInternalTypeId()){
+		case _TypeIds::TYPE_NUMBER:
+			*this = MapKey(static_cast<const Number*>(obj.get())->getValue());
+			break;
+		case _TypeIds::TYPE_STRING:
+			initString(static_cast<const String*>(obj.get())->getStringData());
+			break;
+		case _TypeIds::TYPE_IDENTIFIER:
+			initString(StringData(static_cast<const Identifier*>(obj.get())->getId().toString()));
+			break;
+		default:
+			initString(StringData(obj->toString()));
+	}
+}
+
+MapKey::MapKey(const std::string & s) : type(INTEGER),intValue(0){
+	if(!parseCanonicalInteger(s,intValue)){
+		type = STRING;
+		stringValue = StringData(s);
+	}
+}
+
+MapKey::MapKey(const StringData & s) : type(INTEGER),intValue(0){
+	initString(s);
+}
+
+//! (internal)
+void MapKey::initString(const StringData & s){
+	if(parseCanonicalInteger(s.str(),intValue)){
+		type = INTEGER;
+	}else{
+		type = STRING;
+		stringValue = s;
+	}
+}
+
+size_t MapKey::getHash()const{
+	switch(type){
+		case INTEGER:
+			return mixBits(static_cast<uint64_t>(intValue));
+		case STRING:
+		default:
+			return stringValue.getHash();
+	}
+}
+
+bool MapKey::operator==(const MapKey & other)const{
+	if(type!=other.type)
+		return false;
+	switch(type){
+		case INTEGER:
+			return intValue==other.intValue;
+		case STRING:
+		default:
+			return stringValue==other.stringValue;
+	}
+}
+
+bool MapKey::operator<(const MapKey & other)const{
+	if(type!=other.type)
+		return type==INTEGER;
+	return type==INTEGER ? intValue<other.intValue : stringValue.str()<other.stringValue.str();
+}
+
+//! (internal)
+void MapKey::getRepresentation(char (&buffer)[24], const char * & begin, const char * & end)const{
+	if(type==INTEGER){
+		end = buffer+sizeof(buffer);
+		begin = formatInteger(intValue,buffer+sizeof(buffer));
+	}else{
+		begin = stringValue.str().data();
+		end = begin+stringValue.getDataSize();
+	}
+}
+
+bool MapKey::isRepresentationLess(const MapKey & other)const{
+	if(type==STRING && other.type==STRING)
+		return stringValue.str()<other.stringValue.str();
+	char buffer1[24], buffer2[24];
+	const char *begin1, *end1, *begin2, *end2;
+	getRepresentation(buffer1,begin1,end1);
+	other.getRepresentation(buffer2,begin2,end2);
+	// compare like std::string (bytes as unsigned char)
+	return std::lexicographical_compare(begin1,end1,begin2,end2,[](char c1,char c2){
+		return static_cast<unsigned char>(c1)<static_cast<unsigned char>(c2);
+	});
+}
+
+}
@@ -0,0 +1,61 @@
+// MapKey.h
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifndef ES_MAPKEY_H
+#define ES_MAPKEY_H
+
+#include "../../Utils/ObjRef.h"
+#include "../../Utils/StringData.h"
+#include <cstdint>
+#include <string>
+
+namespace EScript {
+
+/*! [MapKey]
+	Normalized key of a Map entry. Two key objects address the same entry iff their MapKeys are equal:
+	- Numbers with an integral value (|value| < 10^15) and Strings containing such a number in its canonical
+		form ("42","-7") are integer keys. (1 and "1" address the same entry.)
+	- All other objects are compared by their string representation (Identifiers by their name);
+		so 0.5 and "0.5" address the same entry.
+	\note Older versions keyed all Numbers by their (6 digit) string representation; there, 1000000 addressed
+		the same entry as "1e+06" (and 1000001). Now it addresses the same entry as "1000000".
+	The hash value of an integer key is calculated from its value (without creating its string representation);
+	the hash value of a String is cached by its StringData.	*/
+class MapKey{
+	public:
+		enum type_t : uint8_t{
+			INTEGER,
+			STRING
+		};
+
+		MapKey() : type(INTEGER),intValue(0){}
+		explicit MapKey(const ObjPtr & obj);
+		explicit MapKey(const std::string & s);
+		explicit MapKey(const StringData & s);
+		explicit MapKey(double value);
+
+		type_t getType()const						{	return type;	}
+		size_t getHash()const;
+
+		bool operator==(const MapKey & other)const;
+		bool operator!=(const MapKey & other)const	{	return !(*this==other);	}
+
+		//! Ordering used by SortedMap: integer keys (by value) before all other keys (lexicographically).
+		bool operator<(const MapKey & other)const;
+
+		//! Ordering of the keys' string representations (e.g. "10" < "9"); used for the default iteration order of a Map.
+		bool isRepresentationLess(const MapKey & other)const;
+
+	private:
+		void initString(const StringData & s);
+		//! Set [begin,end) to the string representation; the representation of an integer key is written into @p buffer.
+		void getRepresentation(char (&buffer)[24], const char * & begin, const char * & end)const;
+
+		type_t type;
+		int64_t intValue; //!< only used for INTEGER keys
+		StringData stringValue; //!< only used for STRING keys
+};
+
+}
+#endif // ES_MAPKEY_H
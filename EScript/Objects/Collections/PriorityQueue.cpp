@@ -0,0 +1,263 @@
+// PriorityQueue.cpp
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#include "PriorityQueue.h"
+#include "../../Basics.h"
+#include "../../StdObjects.h"
+#include "../../Consts.h"
+
+namespace EScript{
+
+//! (static)
+Type * PriorityQueue::getTypeObject(){
+	static Type * typeObject = new Type(Object::getTypeObject()); // ---|> Object
+	return typeObject;
+}
+
+//! (static)
+Type * PriorityQueue::Handle::getTypeObject(){
+	static Type * typeObject = new Type(Object::getTypeObject()); // ---|> Object
+	return typeObject;
+}
+
+//! (static,internal)
+static PriorityQueue::Handle * assertHandle(Runtime & rt,PriorityQueue * queue,const ObjPtr & obj){
+	PriorityQueue::Handle * handle = assertType<PriorityQueue::Handle>(rt,obj);
+	if(handle->isValid() && handle->getQueue()!=queue){
+		rt.setException("PriorityQueue: The handle belongs to another queue.");
+		return nullptr;
+	}
+	return handle;
+}
+
+//! initMembers
+void PriorityQueue::init(EScript::Namespace & globals) {
+	Type * typeObject = getTypeObject();
+	typeObject->allowUserInheritance(true); // Std.PriorityQueue used to be a user defined type
+	initPrintableName(typeObject,getClassName());
+
+	declareConstant(&globals,getClassName(),typeObject);
+
+	/*! [ESMF] PriorityQueue new PriorityQueue( [compareFunction] [,Collection values] )
+		PriorityQueue new PriorityQueue( Collection values )
+		compareFunction(a,b) returns true iff a is to be extracted before b; the default is 'a<b'.	*/
+	ES_CONSTRUCTOR(typeObject,0,2, {
+		ObjPtr compareFunction = parameter[0];
+		ObjPtr values = parameter[1];
+		if(parameter[0].toType<Collection>()){
+			values = parameter[0];
+			compareFunction = nullptr;
+		}else if(!compareFunction.toBool()){ // void
+			compareFunction = nullptr;
+		}
+		ERef<PriorityQueue> q = new PriorityQueue(compareFunction,thisType);
+		if(!values.isNull())
+			q->rt_addAll(rt,assertType<Collection>(rt,values));
+		return q.detachAndDecrease();
+	})
+
+	//! [ESMF] thisObj PriorityQueue.add( value )
+	ES_MFUN(typeObject,PriorityQueue,"add",1,1,			(thisObj->rt_add(rt,parameter[0]),thisEObj))
+
+	//! [ESMF] thisObj PriorityQueue += value
+	ES_MFUN(typeObject,PriorityQueue,"+=",1,1,			(thisObj->rt_add(rt,parameter[0]),thisEObj))
+
+	//! [ESMF] thisObj PriorityQueue.addAll( Collection )
+	ES_MFUN(typeObject,PriorityQueue,"addAll",1,1,		(thisObj->rt_addAll(rt,assertType<Collection>(rt,parameter[0])),thisEObj))
+
+	//! [ESMF] PriorityQueue.Handle PriorityQueue.addWithHandle( value )
+	ES_MFUN(typeObject,PriorityQueue,"addWithHandle",1,1,	thisObj->rt_addWithHandle(rt,parameter[0]))
+
+	//! [ESMF] thisObj PriorityQueue.clear()
+	ES_MFUN(typeObject,PriorityQueue,"clear",0,0,		(thisObj->clear(),thisEObj))
+
+	//! [ESMF] Number PriorityQueue.count()
+	ES_MFUN(typeObject,const PriorityQueue,"count",0,0,	static_cast<uint32_t>(thisObj->count()))
+
+	//! [ESMF] Bool PriorityQueue.empty()
+	ES_MFUN(typeObject,const PriorityQueue,"empty",0,0,	thisObj->empty())
+
+	//! [ESMF] Object|void PriorityQueue.extract()
+	ES_MFUN(typeObject,PriorityQueue,"extract",0,0,		thisObj->rt_extract(rt))
+
+	//! [ESMF] Object|void PriorityQueue.get()
+	ES_MFUN(typeObject,const PriorityQueue,"get",0,0,	thisObj->get())
+
+	//! [ESMF] Object|void PriorityQueue.getCompareFunction()
+	ES_MFUN(typeObject,const PriorityQueue,"getCompareFunction",0,0,	thisObj->getCompareFunction())
+
+	//! [ESMF] Object|void PriorityQueue.remove( Handle )
+	ES_MFUNCTION(typeObject,PriorityQueue,"remove",1,1,{
+		Handle * handle = assertHandle(rt,thisObj,parameter[0]);
+		return handle ? thisObj->rt_remove(rt,handle) : nullptr;
+	})
+
+	/*! [ESMF] thisObj PriorityQueue.update( Handle [,newValue] )
+		Restore the order after the priority of the handle's element has changed (decrease-key).	*/
+	ES_MFUNCTION(typeObject,PriorityQueue,"update",1,2,{
+		Handle * handle = assertHandle(rt,thisObj,parameter[0]);
+		if(handle)
+			thisObj->rt_update(rt,handle,parameter[1]);
+		return thisEObj;
+	})
+
+	// ---
+	Type * handleType = Handle::getTypeObject();
+	initPrintableName(handleType,"PriorityQueue.Handle");
+	declareConstant(typeObject,"Handle",handleType);
+
+	//! [ESMF] Object|void PriorityQueue.Handle.getValue()
+	ES_MFUN(handleType,const Handle,"getValue",0,0,		thisObj->getValue())
+
+	//! [ESMF] Bool PriorityQueue.Handle.isValid()
+	ES_MFUN(handleType,const Handle,"isValid",0,0,		thisObj->isValid())
+}
+
+//---
+
+Object * PriorityQueue::Handle::getValue()const{
+	return queue ? queue->heap[position].value.get() : nullptr;
+}
+
+//! (dtor)
+PriorityQueue::~PriorityQueue(){
+	clear();
+}
+
+void PriorityQueue::clear(){
+	for(auto & entry : heap){
+		if(entry.handle.isNotNull())
+			entry.handle->queue = nullptr;
+	}
+	heap.clear();
+}
+
+//! (internal)
+bool PriorityQueue::rt_isBefore(Runtime & runtime,Object * a,Object * b){
+	if(compare.isNotNull())
+		return callFunction(runtime,compare.get(),ParameterValues(a,b)).toBool();
+	// fast path for the built-in types
+	if(a->getType()==Number::getTypeObject() && b->getType()==Number::getTypeObject())
+		return static_cast<const Number*>(a)->getValue() < static_cast<const Number*>(b)->getValue();
+	if(a->getType()==String::getTypeObject() && b->getType()==String::getTypeObject())
+		return static_cast<const String*>(a)->getString() < static_cast<const String*>(b)->getString();
+	return callMemberFunction(runtime,a,Consts::IDENTIFIER_fn_less,ParameterValues(b)).toBool();
+}
+
+//! (internal)
+void PriorityQueue::setEntry(size_t pos,Entry && entry){
+	heap[pos] = std::move(entry);
+	if(heap[pos].handle.isNotNull())
+		heap[pos].handle->position = pos;
+}
+
+//! (internal) Returns the new position of the entry.
+size_t PriorityQueue::rt_siftUp(Runtime & runtime,size_t pos){
+	Entry entry = std::move(heap[pos]);
+	while(pos>0){
+		const size_t parent = (pos-1)/2;
+		if(!rt_isBefore(runtime,entry.value.get(),heap[parent].value.get()))
+			break;
+		setEntry(pos,std::move(heap[parent]));
+		pos = parent;
+	}
+	setEntry(pos,std::move(entry));
+	return pos;
+}
+
+//! (internal) Returns the new position of the entry.
+size_t PriorityQueue::rt_siftDown(Runtime & runtime,size_t pos){
+	const size_t size = heap.size();
+	Entry entry = std::move(heap[pos]);
+	while(true){
+		size_t child = pos*2+1;
+		if(child>=size)
+			break;
+		if(child+1<size && rt_isBefore(runtime,heap[child+1].value.get(),heap[child].value.get()))
+			++child;
+		if(!runtime.checkNormalState() || !rt_isBefore(runtime,heap[child].value.get(),entry.value.get()))
+			break;
+		setEntry(pos,std::move(heap[child]));
+		pos = child;
+	}
+	setEntry(pos,std::move(entry));
+	return pos;
+}
+
+void PriorityQueue::rt_add(Runtime & runtime,ObjPtr value){
+	heap.emplace_back(value,nullptr);
+	rt_siftUp(runtime,heap.size()-1);
+}
+
+PriorityQueue::Handle * PriorityQueue::rt_addWithHandle(Runtime & runtime,ObjPtr value){
+	Handle * handle = new Handle;
+	handle->queue = this;
+	heap.emplace_back(value,handle);
+	rt_siftUp(runtime,heap.size()-1);
+	return handle;
+}
+
+void PriorityQueue::rt_addAll(Runtime & runtime,Collection * c){
+	ERef<Iterator> iRef = c->getIterator();
+	if(iRef.isNull())
+		return;
+	const size_t oldSize = heap.size();
+	for( ; !iRef->end(); iRef->next())
+		heap.emplace_back(iRef->value(),nullptr);
+	if(heap.size()-oldSize > oldSize){ // rebuilding the heap is cheaper than adding the values one by one
+		rt_heapify(runtime);
+	}else{
+		for(size_t pos = oldSize; pos<heap.size() && runtime.checkNormalState(); ++pos)
+			rt_siftUp(runtime,pos);
+	}
+}
+
+void PriorityQueue::rt_heapify(Runtime & runtime){
+	for(size_t pos = heap.size()/2; pos>0 && runtime.checkNormalState(); --pos)
+		rt_siftDown(runtime,pos-1);
+}
+
+//! (internal)
+Object * PriorityQueue::rt_removeAt(Runtime & runtime,size_t pos){
+	ObjRef value = std::move(heap[pos].value);
+	if(heap[pos].handle.isNotNull())
+		heap[pos].handle->queue = nullptr;
+	Entry last = std::move(heap.back());
+	heap.pop_back();
+	if(pos<heap.size()){
+		setEntry(pos,std::move(last));
+		if(rt_siftDown(runtime,pos)==pos)
+			rt_siftUp(runtime,pos);
+	}
+	return value.detachAndDecrease();
+}
+
+Object * PriorityQueue::rt_extract(Runtime & runtime){
+	return heap.empty() ? nullptr : rt_removeAt(runtime,0);
+}
+
+Object * PriorityQueue::rt_remove(Runtime & runtime,Handle * handle){
+	return handle->queue==this ? rt_removeAt(runtime,handle->position) : nullptr;
+}
+
+void PriorityQueue::rt_update(Runtime & runtime,Handle * handle,ObjPtr newValue){
+	if(handle->queue!=this)
+		return;
+	const size_t pos = handle->position;
+	if(newValue.isNotNull())
+		heap[pos].value = newValue;
+	if(rt_siftUp(runtime,pos)==pos)
+		rt_siftDown(runtime,pos);
+}
+
+//! ---|> [Object]
+Object * PriorityQueue::clone()const{
+	PriorityQueue * q = new PriorityQueue(compare,getType());
+	q->heap.reserve(heap.size());
+	for(const auto & entry : heap) // the handles are not cloned
+		q->heap.emplace_back(entry.value->getRefOrCopy(),nullptr);
+	return q;
+}
+
+}
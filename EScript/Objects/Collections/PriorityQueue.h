@@ -0,0 +1,112 @@
+// PriorityQueue.h
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifndef ES_PRIORITYQUEUE_H
+#define ES_PRIORITYQUEUE_H
+
+#include "../Object.h"
+#include <vector>
+
+namespace EScript {
+class Collection;
+
+/*! [PriorityQueue] ---|> [Object]
+	Binary heap. The element for which compare(element,other) holds for all other elements is extracted first.
+	- Without a compare function, the elements are compared by 'a<b'. If both elements are Numbers
+		or both are Strings, the comparison is done natively without calling the '<' member function.
+	- Adding and extracting an element is done in O(log n); adding a collection of values to a
+		(relatively) small queue rebuilds the heap in O(n).
+	- An element added with addWithHandle(...) can be updated (e.g. decrease-key) or removed using its Handle.
+	\note The compare function must not modify the queue.	*/
+class PriorityQueue : public Object {
+		ES_PROVIDES_TYPE_NAME(PriorityQueue)
+
+	//! @name Types
+	// @{
+	public:
+		/*! [PriorityQueue.Handle] ---|> [Object]
+			Reference to an element of a PriorityQueue. The Handle becomes invalid when the element
+			is removed from the queue.	*/
+		class Handle : public Object {
+				ES_PROVIDES_TYPE_NAME(PriorityQueueHandle)
+			public:
+				static Type* getTypeObject();
+
+				Handle() : Object(getTypeObject()),queue(nullptr),position(0){}
+				virtual ~Handle(){}
+
+				PriorityQueue * getQueue()const		{	return queue;	}
+				Object * getValue()const;
+				bool isValid()const					{	return queue!=nullptr;	}
+			private:
+				friend class PriorityQueue;
+				PriorityQueue * queue;	//!< nullptr iff invalid
+				size_t position;		//!< position in the heap
+		};
+
+	private:
+		struct Entry{
+			ObjRef value;
+			ERef<Handle> handle;
+			Entry(ObjPtr _value,Handle * _handle) : value(_value),handle(_handle){}
+		};
+	//	@}
+
+	//! @name Creation
+	// @{
+	public:
+		PriorityQueue(ObjPtr compareFunction = nullptr,Type * type = nullptr) :
+				Object(type?type:getTypeObject()),compare(compareFunction){}
+		virtual ~PriorityQueue();
+	//	@}
+
+	//! @name TypeObject
+	// @{
+	public:
+		static Type* getTypeObject();
+		static void init(EScript::Namespace & globals);
+	//	@}
+
+	//! @name Data
+	// @{
+	private:
+		std::vector<Entry> heap;
+		ObjRef compare; //!< may be nullptr
+
+		bool rt_isBefore(Runtime & runtime,Object * a,Object * b);
+		size_t rt_siftUp(Runtime & runtime,size_t pos);
+		size_t rt_siftDown(Runtime & runtime,size_t pos);
+		void setEntry(size_t pos,Entry && entry);
+		//! Remove the entry at the given position.
+		Object * rt_removeAt(Runtime & runtime,size_t pos);
+	public:
+		Object * getCompareFunction()const		{	return compare.get();	}
+		size_t count()const						{	return heap.size();	}
+		bool empty()const						{	return heap.empty();	}
+		void clear();
+		//! Returns the first element (or nullptr if empty).
+		Object * get()const						{	return heap.empty() ? nullptr : heap.front().value.get();	}
+
+		void rt_add(Runtime & runtime,ObjPtr value);
+		Handle * rt_addWithHandle(Runtime & runtime,ObjPtr value);
+		//! Add all values of the collection.
+		void rt_addAll(Runtime & runtime,Collection * c);
+		//! Remove and return the first element (or nullptr if empty).
+		Object * rt_extract(Runtime & runtime);
+		//! Remove the handle's element from the queue. Returns the element (or nullptr if the handle is invalid).
+		Object * rt_remove(Runtime & runtime,Handle * handle);
+		//! Restore the order after the priority of the handle's element has changed (optionally setting a new value).
+		void rt_update(Runtime & runtime,Handle * handle,ObjPtr newValue = nullptr);
+		//! Rebuild the heap in O(n).
+		void rt_heapify(Runtime & runtime);
+	//	@}
+
+	//! @name ---|> [Object]
+	// @{
+		virtual Object * clone()const;
+	//	@}
+};
+}
+
+#endif // ES_PRIORITYQUEUE_H
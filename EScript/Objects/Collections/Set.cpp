@@ -0,0 +1,246 @@
+// Set.cpp
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#include "Set.h"
+#include "../../Basics.h"
+#include "../../StdObjects.h"
+
+namespace EScript{
+
+//! (static)
+Type * Set::getTypeObject(){
+	static Type * typeObject = new Type(Collection::getTypeObject()); // ---|> Collection
+	return typeObject;
+}
+
+//! initMembers
+void Set::init(EScript::Namespace & globals) {
+	Type * typeObject = getTypeObject();
+	typeObject->allowUserInheritance(true); // Std.Set used to be a user defined type
+	initPrintableName(typeObject,getClassName());
+
+	declareConstant(&globals,getClassName(),typeObject);
+
+	//! [ESMF] Set new Set( [value*] )
+	ES_CONSTRUCTOR(typeObject,0,-1, {
+		Set * s = new Set(thisType);
+		s->data.reserve(parameter.count());
+		for(const auto & value : parameter)
+			s->add(value);
+		return s;
+	})
+
+	//! [ESMF] thisObj Set.add( value )
+	ES_MFUN(typeObject,Set,"add",1,1,			(thisObj->add(parameter[0]),thisEObj))
+
+	//! [ESMF] thisObj Set += value
+	ES_MFUN(typeObject,Set,"+=",1,1,			(thisObj->add(parameter[0]),thisEObj))
+
+	//! [ESMF] Set Set.getIntersection( Collection )
+	ES_MFUNCTION(typeObject,const Set,"getIntersection",1,1,{
+		Set * result = static_cast<Set*>(thisObj->clone());
+		result->intersect(assertType<Collection>(rt,parameter[0]));
+		return result;
+	})
+
+	//! [ESMF] Set Set & Collection
+	ES_MFUNCTION(typeObject,const Set,"&",1,1,{
+		Set * result = static_cast<Set*>(thisObj->clone());
+		result->intersect(assertType<Collection>(rt,parameter[0]));
+		return result;
+	})
+
+	//! [ESMF] Set Set.getMerged( Collection )
+	ES_MFUNCTION(typeObject,const Set,"getMerged",1,1,{
+		Set * result = static_cast<Set*>(thisObj->clone());
+		result->merge(assertType<Collection>(rt,parameter[0]));
+		return result;
+	})
+
+	//! [ESMF] Set Set | Collection
+	ES_MFUNCTION(typeObject,const Set,"|",1,1,{
+		Set * result = static_cast<Set*>(thisObj->clone());
+		result->merge(assertType<Collection>(rt,parameter[0]));
+		return result;
+	})
+
+	//! [ESMF] Set Set.getSubstracted( Collection )
+	ES_MFUNCTION(typeObject,const Set,"getSubstracted",1,1,{
+		Set * result = static_cast<Set*>(thisObj->clone());
+		result->substract(assertType<Collection>(rt,parameter[0]));
+		return result;
+	})
+
+	//! [ESMF] thisObj Set.intersect( Collection )
+	ES_MFUN(typeObject,Set,"intersect",1,1,		(thisObj->intersect(assertType<Collection>(rt,parameter[0])),thisEObj))
+
+	//! [ESMF] thisObj Set &= Collection
+	ES_MFUN(typeObject,Set,"&=",1,1,			(thisObj->intersect(assertType<Collection>(rt,parameter[0])),thisEObj))
+
+	//! [ESMF] thisObj Set.merge( Collection )
+	ES_MFUN(typeObject,Set,"merge",1,1,			(thisObj->merge(assertType<Collection>(rt,parameter[0])),thisEObj))
+
+	//! [ESMF] thisObj Set |= Collection
+	ES_MFUN(typeObject,Set,"|=",1,1,			(thisObj->merge(assertType<Collection>(rt,parameter[0])),thisEObj))
+
+	//! [ESMF] thisObj Set.remove( value )
+	ES_MFUN(typeObject,Set,"remove",1,1,		(thisObj->remove(parameter[0]),thisEObj))
+
+	//! [ESMF] thisObj Set -= value
+	ES_MFUN(typeObject,Set,"-=",1,1,			(thisObj->remove(parameter[0]),thisEObj))
+
+	//! [ESMF] thisObj Set.substract( Collection )
+	ES_MFUN(typeObject,Set,"substract",1,1,		(thisObj->substract(assertType<Collection>(rt,parameter[0])),thisEObj))
+
+	//! [ESMF] thisObj Set.swap( Set other )
+	ES_MFUN(typeObject,Set,"swap",1,1,			(thisObj->swap(assertType<Set>(rt,parameter[0])),thisEObj))
+
+	//! [ESMF] Array Set.toArray()
+	ES_MFUN(typeObject,const Set,"toArray",0,0,	thisObj->toArray())
+}
+
+//---
+
+void Set::add(ObjPtr value){
+	if(value.isNull())
+		return;
+	ObjRef & element = *data.insert(MapKey(value)).first;
+	if(element.isNull())
+		element = value;
+}
+
+bool Set::contains(ObjPtr value)const{
+	return !value.isNull() && data.find(MapKey(value))!=container_t::INVALID_POSITION;
+}
+
+void Set::remove(ObjPtr value){
+	if(!value.isNull())
+		data.erase(MapKey(value));
+}
+
+Array * Set::toArray()const{
+	Array * a = Array::create();
+	a->reserve(data.size());
+	for(const auto & element : data)
+		a->pushBack(element);
+	return a;
+}
+
+void Set::merge(Collection * c){
+	if(!c)
+		return;
+	Set * other = dynamic_cast<Set*>(c);
+	if(other){ // fast path: reuse the keys of the other set
+		if(other==this)
+			return;
+		data.reserve(data.size()+other->data.size());
+		for(auto it = other->data.begin(); it!=other->data.end(); ++it){
+			ObjRef & element = *data.insert(it.key()).first;
+			if(element.isNull())
+				element = (*it)->getRefOrCopy();
+		}
+		return;
+	}
+	for(ERef<Iterator> iRef = c->getIterator(); !iRef.isNull() && !iRef->end(); iRef->next())
+		add(iRef->value()->getRefOrCopy());
+}
+
+void Set::intersect(Collection * c){
+	if(!c){
+		clear();
+		return;
+	}
+	ERef<Set> otherRef = dynamic_cast<Set*>(c);
+	if(otherRef.get()==this)
+		return;
+	if(otherRef.isNull()){
+		otherRef = new Set;
+		otherRef->merge(c);
+	}
+	container_t result;
+	for(auto it = data.begin(); it!=data.end(); ++it){
+		if(otherRef->data.find(it.key())!=container_t::INVALID_POSITION)
+			*result.insert(it.key()).first = *it;
+	}
+	data.swap(result);
+}
+
+void Set::substract(Collection * c){
+	if(!c)
+		return;
+	Set * other = dynamic_cast<Set*>(c);
+	if(other){ // fast path: reuse the keys of the other set
+		if(other==this){
+			clear();
+			return;
+		}
+		for(auto it = other->data.begin(); it!=other->data.end() && !data.empty(); ++it)
+			data.erase(it.key());
+		return;
+	}
+	for(ERef<Iterator> iRef = c->getIterator(); !iRef.isNull() && !iRef->end(); iRef->next())
+		remove(iRef->value());
+}
+
+//! ---|> Collection
+Object * Set::getValue(ObjPtr key){
+	if(key.isNull())
+		return nullptr;
+	const ObjRef * element = data.findValue(MapKey(key));
+	return element ? element->get() : nullptr;
+}
+
+//! ---|> Collection
+void Set::setValue(ObjPtr /*key*/,ObjPtr value){
+	add(value);
+}
+
+//! ---|> Collection
+bool Set::rt_contains(Runtime &,ObjPtr value){
+	return contains(value);
+}
+
+//! ---|> [Object]
+Object * Set::clone()const{
+	Set * newSet = new Set(getType());
+	newSet->data.reserve(data.size());
+	for(auto it = data.begin(); it!=data.end(); ++it)
+		*newSet->data.insert(it.key()).first = (*it)->getRefOrCopy();
+	return newSet;
+}
+
+//! ---|> [Object]
+bool Set::rt_isEqual(Runtime &,const ObjPtr & other){
+	Set * otherSet = other.toType<Set>();
+	if(!otherSet || otherSet->count()!=count())
+		return false;
+	for(auto it = data.begin(); it!=data.end(); ++it){
+		if(otherSet->data.find(it.key())==container_t::INVALID_POSITION)
+			return false;
+	}
+	return true;
+}
+
+// ------- SetIterator
+
+//! ---|> [Iterator]
+Object * Set::SetIterator::value(){
+	if(end()) return nullptr;
+	return setRef->data.getValue(position).get();
+}
+
+//! ---|> [Iterator]
+void Set::SetIterator::next(){
+	if(!end())
+		++position;
+}
+
+//! ---|> [Iterator]
+bool Set::SetIterator::end(){
+	// skip removed elements; the set may have been changed since the last call
+	position = setRef->data.getValidPosition(position);
+	return position>=setRef->data.getEndPosition();
+}
+
+}
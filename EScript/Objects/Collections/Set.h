@@ -0,0 +1,105 @@
+// Set.h
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifndef ES_SET_H
+#define ES_SET_H
+
+#include "Collection.h"
+#include "MapKey.h"
+#include "../Iterator.h"
+#include "../../Utils/OrderedHashTable.h"
+
+namespace EScript {
+class Array;
+
+/*! [Set] ---|> [Collection] ---|> [Object]
+	Hash set storing its elements in insertion order. Two objects are the same element iff their MapKeys
+	are equal (the same rules as for the keys of a Map; e.g. 1 and "1" are the same element).
+	As Collection, the elements are used as keys as well as values: set[value] returns the contained
+	element (or void) and set.set(key,value) adds the value.	*/
+class Set : public Collection {
+		ES_PROVIDES_TYPE_NAME(Set)
+
+	//! @name Types
+	// @{
+	public:
+		typedef OrderedHashTable<MapKey,ObjRef>	container_t;
+		typedef container_t::size_type			size_type;
+	//	@}
+
+	//! @name Creation
+	// @{
+	public:
+		static Set * create()					{	return new Set;	}
+		Set(Type * type = nullptr) : Collection(type?type:getTypeObject()){}
+		virtual ~Set(){}
+	//	@}
+
+	//! @name TypeObject
+	// @{
+	public:
+		static Type* getTypeObject();
+		static void init(EScript::Namespace & globals);
+	//	@}
+
+	//! @name Data
+	// @{
+	private:
+		container_t data;
+	public:
+		container_t & operator*()				{	return data;	}
+		const container_t & operator*()const	{	return data;	}
+
+		void add(ObjPtr value);
+		bool contains(ObjPtr value)const;
+		bool empty()const						{	return data.empty();	}
+		void remove(ObjPtr value);
+		void swap(Set * other)					{	data.swap(other->data);	}
+		Array * toArray()const;
+
+		//! Add all values of the collection (union).
+		void merge(Collection * c);
+		//! Remove all elements not contained in the collection (intersection).
+		void intersect(Collection * c);
+		//! Remove all values of the collection (difference).
+		void substract(Collection * c);
+	//	@}
+
+	//! @name ---|> [Collection]
+	// @{
+		//!	[SetIterator] ---|> [Iterator]
+		class SetIterator : public Iterator {
+				ES_PROVIDES_TYPE_NAME(SetIterator)
+			public:
+				SetIterator(Set * set) : Iterator(),setRef(set),position(0){}
+				virtual ~SetIterator() { }
+
+				//! ---|> [Iterator]
+				virtual Object * key()			{	return value();	}
+				virtual Object * value();
+				virtual void reset()			{	position = 0;	}
+				virtual void next();
+				virtual bool end();
+
+			private:
+				ERef<Set> setRef;
+				size_t position;
+		};
+		virtual void clear()					{	data.clear();	}
+		virtual size_t count()const				{	return data.size();	}
+		virtual SetIterator * getIterator()		{	return new SetIterator(this);	}
+		virtual Object * getValue(ObjPtr key);
+		virtual void setValue(ObjPtr key,ObjPtr value);
+		virtual bool rt_contains(Runtime & runtime,ObjPtr value);
+	//	@}
+
+	//! @name ---|> [Object]
+	// @{
+		Object * clone()const;
+		virtual bool rt_isEqual(Runtime & runtime,const ObjPtr & other);
+	//	@}
+};
+}
+
+#endif // ES_SET_H
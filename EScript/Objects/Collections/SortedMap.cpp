@@ -0,0 +1,45 @@
+// SortedMap.cpp
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#include "SortedMap.h"
+#include "../../Basics.h"
+
+namespace EScript{
+
+//! (static)
+Type * SortedMap::getTypeObject(){
+	static Type * typeObject = new Type(Map::getTypeObject()); // ---|> Map
+	return typeObject;
+}
+
+//! initMembers
+void SortedMap::init(EScript::Namespace & globals) {
+	Type * typeObject = getTypeObject();
+	initPrintableName(typeObject,getClassName());
+
+	declareConstant(&globals,getClassName(),typeObject);
+
+	//! [ESMF] SortedMap new SortedMap( [Map | [key,value]*] )
+	ES_CONSTRUCTOR(typeObject,0,-1, {
+		SortedMap * m = new SortedMap(thisType);
+		if(parameter.count()==1){
+			m->merge(assertType<Collection>(rt,parameter[0]));
+			return m;
+		}
+		if( (parameter.count()%2)==1 ) rt.warn("SortedMap: Last parameter ignored!");
+		for(ParameterValues::size_type i = 0;i+1<parameter.count();i+=2)
+			m->setValue(parameter[i],parameter[i+1]);
+		return m;
+	})
+}
+
+//! ---|> [Object]
+Object * SortedMap::clone()const{
+	SortedMap * newMap = new SortedMap(getType());
+	for(const auto & entry : data)
+		newMap->setValue(entry.key->getRefOrCopy(), entry.value->getRefOrCopy());
+	return newMap;
+}
+
+}
@@ -0,0 +1,47 @@
+// SortedMap.h
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifndef ES_SORTEDMAP_H
+#define ES_SORTEDMAP_H
+
+#include "Map.h"
+
+namespace EScript {
+
+/*! [SortedMap] ---|> [Map] ---|> [Collection] ---|> [Object]
+	Map whose entries are iterated ordered by their keys: integer keys (by value) before all other keys
+	(lexicographically by their string representation). The entries are sorted when they are iterated.	*/
+class SortedMap : public Map {
+		ES_PROVIDES_TYPE_NAME(SortedMap)
+
+	//! @name Creation
+	// @{
+	public:
+		static SortedMap * create()				{	return new SortedMap;	}
+		SortedMap(Type * type = nullptr) : Map(type?type:getTypeObject()){}
+		virtual ~SortedMap(){}
+	//	@}
+
+	//! @name TypeObject
+	// @{
+	public:
+		static Type* getTypeObject();
+		static void init(EScript::Namespace & globals);
+	//	@}
+
+	//! @name ---|> [Map]
+	// @{
+	protected:
+		virtual bool isKeyLess(const MapKey & a,const MapKey & b)const	{	return a<b;	}
+	//	@}
+
+	//! @name ---|> [Object]
+	// @{
+	public:
+		Object * clone()const;
+	//	@}
+};
+}
+
+#endif // ES_SORTEDMAP_H
@@ -0,0 +1,434 @@
+// TypedArray.cpp
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#include "TypedArray.h"
+#include "../../Basics.h"
+#include "../../StdObjects.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <type_traits>
+
+namespace EScript{
+
+template<> const char * TypedArray<double>::getClassName()		{	return "Float64Array";	}
+template<> const char * TypedArray<float>::getClassName()		{	return "Float32Array";	}
+template<> const char * TypedArray<int32_t>::getClassName()		{	return "Int32Array";	}
+template<> const char * TypedArray<uint8_t>::getClassName()		{	return "UInt8Array";	}
+
+// ------------------------------------------------------------------
+// kernels
+/* The loops work on raw pointers and use several independent partial results,
+	so that the compiler can vectorize them (a floating point sum can not be
+	vectorized if the additions have to be done in sequential order). */
+
+//! (internal) Type used to sum up values.
+template<typename value_t> struct SumType					{	typedef double type;	};
+template<> struct SumType<int32_t>							{	typedef int64_t type;	};
+template<> struct SumType<uint8_t>							{	typedef uint64_t type;	};
+
+static const size_t NUM_PARTIAL_RESULTS = 8;
+
+//! (internal)
+template<typename value_t>
+static typename SumType<value_t>::type sumKernel(const value_t * values,size_t n){
+	typedef typename SumType<value_t>::type sum_t;
+	sum_t partialSums[NUM_PARTIAL_RESULTS] = {};
+	size_t i = 0;
+	for(; i+NUM_PARTIAL_RESULTS<=n; i+=NUM_PARTIAL_RESULTS){
+		for(size_t j = 0; j<NUM_PARTIAL_RESULTS; ++j)
+			partialSums[j] += static_cast<sum_t>(values[i+j]);
+	}
+	sum_t sum = 0;
+	for(; i<n; ++i)
+		sum += static_cast<sum_t>(values[i]);
+	for(size_t j = 0; j<NUM_PARTIAL_RESULTS; ++j)
+		sum += partialSums[j];
+	return sum;
+}
+
+//! (internal)
+template<typename value_t>
+static double dotKernel(const value_t * a,const value_t * b,size_t n){
+	double partialSums[NUM_PARTIAL_RESULTS] = {};
+	size_t i = 0;
+	for(; i+NUM_PARTIAL_RESULTS<=n; i+=NUM_PARTIAL_RESULTS){
+		for(size_t j = 0; j<NUM_PARTIAL_RESULTS; ++j)
+			partialSums[j] += static_cast<double>(a[i+j]) * static_cast<double>(b[i+j]);
+	}
+	double sum = 0;
+	for(; i<n; ++i)
+		sum += static_cast<double>(a[i]) * static_cast<double>(b[i]);
+	for(size_t j = 0; j<NUM_PARTIAL_RESULTS; ++j)
+		sum += partialSums[j];
+	return sum;
+}
+
+//! (internal) n>0
+template<typename value_t>
+static void minMaxKernel(const value_t * values,size_t n,value_t & minValue,value_t & maxValue){
+	value_t partialMin[NUM_PARTIAL_RESULTS];
+	value_t partialMax[NUM_PARTIAL_RESULTS];
+	std::fill(partialMin,partialMin+NUM_PARTIAL_RESULTS,values[0]);
+	std::fill(partialMax,partialMax+NUM_PARTIAL_RESULTS,values[0]);
+	size_t i = 0;
+	for(; i+NUM_PARTIAL_RESULTS<=n; i+=NUM_PARTIAL_RESULTS){
+		for(size_t j = 0; j<NUM_PARTIAL_RESULTS; ++j){
+			const value_t v = values[i+j];
+			partialMin[j] = v<partialMin[j] ? v : partialMin[j];
+			partialMax[j] = v>partialMax[j] ? v : partialMax[j];
+		}
+	}
+	for(; i<n; ++i){
+		partialMin[0] = values[i]<partialMin[0] ? values[i] : partialMin[0];
+		partialMax[0] = values[i]>partialMax[0] ? values[i] : partialMax[0];
+	}
+	minValue = *std::min_element(partialMin,partialMin+NUM_PARTIAL_RESULTS);
+	maxValue = *std::max_element(partialMax,partialMax+NUM_PARTIAL_RESULTS);
+}
+
+//! (internal) Integers wrap around on overflow.
+template<typename value_t>
+static inline value_t addValues(value_t a,value_t b,std::true_type /*isFloatingPoint*/){
+	return a+b;
+}
+template<typename value_t>
+static inline value_t addValues(value_t a,value_t b,std::false_type /*isFloatingPoint*/){
+	typedef typename std::make_unsigned<value_t>::type unsigned_t;
+	return static_cast<value_t>(static_cast<unsigned_t>(a)+static_cast<unsigned_t>(b));
+}
+
+//! (internal) a[i] += b[i]
+template<typename value_t>
+static void addKernel(value_t * a,const value_t * b,size_t n){
+	for(size_t i = 0; i<n; ++i)
+		a[i] = addValues(a[i],b[i],typename std::is_floating_point<value_t>::type());
+}
+
+//! (internal) a[i] += value
+template<typename value_t>
+static void addKernel(value_t * a,value_t value,size_t n){
+	for(size_t i = 0; i<n; ++i)
+		a[i] = addValues(a[i],value,typename std::is_floating_point<value_t>::type());
+}
+
+//! (internal)
+template<typename value_t>
+static void scaleKernel(value_t * values,double factor,size_t n,std::true_type /*isFloatingPoint*/){
+	for(size_t i = 0; i<n; ++i)
+		values[i] = static_cast<value_t>(values[i]*factor);
+}
+template<typename value_t>
+static void scaleKernel(value_t * values,double factor,size_t n,std::false_type /*isFloatingPoint*/){
+	for(size_t i = 0; i<n; ++i)
+		values[i] = TypedArray<value_t>::convert(values[i]*factor);
+}
+
+//! (internal)
+template<typename value_t>
+static value_t convertValue(double d,std::true_type /*isFloatingPoint*/){
+	return static_cast<value_t>(d);
+}
+template<typename value_t>
+static value_t convertValue(double d,std::false_type /*isFloatingPoint*/){
+	if(!std::isfinite(d))
+		return 0;
+	static const double limit = 9.2e18; // < 2^63
+	const int64_t i = static_cast<int64_t>(d<-limit ? -limit : (d>limit ? limit : d));
+	return static_cast<value_t>(static_cast<typename std::make_unsigned<value_t>::type>(i));
+}
+
+// ------------------------------------------------------------------
+
+//! (static)
+template<typename value_t>
+Type * TypedArray<value_t>::getTypeObject(){
+	static Type * typeObject = new Type(Collection::getTypeObject()); // ---|> Collection
+	return typeObject;
+}
+
+//! (static) initMembers
+template<typename value_t>
+void TypedArray<value_t>::init(EScript::Namespace & globals) {
+	typedef TypedArray<value_t> TypedArray_t;
+	Type * typeObject = getTypeObject();
+	initPrintableName(typeObject,getClassName());
+
+	declareConstant(&globals,getClassName(),typeObject);
+
+	//! [ESMF] TypedArray new TypedArray( [Number size | Collection values] )
+	ES_CONSTRUCTOR(typeObject,0,1, {
+		if(parameter.count()==0)
+			return new TypedArray_t(0,thisType);
+		Collection * c = parameter[0].toType<Collection>();
+		if(c){
+			ERef<TypedArray_t> a = new TypedArray_t(0,thisType);
+			a->append(c);
+			return a.detachAndDecrease();
+		}
+		return new TypedArray_t(parameter[0].to<uint32_t>(rt),thisType);
+	})
+
+	//! [ESMF] thisObj TypedArray[Number index] = Number value
+	ES_MFUNCTION(typeObject,TypedArray_t,"_set",2,2,{
+		size_t index;
+		if(!TypedArray_t::toIndex(parameter[0],index)){
+			rt.setException(std::string(getClassName())+"[...]: Invalid index '"+parameter[0].toString()+"'.");
+			return nullptr;
+		}
+		thisObj->setValue(parameter[0],parameter[1]);
+		return thisEObj;
+	})
+
+	//! [ESMF] thisObj TypedArray.add( TypedArray other | Number value )
+	ES_MFUNCTION(typeObject,TypedArray_t,"add",1,1,{
+		TypedArray_t * other = parameter[0].toType<TypedArray_t>();
+		if(!other){
+			thisObj->add(parameter[0].to<double>(rt));
+		}else if(other->size()!=thisObj->size()){
+			rt.setException(std::string(getClassName())+".add(...): Different sizes.");
+			return nullptr;
+		}else{
+			thisObj->add(*other);
+		}
+		return thisEObj;
+	})
+
+	//! [ESMF] thisObj TypedArray.append( Collection )
+	ES_MFUN(typeObject,TypedArray_t,"append",1,1,		(thisObj->append(assertType<Collection>(rt,parameter[0])),thisEObj))
+
+	//! [ESMF] Number TypedArray.dot( TypedArray other )
+	ES_MFUNCTION(typeObject,const TypedArray_t,"dot",1,1,{
+		const TypedArray_t * other = assertType<TypedArray_t>(rt,parameter[0]);
+		if(other->size()!=thisObj->size()){
+			rt.setException(std::string(getClassName())+".dot(...): Different sizes.");
+			return nullptr;
+		}
+		return thisObj->dot(*other);
+	})
+
+	//! [ESMF] thisObj TypedArray.fill( Number value [,Number begin [,Number end]] )
+	ES_MFUNCTION(typeObject,TypedArray_t,"fill",1,3,{
+		const size_t size = thisObj->size();
+		const size_t endIndex = std::min(static_cast<size_t>(parameter[2].to<uint32_t>(rt,static_cast<uint32_t>(size))),size);
+		const size_t beginIndex = std::min(static_cast<size_t>(parameter[1].to<uint32_t>(rt,0)),endIndex);
+		thisObj->fill(parameter[0].to<double>(rt),beginIndex,endIndex);
+		return thisEObj;
+	})
+
+	//! [ESMF] Number|void TypedArray.max()
+	ES_MFUNCTION(typeObject,const TypedArray_t,"max",0,0,{
+		value_t minValue;
+		value_t maxValue;
+		if(!thisObj->minMax(minValue,maxValue))
+			return nullptr;
+		return static_cast<double>(maxValue);
+	})
+
+	//! [ESMF] Number|void TypedArray.min()
+	ES_MFUNCTION(typeObject,const TypedArray_t,"min",0,0,{
+		value_t minValue;
+		value_t maxValue;
+		if(!thisObj->minMax(minValue,maxValue))
+			return nullptr;
+		return static_cast<double>(minValue);
+	})
+
+	//! [ESMF] thisObj TypedArray.pushBack( Number* )
+	ES_MFUNCTION(typeObject,TypedArray_t,"pushBack",1,-1,{
+		for(ParameterValues::size_type i = 0; i<parameter.count(); ++i)
+			(**thisObj).push_back(convert(parameter[i].to<double>(rt)));
+		return thisEObj;
+	})
+
+	//! [ESMF] thisObj TypedArray.resize( Number size )
+	ES_MFUN(typeObject,TypedArray_t,"resize",1,1,		(thisObj->resize(parameter[0].to<uint32_t>(rt)),thisEObj))
+
+	//! [ESMF] thisObj TypedArray.rSort()
+	ES_MFUN(typeObject,TypedArray_t,"rSort",0,0,		(thisObj->sort(true),thisEObj))
+
+	//! [ESMF] thisObj TypedArray.scale( Number factor )
+	ES_MFUN(typeObject,TypedArray_t,"scale",1,1,		(thisObj->scale(parameter[0].to<double>(rt)),thisEObj))
+
+	//! [ESMF] thisObj TypedArray.sort()
+	ES_MFUN(typeObject,TypedArray_t,"sort",0,0,		(thisObj->sort(false),thisEObj))
+
+	//! [ESMF] Number TypedArray.sum()
+	ES_MFUN(typeObject,const TypedArray_t,"sum",0,0,	thisObj->sum())
+
+	//! [ESMF] Array TypedArray.toArray()
+	ES_MFUN(typeObject,const TypedArray_t,"toArray",0,0,	thisObj->toArray())
+}
+
+//---
+
+//! (static)
+template<typename value_t>
+value_t TypedArray<value_t>::convert(double d){
+	return convertValue<value_t>(d,typename std::is_floating_point<value_t>::type());
+}
+
+//! (static)
+template<typename value_t>
+TypedArray<value_t> * TypedArray<value_t>::create(Collection * c){
+	TypedArray * a = new TypedArray;
+	a->append(c);
+	return a;
+}
+
+template<typename value_t>
+void TypedArray<value_t>::append(Collection * c){
+	if(!c)
+		return;
+	if(TypedArray * other = dynamic_cast<TypedArray*>(c)){
+		if(other==this){
+			const size_t size = data.size();
+			data.reserve(size*2);
+			std::copy(data.begin(),data.begin()+size,std::back_inserter(data));
+		}else{
+			data.insert(data.end(),other->begin(),other->end());
+		}
+	}else if(Array * array = dynamic_cast<Array*>(c)){
+		const size_t size = array->size();
+		data.reserve(data.size()+size);
+		for(size_t i = 0; i<size; ++i){
+			Object * obj = array->get(i);
+			data.push_back(convert(obj ? obj->toDouble() : 0.0));
+		}
+	}else{
+		ERef<Iterator> iRef = c->getIterator();
+		for( ; !iRef.isNull() && !iRef->end(); iRef->next()){
+			ObjRef value = iRef->value();
+			data.push_back(convert(value.toDouble()));
+		}
+	}
+}
+
+template<typename value_t>
+Array * TypedArray<value_t>::toArray()const{
+	Array * a = Array::create();
+	a->reserve(data.size());
+	for(const auto & value : data)
+		a->pushBack(Number::create(static_cast<double>(value)));
+	return a;
+}
+
+template<typename value_t>
+double TypedArray<value_t>::sum()const{
+	return static_cast<double>(sumKernel(data.data(),data.size()));
+}
+
+template<typename value_t>
+bool TypedArray<value_t>::minMax(value_t & minValue,value_t & maxValue)const{
+	if(data.empty())
+		return false;
+	minMaxKernel(data.data(),data.size(),minValue,maxValue);
+	return true;
+}
+
+template<typename value_t>
+double TypedArray<value_t>::dot(const TypedArray & other)const{
+	return dotKernel(data.data(),other.data.data(),std::min(data.size(),other.data.size()));
+}
+
+template<typename value_t>
+void TypedArray<value_t>::scale(double factor){
+	scaleKernel(data.data(),factor,data.size(),typename std::is_floating_point<value_t>::type());
+}
+
+template<typename value_t>
+void TypedArray<value_t>::add(const TypedArray & other){
+	addKernel(data.data(),other.data.data(),std::min(data.size(),other.data.size()));
+}
+
+template<typename value_t>
+void TypedArray<value_t>::add(double value){
+	addKernel(data.data(),convert(value),data.size());
+}
+
+template<typename value_t>
+void TypedArray<value_t>::fill(double value,size_t beginIndex,size_t endIndex){
+	std::fill(data.begin()+beginIndex,data.begin()+endIndex,convert(value));
+}
+
+template<typename value_t>
+void TypedArray<value_t>::sort(bool reverseOrder){
+	// NaN values are placed at the end
+	if(reverseOrder){
+		std::sort(data.begin(),data.end(),[](value_t a,value_t b){	return a>b || (a==a && b!=b);	});
+	}else{
+		std::sort(data.begin(),data.end(),[](value_t a,value_t b){	return a<b || (a==a && b!=b);	});
+	}
+}
+
+//! (static)
+template<typename value_t>
+bool TypedArray<value_t>::toIndex(const ObjPtr & key,size_t & index){
+	if(key.isNull())
+		return false;
+	const double value = key->toDouble();
+	if(!(value>=0 && value<static_cast<double>(MAX_SIZE))) // also false for NaN
+		return false;
+	index = static_cast<size_t>(value);
+	return true;
+}
+
+//! ---|> Collection
+template<typename value_t>
+Object * TypedArray<value_t>::getValue(ObjPtr key){
+	if(key.isNull())
+		return nullptr;
+	size_t index;
+	return toIndex(key,index) && index<data.size() ? Number::create(static_cast<double>(data[index])) : nullptr;
+}
+
+//! ---|> Collection
+template<typename value_t>
+void TypedArray<value_t>::setValue(ObjPtr key,ObjPtr value){
+	size_t index;
+	if(!toIndex(key,index)) // invalid writes are ignored (see "_set")
+		return;
+	if(index>=data.size())
+		data.resize(index+1,value_t(0));
+	data[index] = convert(value.toDouble());
+}
+
+//! ---|> [Object]
+template<typename value_t>
+Object * TypedArray<value_t>::clone()const{
+	TypedArray * a = new TypedArray(0,getType());
+	a->data = data;
+	return a;
+}
+
+//! ---|> [Object]
+template<typename value_t>
+bool TypedArray<value_t>::rt_isEqual(Runtime & runtime,const ObjPtr & other){
+	const TypedArray * otherArray = other.toType<TypedArray>();
+	if(otherArray)
+		return data==otherArray->data;
+	return Collection::rt_isEqual(runtime,other);
+}
+
+// ------- TypedArrayIterator
+
+//! ---|> [Iterator]
+template<typename value_t>
+Object * TypedArray<value_t>::TypedArrayIterator::key(){
+	return end() ? nullptr : Number::create(static_cast<double>(index));
+}
+
+//! ---|> [Iterator]
+template<typename value_t>
+Object * TypedArray<value_t>::TypedArrayIterator::value(){
+	return end() ? nullptr : Number::create(static_cast<double>(arrayRef->begin()[index]));
+}
+
+template class TypedArray<double>;
+template class TypedArray<float>;
+template class TypedArray<int32_t>;
+template class TypedArray<uint8_t>;
+
+}
@@ -0,0 +1,144 @@
+// TypedArray.h
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifndef ES_TYPEDARRAY_H
+#define ES_TYPEDARRAY_H
+
+#include "Collection.h"
+#include "../Iterator.h"
+#include <cstdint>
+#include <vector>
+
+namespace EScript {
+class Array;
+
+/*! [Float64Array|Float32Array|Int32Array|UInt8Array] ---|> [Collection] ---|> [Object]
+	Array of numbers stored in a contiguous buffer of the native type value_t. The values are
+	converted to Numbers when accessed (_get, foreach) and converted to value_t when stored
+	(integers are truncated and wrap around; non-finite values become 0).
+	The bulk operations (sum, min, max, dot, scale, add, fill, sort) work directly on the buffer
+	using loops that can be vectorized by the compiler.	*/
+template<typename value_t>
+class TypedArray : public Collection {
+	public:
+		static const char * getClassName();
+		virtual const char * getTypeName()const	{	return getClassName();	}
+
+	//! @name Types
+	// @{
+	public:
+		typedef std::vector<value_t>			container_t;
+		typedef typename container_t::size_type	size_type;
+	//	@}
+
+	//! @name Creation
+	// @{
+	public:
+		static TypedArray * create(size_t size = 0)	{	return new TypedArray(size);	}
+		static TypedArray * create(Collection * c);
+		TypedArray(size_t size = 0,Type * type = nullptr) :
+				Collection(type?type:getTypeObject()),data(size,value_t(0)){}
+		virtual ~TypedArray(){}
+	//	@}
+
+	//! @name TypeObject
+	// @{
+	public:
+		static Type* getTypeObject();
+		static void init(EScript::Namespace & globals);
+	//	@}
+
+	//! @name Data
+	// @{
+	private:
+		container_t data;
+	public:
+		static value_t convert(double d);
+
+		//! Writing to an index >= MAX_SIZE is refused (instead of allocating an absurd amount of memory).
+		static const size_t MAX_SIZE = 1<<28;
+		/*! If @p key is a Number in [0,MAX_SIZE), @p index is set to its integral part and true is returned.
+			Negative, non-finite and too large keys are no valid indices.	*/
+		static bool toIndex(const ObjPtr & key,size_t & index);
+
+		container_t & operator*()				{	return data;	}
+		const container_t & operator*()const	{	return data;	}
+		value_t * begin()						{	return data.data();	}
+		const value_t * begin()const			{	return data.data();	}
+		value_t * end()							{	return data.data()+data.size();	}
+		const value_t * end()const				{	return data.data()+data.size();	}
+
+		//! Append the values of the collection (converted by toDouble()).
+		void append(Collection * c);
+		bool empty()const						{	return data.empty();	}
+		size_t size()const						{	return data.size();	}
+		void resize(size_t newSize)				{	data.resize(newSize,value_t(0));	}
+		Array * toArray()const;
+
+		//! Sum of the values (integers are summed up without overflow up to 2^63).
+		double sum()const;
+		//! Returns false if empty.
+		bool minMax(value_t & minValue,value_t & maxValue)const;
+		//! Sum of the products; the arrays have to have the same size.
+		double dot(const TypedArray & other)const;
+		//! this[i] *= factor
+		void scale(double factor);
+		//! this[i] += other[i]; the arrays have to have the same size.
+		void add(const TypedArray & other);
+		//! this[i] += value
+		void add(double value);
+		void fill(double value,size_t beginIndex,size_t endIndex);
+		void sort(bool reverseOrder);
+	//	@}
+
+	//! @name ---|> [Collection]
+	// @{
+		//!	[TypedArrayIterator] ---|> [Iterator]
+		class TypedArrayIterator : public Iterator {
+				ES_PROVIDES_TYPE_NAME(TypedArrayIterator)
+			public:
+				TypedArrayIterator(TypedArray * ar) : Iterator(),arrayRef(ar),index(0){}
+				virtual ~TypedArrayIterator(){}
+
+				//! ---|> [Iterator]
+				virtual Object * key();
+				virtual Object * value();
+				virtual void reset()			{	index = 0;	}
+				virtual void next()				{	++index;	}
+				virtual bool end()				{	return index>=arrayRef->size();	}
+			private:
+				ERef<TypedArray> arrayRef;
+				size_t index;
+		};
+		virtual void clear()					{	data.clear();	}
+		virtual size_t count()const				{	return data.size();	}
+		virtual TypedArrayIterator * getIterator()	{	return new TypedArrayIterator(this);	}
+		virtual Object * getValue(ObjPtr key);
+		virtual void setValue(ObjPtr key,ObjPtr value);
+	//	@}
+
+	//! @name ---|> [Object]
+	// @{
+		virtual Object * clone()const;
+		virtual bool rt_isEqual(Runtime & runtime,const ObjPtr & other);
+	//	@}
+};
+
+typedef TypedArray<double> Float64Array;
+typedef TypedArray<float> Float32Array;
+typedef TypedArray<int32_t> Int32Array;
+typedef TypedArray<uint8_t> UInt8Array;
+
+template<> const char * TypedArray<double>::getClassName();
+template<> const char * TypedArray<float>::getClassName();
+template<> const char * TypedArray<int32_t>::getClassName();
+template<> const char * TypedArray<uint8_t>::getClassName();
+
+extern template class TypedArray<double>;
+extern template class TypedArray<float>;
+extern template class TypedArray<int32_t>;
+extern template class TypedArray<uint8_t>;
+}
+
+#endif // ES_TYPEDARRAY_H
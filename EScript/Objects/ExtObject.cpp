@@ -28,8 +28,8 @@ void ExtObject::init(EScript::Namespace & globals) {
 		ERef<ExtObject> result(new ExtObject(thisType));
 		if(parameter.count()>0){
 			Map * m = assertType<Map>(rt,parameter[0]);
-			for(const auto & keyValuePair : *m) {
-				result->setAttribute(keyValuePair.first, Attribute(keyValuePair.second.value));
+			for(const auto & entry : *m) {
+				result->setAttribute(entry.key.toString(), Attribute(entry.value));
 			}
 		}
 		return result.detachAndDecrease();
@@ -31,7 +31,39 @@ void Namespace::init(EScript::Namespace & globals) {
 //! ---|> [Object]
 Namespace * Namespace::clone() const{
 	Namespace * c = new Namespace(getType());
+	c->overlayBase = overlayBase;
 	c->cloneAttributesFrom(this);
 	return c;
 }
+
+//! (static)
+Namespace * Namespace::createOverlay(Namespace * base){
+	Namespace * overlay = new Namespace(base->getType());
+	overlay->overlayBase = base;
+	return overlay;
+}
+
+//! ---|> [Object]
+Attribute * Namespace::_accessAttribute(const StringId & id,bool localOnly){
+	if(overlayBase.isNotNull()){
+		Attribute * attr = ExtObject::_accessAttribute(id,true);
+		if(attr!=nullptr)
+			return attr;
+		// copy the binding on first access, as the returned attribute may be modified.
+		const Attribute * baseAttr = overlayBase->_accessAttribute(id,true);
+		if(baseAttr!=nullptr){
+			Object * value = baseAttr->getValue();
+			setAttribute(id,Attribute(value!=nullptr ? value->getRefOrCopy() : nullptr,baseAttr->getProperties()));
+			return ExtObject::_accessAttribute(id,true);
+		}
+	}
+	return ExtObject::_accessAttribute(id,localOnly);
+}
+
+//! ---|> [Object]
+void Namespace::collectLocalAttributes(std::unordered_map<StringId,Object *> & attrs){
+	if(overlayBase.isNotNull())
+		overlayBase->collectLocalAttributes(attrs);
+	ExtObject::collectLocalAttributes(attrs); // the overlay's own bindings shadow those of the base
+}
 }
@@ -22,6 +22,28 @@ class Namespace : public ExtObject {
 
 		//! ---|> [Object]
 		virtual Namespace * clone() const;
+
+	//! @name Copy-on-write overlay
+	//	@{
+	public:
+		/*! Create a Namespace that behaves like a clone of base, but only copies a binding of base
+			when it is accessed for the first time (like clone(), the bound objects are shared; only
+			call-by-value objects are copied). Bindings set in the overlay shadow those of base.
+			Bindings added to base later become visible in the overlay if not shadowed.
+			\note Accessing the overlay never modifies base.	*/
+		static Namespace * createOverlay(Namespace * base);
+		Namespace * getOverlayBase()const				{	return overlayBase.get();	}
+
+		using ExtObject::_accessAttribute;
+
+		//! ---|> [Object]
+		virtual Attribute * _accessAttribute(const StringId & id,bool localOnly);
+
+		//! ---|> [Object]
+		virtual void collectLocalAttributes(std::unordered_map<StringId,Object *> & attrs);
+	private:
+		ERef<Namespace> overlayBase;
+	//	@}
 };
 
 }
@@ -8,6 +8,7 @@
 #include "../Consts.h"
 #include "../Objects/Callables/Delegate.h"
 #include "../Objects/Exception.h"
+#include "../Objects/ObjectCounters.h"
 #include <sstream>
 
 #ifdef ES_DEBUG_MEMORY
@@ -175,6 +176,8 @@ void ObjectReleaseHandler::release(Object * o) {
 //! Constructor.
 Object::Object():
 		typeRef( getTypeObject() ){
+	++ObjectCounters::objectsConstructed;
+	typeRef->_countConstructedInstance();
 #ifdef ES_DEBUG_MEMORY
 	Debug::registerObj(this);
 #endif
@@ -183,6 +186,9 @@ Object::Object():
 //! Constructor.
 Object::Object(Type * _type):
 		typeRef( _type ){
+	++ObjectCounters::objectsConstructed;
+	if(typeRef.isNotNull())
+		typeRef->_countConstructedInstance();
 #ifdef ES_DEBUG_MEMORY
 	Debug::registerObj(this);
 #endif
@@ -190,6 +196,9 @@ Object::Object(Type * _type):
 
 //! Destructor.
 Object::~Object() {
+	++ObjectCounters::objectsDestroyed;
+	if(typeRef.isNotNull())
+		typeRef->_countDestroyedInstance();
 #ifdef ES_DEBUG_MEMORY
 	Debug::unRegisterObj(this);
 #endif
@@ -0,0 +1,52 @@
+// ObjectCounters.cpp
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#include "ObjectCounters.h"
+#include "Callables/Delegate.h"
+#include "Collections/Array.h"
+#include "Type.h"
+#include "Values/Bool.h"
+#include "Values/Number.h"
+#include "Values/String.h"
+#include "../Runtime/FunctionCallContext.h"
+
+namespace EScript{
+
+ObjectCounters::PoolCounter ObjectCounters::pools[ObjectCounters::NUM_POOLED_TYPES] = {};
+uint64_t ObjectCounters::objectsConstructed = 0;
+uint64_t ObjectCounters::objectsDestroyed = 0;
+
+//! (static)
+const char * ObjectCounters::getPooledTypeName(pooledType_t type){
+	switch(type){
+		case NUMBER:				return "Number";
+		case BOOL:					return "Bool";
+		case STRING:				return "String";
+		case ARRAY:					return "Array";
+		case DELEGATE:				return "Delegate";
+		case FUNCTION_CALL_CONTEXT:	return "FunctionCallContext";
+		default:					return "?";
+	}
+}
+
+//! (static)
+size_t ObjectCounters::getPoolSize(pooledType_t type){
+	switch(type){
+		case NUMBER:				return Number::_getPoolSize();
+		case BOOL:					return Bool::_getPoolSize();
+		case STRING:				return String::_getPoolSize();
+		case ARRAY:					return Array::_getPoolSize();
+		case DELEGATE:				return Delegate::_getPoolSize();
+		case FUNCTION_CALL_CONTEXT:	return FunctionCallContext::_getPoolSize();
+		default:					return 0;
+	}
+}
+
+//! (static)
+std::vector<Type*> & ObjectCounters::getTypes(){
+	static std::vector<Type*> types; // function-local: Types may be created during the static initialization
+	return types;
+}
+
+}
@@ -0,0 +1,55 @@
+// ObjectCounters.h
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifndef ES_OBJECT_COUNTERS_H
+#define ES_OBJECT_COUNTERS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace EScript {
+class Type;
+
+/*! [ObjectCounters]
+	Process-wide counters of the created and released objects. Like the object pools they describe,
+	the counters are shared by all Runtimes and are not synchronized.
+	- For the types using an object pool, the calls of the type's create(...) function that take an
+		object from the pool (hits) or have to allocate new objects (misses) and the calls of its
+		release(...) function are counted. Each call costs a single increment.
+	- For all Objects, the constructor and destructor calls are counted; in total and per Type (stored in the
+		object's Type). An object that is reused from a pool is only constructed once.	*/
+struct ObjectCounters{
+	enum pooledType_t{
+		NUMBER,
+		BOOL,
+		STRING,
+		ARRAY,
+		DELEGATE,
+		FUNCTION_CALL_CONTEXT,
+		NUM_POOLED_TYPES
+	};
+	struct PoolCounter{
+		uint64_t hits;
+		uint64_t misses;
+		uint64_t released;
+	};
+	struct TypeCounter{
+		uint64_t constructed;
+		uint64_t destroyed;
+	};
+	static PoolCounter pools[NUM_POOLED_TYPES];
+	static uint64_t objectsConstructed;
+	static uint64_t objectsDestroyed;
+
+	static const char * getPooledTypeName(pooledType_t type);
+	//! Number of unused objects currently stored in the type's pool.
+	static size_t getPoolSize(pooledType_t type);
+
+	//! All existing Types (each Type is added by its constructor and removed by its destructor).
+	static std::vector<Type*> & getTypes();
+};
+
+}
+#endif // ES_OBJECT_COUNTERS_H
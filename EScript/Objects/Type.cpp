@@ -7,6 +7,7 @@
 #include "../Basics.h"
 #include "../StdObjects.h"
 #include "Exception.h"
+#include <algorithm>
 
 namespace EScript{
 
@@ -80,14 +81,14 @@ void Type::init(EScript::Namespace & globals) {
 
 //! (ctor)
 Type::Type():
-	Object(Type::getTypeObject()),flags(0),baseType(Object::getTypeObject()) {
-	//ctor
+	Object(Type::getTypeObject()),flags(0),baseType(Object::getTypeObject()),instanceCounter() {
+	ObjectCounters::getTypes().push_back(this);
 }
 
 //! (ctor)
 Type::Type(Type * _baseType):
-		Object(Type::getTypeObject()),flags(0),baseType(_baseType) {
-
+		Object(Type::getTypeObject()),flags(0),baseType(_baseType),instanceCounter() {
+	ObjectCounters::getTypes().push_back(this);
 	if(getBaseType()!=nullptr)
 		getBaseType()->copyObjAttributesTo(this);
 	//ctor
@@ -95,8 +96,8 @@ Type::Type(Type * _baseType):
 
 //! (ctor)
 Type::Type(Type * _baseType,Type * typeOfType):
-		Object(typeOfType),flags(0),baseType(_baseType) {
-
+		Object(typeOfType),flags(0),baseType(_baseType),instanceCounter() {
+	ObjectCounters::getTypes().push_back(this);
 	if(getBaseType()!=nullptr)
 		getBaseType()->copyObjAttributesTo(this);
 	//ctor
@@ -104,7 +105,8 @@ Type::Type(Type * _baseType,Type * typeOfType):
 
 //! (dtor)
 Type::~Type() {
-	//dtor
+	std::vector<Type*> & types = ObjectCounters::getTypes();
+	types.erase(std::find(types.begin(),types.end(),this));
 }
 
 //! ---|> [Object]
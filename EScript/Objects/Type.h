@@ -7,6 +7,7 @@
 
 #include "Object.h"
 #include "../Utils/AttributeContainer.h"
+#include "ObjectCounters.h"
 #include <cstdint>
 
 namespace EScript {
@@ -109,6 +110,19 @@ class Type : public Object {
 		ERef<Type> baseType;
 	//	@}
 
+	// -------------------------------------------------------------
+
+	//! @name Instance counter
+	//	@{
+	public:
+		//! Number of constructed and destroyed instances (see ObjectCounters).
+		const ObjectCounters::TypeCounter & getInstanceCounter()const	{	return instanceCounter;	}
+		void _countConstructedInstance()							{	++instanceCounter.constructed;	}
+		void _countDestroyedInstance()								{	++instanceCounter.destroyed;	}
+	private:
+		ObjectCounters::TypeCounter instanceCounter;
+	//	@}
+
 };
 
 }
@@ -5,6 +5,7 @@
 #include "Bool.h"
 
 #include "../../Basics.h"
+#include "../ObjectCounters.h"
 
 #include <iostream>
 #include <stack>
@@ -82,20 +83,21 @@ Bool * Bool::create(bool value){
 	return new Bool(value);
 	#endif
 	if(pool.empty()){
+		++ObjectCounters::pools[ObjectCounters::BOOL].misses;
 		for(int i = 0;i<32;++i){
 			pool.push(new Bool(false));
 		}
-		return create(value);
 	}else{
-		Bool * o = pool.top();
-		pool.pop();
-		o->value = value;
-//        std::cout << ".";
-		return o;
+		++ObjectCounters::pools[ObjectCounters::BOOL].hits;
 	}
+	Bool * o = pool.top();
+	pool.pop();
+	o->value = value;
+	return o;
 
 }
 void Bool::release(Bool * o){
+	++ObjectCounters::pools[ObjectCounters::BOOL].released;
 	#ifdef ES_DEBUG_MEMORY
 	delete o;
 	return;
@@ -107,6 +109,9 @@ void Bool::release(Bool * o){
 		pool.push(o);
 	}
 }
+size_t Bool::_getPoolSize(){
+	return pool.size();
+}
 
 //---
 
@@ -18,6 +18,8 @@ class Bool : public Object {
 		static void init(EScript::Namespace & globals);
 		static Bool * create(bool value);
 		static void release(Bool * b);
+		//! (internal) Number of objects in the pool of unused objects.
+		static size_t _getPoolSize();
 
 		// ---
 
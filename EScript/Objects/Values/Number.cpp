@@ -4,6 +4,7 @@
 // ------------------------------------------------------
 #include "Number.h"
 #include "../../Basics.h"
+#include "../ObjectCounters.h"
 
 #include <cmath>
 #include <sstream>
@@ -275,8 +276,10 @@ Number * Number::create(double value){
 	return new Number(value);
 	#endif
 	if(pool.empty()){
+		++ObjectCounters::pools[ObjectCounters::NUMBER].misses;
 		return new Number(value);
 	}else{
+		++ObjectCounters::pools[ObjectCounters::NUMBER].hits;
 		Number * n = pool.top();
 		pool.pop();
 		n->setValue(value);
@@ -286,6 +289,7 @@ Number * Number::create(double value){
 
 //! (static)
 void Number::release(Number * n){
+	++ObjectCounters::pools[ObjectCounters::NUMBER].released;
 	#ifdef ES_DEBUG_MEMORY
 	delete n;
 	return;
@@ -297,6 +301,10 @@ void Number::release(Number * n){
 		pool.push(n);
 	}
 }
+//! (static)
+size_t Number::_getPoolSize(){
+	return pool.size();
+}
 //----------------------------------------------------------
 
 //! (ctor)
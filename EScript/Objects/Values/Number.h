@@ -26,6 +26,8 @@ class Number : public Object {
 		// ---
 		static Number * create(double value);
 		static void release(Number * n);
+		//! (internal) Number of objects in the pool of unused objects.
+		static size_t _getPoolSize();
 
 		// ---
 		/**
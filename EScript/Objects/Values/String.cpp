@@ -4,8 +4,10 @@
 // ------------------------------------------------------
 #include "String.h"
 #include "../../Basics.h"
+#include "../ObjectCounters.h"
 #include "../../StdObjects.h"
 #include "../../Utils/StringUtils.h"
+#include "../../Consts.h"
 
 #include <sstream>
 #include <stack>
@@ -31,6 +33,9 @@ template<> String * assertType<String>(Runtime & runtime, const ObjPtr & obj) {
 
 //---
 
+//! The native '+' member; if it is replaced, chained concatenations fall back to member calls.
+static Object * nativeConcatenationFunction = nullptr;
+
 //! (static)
 Type * String::getTypeObject(){
 	static Type * typeObject = new Type(Object::getTypeObject()); // ---|> Object
@@ -156,8 +161,8 @@ void String::init(EScript::Namespace & globals) {
 			assertParamCount(rt,parameter.count(),1,2);
 			std::vector<keyValuePair_t> rules;
 			
-			for(const auto & it : *m)
-				rules.emplace_back(it.first,it.second.value->toString());
+			for(const auto & entry : *m)
+				rules.emplace_back(entry.key.toString(),entry.value.toString());
 			return StringUtils::replaceMultiple(subject,rules,parameter[1].toInt(-1));
 		}else{
 			assertParamCount(rt,parameter.count(),2,3);
@@ -211,6 +216,7 @@ void String::init(EScript::Namespace & globals) {
 
 	//! [ESMF] String String+(String)Obj
 	ES_MFUN(typeObject,const String,"+",1,1,thisObj->getString() + parameter[0].toString())
+	nativeConcatenationFunction = typeObject->getLocalAttribute(Consts::IDENTIFIER_fn_plus).getValue();
 
 	//! [ESMF] String String*(Number)Obj
 	ES_MFUNCTION(typeObject,const String,"*",1,1,{
@@ -255,8 +261,10 @@ String * String::create(const StringData & sData){
 	return new String(sData);
 	#endif
 	if(pool.empty()){
+		++ObjectCounters::pools[ObjectCounters::STRING].misses;
 		return new String (sData);
 	}else{
+		++ObjectCounters::pools[ObjectCounters::STRING].hits;
 		String * o = pool.top();
 		pool.pop();
 		o->setString(sData);
@@ -264,6 +272,7 @@ String * String::create(const StringData & sData){
 	}
 }
 void String::release(String * o){
+	++ObjectCounters::pools[ObjectCounters::STRING].released;
 	#ifdef ES_DEBUG_MEMORY
 	delete o;
 	return;
@@ -272,11 +281,50 @@ void String::release(String * o){
 		delete o;
 		std::cout << "(internal) String::release: Invalid StringType\n";
 	}else{
-	   pool.push(o);
+		o->setString(StringData()); // release the data; otherwise, its owner could not append in place
+		pool.push(o);
 	}
 }
+size_t String::_getPoolSize(){
+	return pool.size();
+}
 //---
 
+//! (static,internal)
+bool String::_isNativeConcatenation(const Object * obj){
+	return obj!=nullptr && obj->getType()==getTypeObject() &&
+			getTypeObject()->getLocalAttribute(Consts::IDENTIFIER_fn_plus).getValue()==nativeConcatenationFunction;
+}
+
+//! (static,internal)
+String * String::concat(const ObjRef * parts, size_t numParts){
+	// pass 1: determine the size; only the representations of non-String parts are created
+	std::vector<std::string> convertedParts;
+	size_t size = 0;
+	for(size_t i = 0; i<numParts; ++i){
+		const Object * obj = parts[i].get();
+		if(obj!=nullptr && obj->_getInternalTypeId()==_TypeIds::TYPE_STRING){
+			size += static_cast<const String*>(obj)->getDataSize();
+		}else{
+			convertedParts.emplace_back(parts[i].toString());
+			size += convertedParts.back().length();
+		}
+	}
+	// pass 2: fill the result
+	std::string s;
+	s.reserve(size);
+	auto converted = convertedParts.begin();
+	for(size_t i = 0; i<numParts; ++i){
+		const Object * obj = parts[i].get();
+		if(obj!=nullptr && obj->_getInternalTypeId()==_TypeIds::TYPE_STRING){
+			s += static_cast<const String*>(obj)->getString();
+		}else{
+			s += *converted;
+			++converted;
+		}
+	}
+	return create(StringData(std::move(s)));
+}
 
 //! ---|> [Object]
 std::string String::toDbgString()const{
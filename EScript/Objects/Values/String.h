@@ -27,6 +27,16 @@ class String : public Object {
 		static String * create(const std::string & s)		{	return create(StringData(s));	}
 		static String * create(const StringData & sData);
 		static void release(String * b);
+		//! (internal) Number of objects in the pool of unused objects.
+		static size_t _getPoolSize();
+
+		/*! (internal) Returns true iff @p obj is a String whose '+' member is the native concatenation,
+			i.e. a '+'-call on the object can be replaced by a call to concat(...). */
+		static bool _isNativeConcatenation(const Object * obj);
+
+		/*! (internal) Create a single new String from the string representations of the given objects.
+			Used by the runtime to evaluate chains of '+'-calls ("<td>" + a + "</td>") without intermediate Strings. */
+		static String * concat(const ObjRef * parts, size_t numParts);
 
 		// ---
 		virtual ~String()							{}
@@ -34,12 +44,13 @@ class String : public Object {
 		StringData & operator*()					{	return sData;	}
 		const std::string & operator*()const		{	return sData.str();	}
 
-		void appendString(const std::string & _s)	{	sData.set(sData.str()+_s);	}
+		void appendString(const std::string & _s)	{	sData.append(_s);	}
 		bool empty()const							{	return sData.empty();	}
 		size_t length()const						{	return sData.getNumCodepoints();	}
 		size_t getDataSize()const					{	return sData.getDataSize();	}
 
 		const std::string & getString()const		{	return sData.str();	}
+		const StringData & getStringData()const		{	return sData;	}
 		void setString(const std::string & _s)		{	sData.set(_s);	}
 		void setString(const StringData & _sData)	{	sData.set(_sData);	}
 
@@ -6,10 +6,14 @@
 
 #include "../Consts.h"
 #include "../Objects/Identifier.h"
+#include "../Objects/ObjectCounters.h"
 #include "../Objects/Values/Bool.h"
 #include "../Objects/Values/Number.h"
 #include "../Objects/Values/String.h"
 #include "../Objects/Values/Void.h"
+#ifdef ES_DEBUG_MEMORY
+#include "../Utils/Debug.h"
+#endif
 #include <stdexcept>
 #include <sstream>
 
@@ -21,8 +25,10 @@ std::stack<FunctionCallContext *> FunctionCallContext::pool;
 FunctionCallContext * FunctionCallContext::create(const EPtr<UserFunction> userFunction,const ObjPtr _caller){
 	FunctionCallContext * fcc = nullptr;
 	if(pool.empty()){
+		++ObjectCounters::pools[ObjectCounters::FUNCTION_CALL_CONTEXT].misses;
 		fcc = new FunctionCallContext;
 	}else{
+		++ObjectCounters::pools[ObjectCounters::FUNCTION_CALL_CONTEXT].hits;
 		fcc = pool.top();
 		pool.pop();
 	}
@@ -33,10 +39,16 @@ FunctionCallContext * FunctionCallContext::create(const EPtr<UserFunction> userF
 
 //! static
 void FunctionCallContext::release(FunctionCallContext *fcc){
+	++ObjectCounters::pools[ObjectCounters::FUNCTION_CALL_CONTEXT].released;
 	pool.push(fcc);
 	fcc->reset();
 }
 
+//! static
+size_t FunctionCallContext::_getPoolSize(){
+	return pool.size();
+}
+
 // -------------------------------------------------------------------------
 
 std::string FunctionCallContext::getLocalVariablesAsString(const bool includeUndefined)const{
@@ -68,6 +80,7 @@ void FunctionCallContext::init(const EPtr<UserFunction> _userFunction,const ObjP
 	localVariables[Consts::LOCAL_VAR_INDEX_thisFn] = userFunction.get();
 }
 void FunctionCallContext::initCaller(const ObjPtr _caller){
+	releaseLocalVariable(Consts::LOCAL_VAR_INDEX_this);
 	caller = _caller;
 	localVariables[Consts::LOCAL_VAR_INDEX_this] = caller;
 }
@@ -90,9 +103,14 @@ ObjRef FunctionCallContext::rtValueToObject(RtValue & entry){
 	case RtValue::VOID_VALUE:
 		return Void::get();
 	case RtValue::OBJECT_PTR:{
-		ObjRef result(std::move( entry._detachObject() ));
+		ObjRef result;
+		result._set( entry._detachObject() );
 		return result;
 	}
+	case RtValue::OBJECT_PTR_BORROWED:{
+		verifyBorrowedObject(entry);
+		return entry._getObject();
+	}
 	case RtValue::BOOL:{
 		return Bool::create(entry._getBool());
 	}
@@ -121,8 +139,11 @@ ObjRef FunctionCallContext::stack_popObjectValue(){
 	case RtValue::VOID_VALUE:
 		obj = Void::get();
 		break;
+	case RtValue::OBJECT_PTR_BORROWED:
+		verifyBorrowedObject(entry);
+		// fall through
 	case RtValue::OBJECT_PTR:{
-		obj = entry.getObject()->getRefOrCopy();
+		obj = entry._getObject()->getRefOrCopy();
 		break;
 	}
 	case RtValue::BOOL:{
@@ -156,6 +177,20 @@ ObjRef FunctionCallContext::stack_popObjectValue(){
 	return obj;
 }
 
+void FunctionCallContext::stack_promoteBorrowedObject(Object * obj){
+	for(auto & entry : valueStack){
+		if(entry.isBorrowedObject() && entry._getObject()==obj)
+			entry._promoteBorrowedObject();
+	}
+}
+
+#ifdef ES_DEBUG_MEMORY
+void FunctionCallContext::verifyBorrowedObject(const RtValue & entry)const{
+	if(!Debug::isRegistered(entry._getObject()) || entry._getObject()->countReferences()<=0)
+		throwError(BORROWED_OBJECT_RELEASED);
+}
+#endif
+
 void FunctionCallContext::throwError(FunctionCallContext::error_t error)const{
 	static const std::string prefix("Internal error: ");
 	switch(error){
@@ -167,6 +202,8 @@ void FunctionCallContext::throwError(FunctionCallContext::error_t error)const{
 			throw std::logic_error(prefix+"Invalid local variable.");
 		case UNKNOWN_STATIC_VARIABLE:
 			throw std::logic_error(prefix+"Invalid static variable.");
+		case BORROWED_OBJECT_RELEASED:
+			throw std::logic_error(prefix+"Borrowed stack object has been released.");
 		default:
 			throw std::logic_error(prefix+"???");
 	}
@@ -22,6 +22,8 @@ class FunctionCallContext:public EReferenceCounter<FunctionCallContext,FunctionC
 	public:
 		static FunctionCallContext * create(const EPtr<UserFunction> userFunction,const ObjPtr _caller);
 		static void release(FunctionCallContext *rts);
+		//! (internal) Number of objects in the pool of unused objects.
+		static size_t _getPoolSize();
 
 		// ----
 
@@ -36,6 +38,7 @@ class FunctionCallContext:public EReferenceCounter<FunctionCallContext,FunctionC
 			STACK_WRONG_DATA_TYPE,
 			UNKNOWN_LOCAL_VARIABLE,
 			UNKNOWN_STATIC_VARIABLE,
+			BORROWED_OBJECT_RELEASED,
 		};
 		void throwError(error_t error)const;
 
@@ -70,7 +73,8 @@ class FunctionCallContext:public EReferenceCounter<FunctionCallContext,FunctionC
 
 		void increaseInstructionCursor()				{	++instructionCursor;	}
 
-		//! Set the caller-object; the caller-member as well as the local-'this'-variable
+		/*! Set the caller-object; the caller-member as well as the local-'this'-variable
+			\note As the caller may be borrowed by stack entries, it must only be changed while the stack is empty. */
 		void initCaller(const ObjPtr _caller);
 		bool isConstructorCall()const					{	return constructorCall;	}
 		bool isExecutionStoppedAfterEnding()const		{	return stopExecutionAfterEnding;	}
@@ -89,15 +93,25 @@ class FunctionCallContext:public EReferenceCounter<FunctionCallContext,FunctionC
 	// @{
 	private:
 		std::vector<ObjRef> localVariables;
+
+		/*! The old value of a local variable may still be borrowed by entries on the value stack
+			(e.g. the caller of a pending member call). These entries have to become counted before the
+			variable releases its reference.	*/
+		void releaseLocalVariable(const uint32_t index){
+			if(!valueStack.empty() && localVariables[index].isNotNull())
+				stack_promoteBorrowedObject(localVariables[index].get());
+		}
 	public:
 		void assignToLocalVariable(const uint32_t index, ObjRef && value){
 			if(index>=localVariables.size())
 				throwError(UNKNOWN_LOCAL_VARIABLE);
+			releaseLocalVariable(index);
 			localVariables[index] = std::move(value);
 		}
 		void assignToLocalVariable(const uint32_t index, const ObjRef & value){
 			if(index>=localVariables.size())
 				throwError(UNKNOWN_LOCAL_VARIABLE);
+			releaseLocalVariable(index);
 			localVariables[index] = value;
 		}
 		Object * getLocalVariable(const uint32_t index)const{
@@ -115,6 +129,7 @@ class FunctionCallContext:public EReferenceCounter<FunctionCallContext,FunctionC
 		void resetLocalVariable(const uint32_t index){
 			if(index>=localVariables.size())
 				throwError(UNKNOWN_LOCAL_VARIABLE);
+			releaseLocalVariable(index);
 			localVariables[index] = nullptr;
 		}
 		StringId getLocalVariableName(const uint32_t index)const{
@@ -130,10 +145,22 @@ class FunctionCallContext:public EReferenceCounter<FunctionCallContext,FunctionC
 	//	-----------------------------
 
 	//! @name RtValue Stack operations
+	/*! Objects that are guaranteed to outlive their stack entry (local variables, the caller, the globals
+		and function constants) are pushed as borrowed values without touching their reference counter.
+		A borrowed entry becomes a counted one when it is copied, popped as an object or when its owning
+		local variable is overwritten.
+		If ES_DEBUG_MEMORY is defined, every borrowed object is checked to be still alive when it is popped.	*/
 	// @{
 	private:
 		std::vector<RtValue> valueStack;
 
+		void stack_promoteBorrowedObject(Object * obj);
+#ifdef ES_DEBUG_MEMORY
+		void verifyBorrowedObject(const RtValue & entry)const;
+#else
+		void verifyBorrowedObject(const RtValue &)const	{}
+#endif
+
 	public:
 		void stack_clear();
 		void stack_dup()								{		valueStack.emplace_back(stack_top());	}
@@ -141,7 +168,12 @@ class FunctionCallContext:public EReferenceCounter<FunctionCallContext,FunctionC
 		void stack_pushBool(const bool value)			{	valueStack.emplace_back(value); }
 		void stack_pushUndefined()						{	valueStack.emplace_back(RtValue());	 }
 		void stack_pushFunction(const uint32_t functionIndex){
-			valueStack.emplace_back(userFunction->getInstructionBlock().getUserFunction(functionIndex));
+			valueStack.emplace_back(RtValue::createBorrowedObject(userFunction->getInstructionBlock().getUserFunction(functionIndex)));
+		}
+		//! Push an object that is kept alive by the fcc or the runtime (local variable, caller, globals) without counting it.
+		void stack_pushBorrowedObject(Object * obj)	{	valueStack.emplace_back(RtValue::createBorrowedObject(obj));	}
+		void stack_pushLocalVariable(const uint32_t index){
+			valueStack.emplace_back(RtValue::createBorrowedObject(getLocalVariable(index)));
 		}
 		void stack_pushNumber(const double & value)		{	valueStack.emplace_back(value); }
 		void stack_pushUInt32(const uint32_t value)		{	valueStack.emplace_back(value); }
@@ -193,7 +225,7 @@ class FunctionCallContext:public EReferenceCounter<FunctionCallContext,FunctionC
 		ObjRef stack_popObject(){
 			ObjRef obj;
 			RtValue & top = stack_top();
-			if(top.isObject()){ // fast path
+			if(top.isOwnedObject()){ // fast path
 				obj._set( top._detachObject() );
 			}else{
 				obj =  std::move(rtValueToObject(top));
@@ -33,6 +33,8 @@ std::string RtValue::toDbgString()const{
 			return value.value_bool ? "true" : "false";
 		case OBJECT_PTR:
 			return value.value_obj->toDbgString();
+		case OBJECT_PTR_BORROWED:
+			return value.value_obj->toDbgString()+"(borrowed)";
 		case UINT32:{
 			std::ostringstream s;
 			s<<value.value_uint32;
@@ -78,6 +80,7 @@ Object * RtValue::_toObject()const{
 		case BOOL:
 			return Bool::create(value.value_bool);
 		case OBJECT_PTR:
+		case OBJECT_PTR_BORROWED:
 			return value.value_obj;
 		case UINT32:
 			return Number::create(value.value_uint32);
@@ -22,6 +22,7 @@ class RtValue{
 		enum valueType_t{
 			VOID_VALUE,
 			OBJECT_PTR,
+			OBJECT_PTR_BORROWED,
 			BOOL,
 			UINT32,
 			NUMBER,
@@ -60,6 +61,17 @@ class RtValue{
 			v.value.value_localStringIndex = idx;
 			return v;
 		}
+		/*! (factory) Create a value referencing @p obj without increasing its reference counter.
+			The owner of the object has to keep it alive as long as the value exists.
+			Copying a borrowed value results in a normal (counted) object value.
+			\note Only used for entries of a FunctionCallContext's value stack.	*/
+		static RtValue createBorrowedObject(Object * obj){
+			if(obj==nullptr)
+				return RtValue(VOID_VALUE);
+			RtValue v(OBJECT_PTR_BORROWED);
+			v.value.value_obj = obj;
+			return v;
+		}
 		//! (factory)
 		static RtValue createFunctionCallContext(FunctionCallContext* fcc){
 			RtValue v(FUNCTION_CALL_CONTEXT);
@@ -99,8 +111,10 @@ class RtValue{
 			}
 		}
 		RtValue(const RtValue & other) : valueType(other.valueType),value(other.value){
-			if(valueType == OBJECT_PTR)
+			if(valueType == OBJECT_PTR || valueType == OBJECT_PTR_BORROWED){
+				valueType = OBJECT_PTR;
 				Object::addReference(value.value_obj);
+			}
 		}
 		RtValue(const ObjRef & obj){
 			if(obj==nullptr){
@@ -120,7 +134,7 @@ class RtValue{
 			}
 		}
 
-		RtValue(RtValue && other) : valueType(other.valueType),value(other.value){
+		RtValue(RtValue && other) noexcept : valueType(other.valueType),value(other.value){
 			other.valueType = UNDEFINED;
 		}
 	public:
@@ -130,17 +144,17 @@ class RtValue{
 				Object::removeReference(value.value_obj);
 		}
 		RtValue & operator=(const RtValue & other){
-			if(other.valueType == OBJECT_PTR){ // new value is object
+			if(other.isObject()){ // new value is object
 				Object::addReference(other.value.value_obj);
 			}
 			if(valueType==OBJECT_PTR){ // old value is object
 				Object::removeReference(value.value_obj);
 			}
-			valueType = other.valueType;
+			valueType = other.valueType == OBJECT_PTR_BORROWED ? OBJECT_PTR : other.valueType;
 			value = other.value;
 			return * this;
 		}
-		RtValue & operator=(RtValue && other){
+		RtValue & operator=(RtValue && other) noexcept{
 			if(valueType==OBJECT_PTR)
 				Object::removeReference(value.value_obj);
 			valueType = other.valueType;
@@ -148,12 +162,19 @@ class RtValue{
 			other.valueType = UNDEFINED;
 			return * this;
 		}
-		//! Detach the object without checking the type or changing the object's reference counter.
+		/*! Detach the object without checking the type or changing the object's reference counter.
+			\note Must not be used for borrowed objects, as the caller would receive a reference it does not own. */
 		Object * _detachObject(){
 			valueType = RtValue::UNDEFINED;
 			return value.value_obj;
 		}
-		Object * getObject()const				{	return valueType == OBJECT_PTR ? value.value_obj : nullptr;	}
+		Object * getObject()const				{	return isObject() ? value.value_obj : nullptr;	}
+
+		//! Turn a borrowed object value into a counted one.
+		void _promoteBorrowedObject(){
+			valueType = OBJECT_PTR;
+			Object::addReference(value.value_obj);
+		}
 
 		//! Access the value of a specific type without checking if the type is correct.
 		bool _getBool()const					{	return value.value_bool;	}
@@ -168,7 +189,9 @@ class RtValue{
 		bool isIdentifier()const				{	return valueType == IDENTIFIER;	}
 		bool isLocalString()const				{	return valueType == LOCAL_STRING_IDX;	}
 		bool isNumber()const					{	return valueType == NUMBER;	}
-		bool isObject()const					{	return valueType == OBJECT_PTR;	}
+		bool isBorrowedObject()const			{	return valueType == OBJECT_PTR_BORROWED;	}
+		bool isObject()const					{	return valueType == OBJECT_PTR || valueType == OBJECT_PTR_BORROWED;	}
+		bool isOwnedObject()const				{	return valueType == OBJECT_PTR;	}
 		bool isUint32()const					{	return valueType == UINT32;	}
 		bool isUndefined()const					{	return valueType == UNDEFINED;	}
 		bool isVoid()const						{	return valueType == VOID_VALUE;	}
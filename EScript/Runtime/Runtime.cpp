@@ -9,13 +9,16 @@
 #include "../Basics.h"
 #include "../StdObjects.h"
 #include "../Objects/Exception.h"
+#include "../Objects/ObjectCounters.h"
 #include "../Objects/Callables/Function.h"
 #include "../Objects/Callables/UserFunction.h"
 #include "../Objects/Callables/Delegate.h"
 #include "../Objects/YieldIterator.h"
 #include "../Utils/Logger.h"
+#include "../Consts.h"
 #include <algorithm>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <stack>
 
@@ -55,6 +58,9 @@ void Runtime::init(EScript::Namespace & globals) {
 	ES_FUN(typeObject,"_setStackSizeLimit",1,1,
 				(rt._setStackSizeLimit(parameter[0].to<uint32_t>(rt)),RtValue(nullptr)))
 
+	//!	[ESMF] void Runtime.clearExecutionBudget();
+	ES_FUN(typeObject,"clearExecutionBudget",0,0, (rt.clearExecutionBudget(),RtValue(nullptr)))
+
 	//!	[ESMF] void Runtime.disableLogCounting( );
 	ES_FUN(typeObject,"disableLogCounting",0,1, (rt.disableLogCounting(),RtValue(nullptr)))
 
@@ -74,6 +80,9 @@ void Runtime::init(EScript::Namespace & globals) {
 	//!	[ESMF] Number Runtime.getLoggingLevel();
 	ES_FUN(typeObject,"getLoggingLevel",0,0, static_cast<int>(rt.getLoggingLevel()))
 
+	//!	[ESMF] Map Runtime.getMetrics();
+	ES_FUN(typeObject,"getMetrics",0,0, rt.createMetricsMap())
+
 	//!	[ESMF] String Runtime.getStackInfo();
 	ES_FUN(typeObject,"getStackInfo",0,0, rt.getStackInfo())
 
@@ -85,10 +94,19 @@ void Runtime::init(EScript::Namespace & globals) {
 	ES_FUN(typeObject,"resetLogCounter",1,1,
 				(rt.resetLogCounter(static_cast<Logger::level_t>(parameter[0].to<int>(rt))),RtValue(nullptr)))
 
+	//!	[ESMF] void Runtime.resetMetrics();
+	ES_FUN(typeObject,"resetMetrics",0,0, (rt.resetMetrics(),RtValue(nullptr)))
+
 	//!	[ESMF] void Runtime._setAddStackInfoToExceptions(bool);
 	ES_FUN(typeObject,"_setAddStackInfoToExceptions",1,1,
 				(rt.setAddStackInfoToExceptions(parameter[0].toBool()),RtValue(nullptr)))
 
+	/*!	[ESMF] void Runtime.setExecutionBudget(Number maxInstructions[, Number maxSeconds=0]);
+		When the budget is exceeded, an Exception is thrown on each following jump or call until
+		the budget is renewed or cleared.	*/
+	ES_FUN(typeObject,"setExecutionBudget",1,2,
+				(rt.setExecutionBudget(static_cast<uint64_t>(parameter[0].to<double>(rt)),parameter[1].toDouble(0.0)),RtValue(nullptr)))
+
 	//!	[ESMF] void Runtime.setLoggingLevel(Number);
 	ES_FUN(typeObject,"setLoggingLevel",1,1,
 				(rt.setLoggingLevel(static_cast<Logger::level_t>(parameter[0].to<int>(rt))),RtValue(nullptr)))
@@ -136,6 +154,36 @@ Runtime::~Runtime() {
 	//dtor
 }
 
+//! (static,internal) Copy the attributes; Collections are cloned, all other objects are shared.
+static void copyRuntimeAttributes(ExtObject & target,ExtObject & source){
+	std::unordered_map<StringId,Object *> attributes;
+	source.collectLocalAttributes(attributes);
+	for(const auto & idValuePair : attributes){
+		Object * value = idValuePair.second;
+		if(value==nullptr)
+			continue;
+		const Attribute * attr = source._accessAttribute(idValuePair.first,true);
+		target.setAttribute(idValuePair.first,
+				Attribute(dynamic_cast<Collection*>(value) ? value->clone() : value->getRefOrCopy(),attr->getProperties()));
+	}
+}
+
+//! (ctor)
+Runtime::Snapshot::Snapshot(Runtime & runtime) :
+		globals(runtime.getGlobals()->clone()),attributes(new ExtObject){
+	declareConstant(globals.get(),"GLOBALS",nullptr); // re-bound by each new Runtime
+	copyRuntimeAttributes(*attributes.get(),runtime);
+}
+
+//! (ctor)
+Runtime::Runtime(const Snapshot & snapshot) :
+		ExtObject(Runtime::getTypeObject()), internals(new RuntimeInternals(*this,snapshot.globals.get())),
+		logger(new LoggerGroup(Logger::LOG_WARNING)){
+
+	logger->addLogger("coutLogger",new StdLogger(std::cout));
+	copyRuntimeAttributes(*this,*snapshot.attributes.get());
+}
+
 bool Runtime::assertNormalState()const {
 	return internals->checkNormalState();
 }
@@ -170,6 +218,7 @@ bool Runtime::checkNormalState()const				{	return internals->checkNormalState();
 ObjRef Runtime::createInstance(const EPtr<Type> & type,const ParameterValues & _params){
 	if(!internals->checkNormalState())
 		return nullptr;
+	RuntimeInternals::ExecutionEntry entry(*internals,true);
 	ParameterValues params(_params);
 	RtValue callResult(std::move(internals->startInstanceCreation(type,params)));
 	ObjRef resultObj;
@@ -189,6 +238,7 @@ ObjRef Runtime::createInstance(const EPtr<Type> & type,const ParameterValues & _
 ObjRef Runtime::executeFunction(const ObjPtr & fun,const ObjPtr & caller,const ParameterValues & _params){
 	if(!internals->checkNormalState())
 		return nullptr;
+	RuntimeInternals::ExecutionEntry entry(*internals,true);
 	ParameterValues params(_params);
 	ObjRef resultObj;
 	RtValue callResult(std::move(internals->startFunctionExecution(fun,caller,params)));
@@ -206,6 +256,24 @@ ObjRef Runtime::executeFunction(const ObjPtr & fun,const ObjPtr & caller,const P
 
 ObjRef Runtime::fetchAndClearExitResult()			{	return internals->fetchAndClearExitResult();	}
 
+void Runtime::abortSuspendedExecution()				{	internals->abortSuspendedExecution();	}
+
+void Runtime::clearExecutionBudget()				{	internals->clearExecutionBudget();	}
+
+bool Runtime::isSuspended()const					{	return internals->isSuspended();	}
+
+ObjRef Runtime::resumeExecution(){
+	RuntimeInternals::ExecutionEntry entry(*internals,true);
+	ObjRef resultObj = internals->resumeExecution();
+	if(internals->getState()==RuntimeInternals::STATE_EXCEPTION)
+		throw internals->fetchAndClearException().detachAndDecrease();
+	return resultObj;
+}
+
+void Runtime::setExecutionBudget(uint64_t maxInstructions,double maxSeconds,budgetAction_t action){
+	internals->setExecutionBudget(maxInstructions,maxSeconds,action);
+}
+
 ObjPtr Runtime::getCallingObject()const				{	return internals->getCallingObject();	}
 
 std::string Runtime::getCurrentFile()const			{	return internals->getCurrentFile();	}
@@ -265,6 +333,7 @@ void Runtime::yieldNext(YieldIterator & yIt){
 		setException("Invalid YieldIterator");
 		return;
 	}
+	RuntimeInternals::ExecutionEntry entry(*internals,false);
 	ObjRef result( internals->executeFunctionCallContext( fcc ) );
 	// error occurred? throw an exception!
 	if(internals->getState()==RuntimeInternals::STATE_EXCEPTION){
@@ -324,6 +393,68 @@ uint32_t Runtime::getLogCounter(Logger::level_t level)const{
 	return l==nullptr ? 0 : l->get(level);
 }
 
+// ----------------------------------------------------------------------------------
+// ---- Metrics
+
+const Runtime::Metrics & Runtime::getMetrics()const	{	return internals->getMetrics();	}
+
+void Runtime::resetMetrics()						{	internals->resetMetrics();	}
+
+void Runtime::_addCompilationTime(double seconds)	{	internals->getMetrics().compilationTime += seconds;	}
+
+Map * Runtime::createMetricsMap()const{
+	using EScript::create;
+	const Metrics & metrics = getMetrics();
+	Map * m = Map::create();
+	m->setValue(create("instructionsExecuted"),	create(static_cast<double>(metrics.instructionsExecuted)));
+	m->setValue(create("userFunctionCalls"),	create(static_cast<double>(metrics.userFunctionCalls)));
+	m->setValue(create("nativeFunctionCalls"),	create(static_cast<double>(metrics.nativeFunctionCalls)));
+	m->setValue(create("exceptionsThrown"),		create(static_cast<double>(metrics.exceptionsThrown)));
+	m->setValue(create("maxStackSize"),			create(static_cast<double>(metrics.maxStackSize)));
+	m->setValue(create("compilationTime"),		create(metrics.compilationTime));
+	m->setValue(create("objectsConstructed"),	create(static_cast<double>(ObjectCounters::objectsConstructed)));
+	m->setValue(create("objectsDestroyed"),		create(static_cast<double>(ObjectCounters::objectsDestroyed)));
+
+	Map * pools = Map::create();
+	for(int i = 0; i<ObjectCounters::NUM_POOLED_TYPES; ++i){
+		const ObjectCounters::pooledType_t type = static_cast<ObjectCounters::pooledType_t>(i);
+		const ObjectCounters::PoolCounter & c = ObjectCounters::pools[type];
+		const uint64_t created = c.hits+c.misses;
+		Map * entry = Map::create();
+		entry->setValue(create("hits"),		create(static_cast<double>(c.hits)));
+		entry->setValue(create("misses"),	create(static_cast<double>(c.misses)));
+		entry->setValue(create("released"),	create(static_cast<double>(c.released)));
+		entry->setValue(create("poolSize"),	create(static_cast<double>(ObjectCounters::getPoolSize(type))));
+		entry->setValue(create("hitRate"),	create(created==0 ? 0.0 : static_cast<double>(c.hits)/created));
+		pools->setValue(create(ObjectCounters::getPooledTypeName(type)),entry);
+	}
+	m->setValue(create("pools"),pools);
+
+	// Types without a (local) printable name are identified by their string representation.
+	std::map<std::string,ObjectCounters::TypeCounter> typeCounters;
+	for(Type * type : ObjectCounters::getTypes()){
+		const ObjectCounters::TypeCounter & c = type->getInstanceCounter();
+		if(c.constructed==0)
+			continue;
+		const Attribute * nameAttr = type->_accessAttribute(Consts::IDENTIFIER_attr_printableName,true);
+		const Object * printableName = nameAttr==nullptr ? nullptr : nameAttr->getValue();
+		const bool named = printableName!=nullptr && (printableName->_getInternalTypeId()==_TypeIds::TYPE_STRING ||
+													printableName->_getInternalTypeId()==_TypeIds::TYPE_IDENTIFIER);
+		ObjectCounters::TypeCounter & sum = typeCounters[named ? printableName->toString() : type->toString()];
+		sum.constructed += c.constructed;
+		sum.destroyed += c.destroyed;
+	}
+	Map * types = Map::create();
+	for(const auto & entry : typeCounters){
+		Map * counter = Map::create();
+		counter->setValue(create("constructed"),	create(static_cast<double>(entry.second.constructed)));
+		counter->setValue(create("destroyed"),		create(static_cast<double>(entry.second.destroyed)));
+		types->setValue(create(entry.first),counter);
+	}
+	m->setValue(create("types"),types);
+	return m;
+}
+
 
 
 // ------------------------------------------------------------------
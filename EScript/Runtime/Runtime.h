@@ -6,9 +6,11 @@
 #define ES_RUNTIME_H
 
 #include "../Objects/ExtObject.h"
+#include "../Objects/Namespace.h"
 #include "../Utils/Logger.h"
 #include "../Utils/ObjRef.h"
 #include "../Utils/ObjArray.h"
+#include <chrono>
 #include <stack>
 #include <vector>
 #include <string>
@@ -17,6 +19,7 @@
 namespace EScript {
 
 class Exception;
+class Map;
 class RtValue;
 class StringData;
 class YieldIterator;
@@ -42,6 +45,28 @@ class Runtime : public ExtObject {
 
 	// ------------------------------------------------
 
+	//! @name Snapshots
+	//	@{
+	public:
+		/*! Image of the global environment of a Runtime: the bindings of its GLOBALS and its attributes
+			(e.g. the search paths and the files loaded by loadOnce(...)). A Runtime created from a Snapshot
+			starts in this environment without executing the initializing scripts again.
+			\note Like the bindings of SGLOBALS, the bound objects (Types, Namespaces, Functions, ...) are
+				shared by the original Runtime and all Runtimes created from the Snapshot. Only the bindings,
+				call-by-value objects and the Collections stored as Runtime attributes are copied.	*/
+		class Snapshot{
+				ERef<Namespace> globals;
+				ERef<ExtObject> attributes;
+				friend class Runtime;
+			public:
+				explicit Snapshot(Runtime & runtime);
+		};
+		//! Create a Runtime that starts in the environment stored in the snapshot.
+		explicit Runtime(const Snapshot & snapshot);
+	// @}
+
+	// ------------------------------------------------
+
 	//! @name Variables
 	//	@{
 	public:
@@ -73,6 +98,35 @@ class Runtime : public ExtObject {
 
 	// ------------------------------------------------
 
+	//! @name Execution budget
+	//	@{
+	public:
+		enum budgetAction_t{
+			BUDGET_EXCEPTION,	//!< an Exception is thrown in the script (it can be caught there)
+			BUDGET_SUSPEND		//!< the execution is suspended and can be continued by resumeExecution()
+		};
+		/*! Limit the further execution to @p maxInstructions instructions and @p maxSeconds seconds of wall-clock
+			time (0 means unlimited), counted from now. The budget is checked on jumps and user function calls.
+			When it is exceeded:
+			- BUDGET_EXCEPTION: An Exception is set at each checkpoint until the budget is renewed or cleared.
+			- BUDGET_SUSPEND: The outermost executeFunction(...), createInstance(...) or resumeExecution() returns
+				nullptr and isSuspended() is true. Executions started from native functions (e.g. callbacks)
+				and by yieldNext(...) are not interrupted; the suspension happens when the control is back
+				in the outermost execution. While suspended, no other function can be executed.	*/
+		void setExecutionBudget(uint64_t maxInstructions,double maxSeconds,budgetAction_t action = BUDGET_EXCEPTION);
+		void clearExecutionBudget();
+
+		bool isSuspended()const;
+		/*! Continue the suspended execution. Returns the result of the suspended function, or nullptr if it is
+			suspended again (the budget is not renewed implicitly).
+			\note throws an exception (Object *) on failure	*/
+		ObjRef resumeExecution();
+		//! Discard the suspended execution.
+		void abortSuspendedExecution();
+	//	@}
+
+	// ------------------------------------------------
+
 	//! @name Internal state / Exceptions
 	//	@{
 	public:
@@ -135,6 +189,49 @@ class Runtime : public ExtObject {
 		_CountedRef<LoggerGroup> logger;
 	//	@}
 
+	// ------------------------------------------------
+
+	//! @name Metrics
+	//	@{
+	public:
+		/*! Counters and gauges of the execution. They are always updated; each counted event costs
+			an increment. The counters of the objects and object pools are process-wide (see ObjectCounters).	*/
+		struct Metrics{
+			uint64_t instructionsExecuted;
+			uint64_t userFunctionCalls;
+			uint64_t nativeFunctionCalls;
+			uint64_t exceptionsThrown;		//!< exceptions set by scripts, native functions or the runtime itself
+			size_t maxStackSize;			//!< high-water mark of the number of active function call contexts
+			double compilationTime;			//!< seconds spent in parsing and compiling scripts
+			Metrics() : instructionsExecuted(0),userFunctionCalls(0),nativeFunctionCalls(0),exceptionsThrown(0),
+					maxStackSize(0),compilationTime(0){}
+		};
+		const Metrics & getMetrics()const;
+		void resetMetrics();
+
+		/*! Create a Map containing the metrics of the runtime and the process-wide object counters:
+			{	"instructionsExecuted" : Number, "userFunctionCalls" : Number, "nativeFunctionCalls" : Number,
+				"exceptionsThrown" : Number, "maxStackSize" : Number, "compilationTime" : Number (seconds),
+				"objectsConstructed" : Number, "objectsDestroyed" : Number,
+				"pools" : { typeName : { "hits" : Number, "misses" : Number, "released" : Number,
+										"poolSize" : Number, "hitRate" : Number (hits/(hits+misses)) } },
+				"types" : { typeName : { "constructed" : Number, "destroyed" : Number } }	}
+			"types" only contains the Types with at least one constructed instance.	*/
+		Map * createMetricsMap()const;
+
+		//! (internal) Adds the time between its creation and its destruction to the compilation time.
+		class CompilationTimer{
+				Runtime & runtime;
+				const std::chrono::steady_clock::time_point start;
+			public:
+				explicit CompilationTimer(Runtime & rt) : runtime(rt),start(std::chrono::steady_clock::now()){}
+				~CompilationTimer(){
+					runtime._addCompilationTime(std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count());
+				}
+		};
+		void _addCompilationTime(double seconds);
+	//	@}
+
 };
 }
 
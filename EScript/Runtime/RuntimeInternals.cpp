@@ -11,16 +11,22 @@
 #include "../Objects/Exception.h"
 #include "../Objects/YieldIterator.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <sstream>
+#include <vector>
 
 namespace EScript{
 
 //! (ctor)
-RuntimeInternals::RuntimeInternals(Runtime & rt) :
-		runtime(rt),stackSizeLimit(100000),state(STATE_NORMAL),addStackIngfoToExceptions(true){
+RuntimeInternals::RuntimeInternals(Runtime & rt,Namespace * baseGlobals) :
+		runtime(rt),stackSizeLimit(100000),executionDepth(0),suspendableExecution(false),
+		state(STATE_NORMAL),addStackIngfoToExceptions(true),
+		budgetCheckpoint(UINT64_MAX),budgetInstructionLimit(UINT64_MAX),budgetHasDeadline(false),
+		budgetAction(Runtime::BUDGET_EXCEPTION){
 	initSystemFunctions();
 
-	globals = EScript::getSGlobals()->clone();
+	globals = baseGlobals!=nullptr ? baseGlobals->clone() : Namespace::createOverlay(EScript::getSGlobals());
 	declareConstant(globals.get(),"GLOBALS",globals.get());
 	declareConstant(globals.get(),"SGLOBALS",EScript::getSGlobals());
 }
@@ -40,6 +46,11 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 
 //	std::cout << fcc->getInstructions().toString()<<"\n";
 
+	return continueExecution(fcc);
+}
+
+//! (internal) Execute the active function call contexts; @p fcc is the topmost one.
+ObjRef RuntimeInternals::continueExecution(_Ptr<FunctionCallContext> fcc){
 	while( true ){
 
 		const std::vector<Instruction> & instructions = fcc->getInstructions();
@@ -87,6 +98,7 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 		try{
 
 		const Instruction & instruction = *fcc->getInstructionCursor();
+		++metrics.instructionsExecuted;
 
 //		std::cout << "---\n";
 //		std::cout << fcc->getCaller().toString()<<"\n";
@@ -191,6 +203,8 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			if(result.isFunctionCallContext()){ // user function?
 				fcc = result._getFCC();
 				pushActiveFCC(fcc);
+				if(isBudgetCheckpointReached())
+					checkBudget();
 			}else{
 				fcc->stack_pushValue(std::move(result));
 			}
@@ -228,6 +242,8 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			if(result.isFunctionCallContext()){ // user constructor?
 				fcc = result._getFCC();
 				pushActiveFCC(fcc);
+				if(isBudgetCheckpointReached())
+					checkBudget();
 			}else{ // direct call to c++ constructor
 				fcc->stack_pushValue(std::move(result));
 			}
@@ -248,6 +264,33 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			fcc->increaseInstructionCursor();
 			break;
 		}
+		case Instruction::I_CONCAT:{
+			/*	concat (uint32_t) numParts
+				-------------
+				pop numParts * parts
+				while the (intermediate) result is a String using the native '+'
+					append the string representations of the remaining parts at once
+				otherwise call result.'+'(part)
+				push result (or jump to exception point)	*/
+			const uint32_t numParts = instruction.getValue_uint32();
+			std::vector<ObjRef> parts(numParts);
+			for(int i = static_cast<int>(numParts)-1;i>=0;--i )
+				parts[i] = std::move(fcc->stack_popObject());
+
+			ObjRef result( std::move(parts[0]) );
+			for(uint32_t i = 1; i<numParts && getState()==STATE_NORMAL; ++i){
+				if(String::_isNativeConcatenation(result.get())){
+					parts[i-1] = std::move(result);
+					result = String::concat(parts.data()+i-1, numParts-i+1);
+					break;
+				}
+				const ParameterValues params( parts[i].isNull() ? nullptr : parts[i]->getRefOrCopy() );
+				result = std::move(callMemberFunction(runtime,result,Consts::IDENTIFIER_fn_plus,params));
+			}
+			fcc->stack_pushValue(std::move(RtValue(std::move(result))));
+			fcc->increaseInstructionCursor();
+			break;
+		}
 		case Instruction::I_DUP:{
 			// duplicate topmost stack entry
 			fcc->stack_dup();
@@ -260,7 +303,7 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			if(fcc->getCaller().isNotNull()){
 				const Attribute & attr = fcc->getCaller()->getAttribute(instruction.getValue_Identifier());
 				if(attr.isNotNull()){
-					fcc->stack_pushObject(fcc->getCaller());
+					fcc->stack_pushBorrowedObject(fcc->getCaller().get());
 					fcc->stack_pushObject(attr.getValue());
 					fcc->increaseInstructionCursor();
 					continue;
@@ -268,7 +311,7 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			}
 			ObjPtr obj = getGlobalVariable(instruction.getValue_Identifier());
 			if(obj.isNotNull()){
-				fcc->stack_pushObject(globals.get());
+				fcc->stack_pushBorrowedObject(globals.get());
 				fcc->stack_pushObject(obj);
 			}else{
 				warn("Variable '"+instruction.getValue_Identifier().toString()+"' not found: ");
@@ -320,7 +363,7 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			/* 	getLocalVariable (uint32_t) variableIndex
 				------------
 				push $variableIndex	*/
-			fcc->stack_pushObject( fcc->getLocalVariable(instruction.getValue_uint32())) ;
+			fcc->stack_pushLocalVariable(instruction.getValue_uint32());
 			fcc->increaseInstructionCursor();
 			continue;
 		}
@@ -354,6 +397,8 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 						fcc->stack_pushObject( *it );
 					fcc->markAsConstructorCall(); // the result of the called super constructor should be used as this-object.
 					fcc->markAsProvidingCallerAsResult(); // providesCallerAsResult
+					if(isBudgetCheckpointReached())
+						checkBudget();
 
 				}else{
 					ObjPtr newObj = result.getObject();
@@ -379,6 +424,10 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 		}
 		case Instruction::I_JMP:{
 			fcc->setInstructionCursor( instruction.getValue_uint32() );
+			if(isBudgetCheckpointReached()){
+				checkBudget();
+				break;
+			}
 			continue;
 		}
 		case Instruction::I_JMP_IF_SET:{
@@ -393,17 +442,27 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 			continue;
 		}
 		case Instruction::I_JMP_ON_TRUE:{
-			if(fcc->stack_popBool())
+			if(fcc->stack_popBool()){
 				fcc->setInstructionCursor( instruction.getValue_uint32() );
-			else
+				if(isBudgetCheckpointReached()){
+					checkBudget();
+					break;
+				}
+			}else{
 				fcc->increaseInstructionCursor();
+			}
 			continue;
 		}
 		case Instruction::I_JMP_ON_FALSE:{
-			if(!fcc->stack_popBool())
+			if(!fcc->stack_popBool()){
 				fcc->setInstructionCursor( instruction.getValue_uint32() );
-			else
+				if(isBudgetCheckpointReached()){
+					checkBudget();
+					break;
+				}
+			}else{
 				fcc->increaseInstructionCursor();
+			}
 			continue;
 		}
 		case Instruction::I_NOT:{
@@ -581,6 +640,10 @@ ObjRef RuntimeInternals::executeFunctionCallContext(_Ptr<FunctionCallContext> fc
 						return nullptr;
 				}
 			}
+		} else if(getState()==STATE_SUSPENDED){
+			// keep the function call contexts until resumeExecution() is called; see checkBudget()
+			suspendedFCCs.swap(activeFCCs);
+			return nullptr;
 		} else if(getState()==STATE_EXITING){
 			while(true){
 				fcc->stack_clear();
@@ -611,6 +674,7 @@ RtValue RuntimeInternals::startFunctionExecution(const ObjPtr & fun,const ObjPtr
 	switch( fun->_getInternalTypeId() ){
 		case _TypeIds::TYPE_USER_FUNCTION:{
 			UserFunction * userFunction = static_cast<UserFunction*>(fun.get());
+			++metrics.userFunctionCalls;
 			_CountedRef<FunctionCallContext> fcc = FunctionCallContext::create(userFunction,_callingObject);
 
 			// check for too few parameter values -> throw exception
@@ -691,6 +755,7 @@ RtValue RuntimeInternals::startFunctionExecution(const ObjPtr & fun,const ObjPtr
 				}
 			}
 			libfun->increaseCallCounter();
+			++metrics.nativeFunctionCalls;
 
 			try {
 				return (*libfun->getFnPtr())(runtime,_callingObject.get(),pValues);
@@ -895,6 +960,75 @@ void RuntimeInternals::throwException(const std::string & s,Object * obj) {
 	throw e;
 }
 
+// -------------------------------------------------------------
+// Metrics
+
+void RuntimeInternals::resetMetrics(){
+	// the budget is measured in executed instructions -> move it along with the counter
+	const uint64_t executed = metrics.instructionsExecuted;
+	if(budgetCheckpoint!=UINT64_MAX)
+		budgetCheckpoint -= std::min(budgetCheckpoint,executed);
+	if(budgetInstructionLimit!=UINT64_MAX)
+		budgetInstructionLimit -= std::min(budgetInstructionLimit,executed);
+	metrics = Runtime::Metrics();
+	metrics.maxStackSize = activeFCCs.size();
+}
+
+// -------------------------------------------------------------
+// Execution budget
+
+//! Number of executed instructions after which the wall-clock time is checked.
+static const uint64_t BUDGET_TIME_CHECK_INTERVAL = 1024;
+
+void RuntimeInternals::setExecutionBudget(uint64_t maxInstructions,double maxSeconds,Runtime::budgetAction_t action){
+	budgetAction = action;
+	budgetInstructionLimit = maxInstructions>0 ? metrics.instructionsExecuted+maxInstructions : UINT64_MAX;
+	budgetHasDeadline = maxSeconds>0;
+	if(budgetHasDeadline){
+		budgetDeadline = std::chrono::steady_clock::now() +
+				std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(maxSeconds));
+		budgetCheckpoint = std::min(budgetInstructionLimit,metrics.instructionsExecuted+BUDGET_TIME_CHECK_INTERVAL);
+	}else{
+		budgetCheckpoint = budgetInstructionLimit;
+	}
+}
+
+void RuntimeInternals::clearExecutionBudget(){
+	budgetCheckpoint = budgetInstructionLimit = UINT64_MAX;
+	budgetHasDeadline = false;
+}
+
+void RuntimeInternals::checkBudget(){
+	const uint64_t executed = metrics.instructionsExecuted;
+	if(executed<budgetInstructionLimit && !(budgetHasDeadline && std::chrono::steady_clock::now()>=budgetDeadline)){
+		budgetCheckpoint = budgetHasDeadline ? std::min(budgetInstructionLimit,executed+BUDGET_TIME_CHECK_INTERVAL) : budgetInstructionLimit;
+		return;
+	}
+	if(budgetAction==Runtime::BUDGET_EXCEPTION){
+		// budgetCheckpoint is not moved -> each following checkpoint throws again until the budget is renewed
+		setException("Execution budget exceeded.");
+	}else if(executionDepth==1 && suspendableExecution){
+		state = STATE_SUSPENDED;
+	}else{ // suspend when the control is back in the outermost execution
+		budgetCheckpoint = executed+BUDGET_TIME_CHECK_INTERVAL;
+	}
+}
+
+ObjRef RuntimeInternals::resumeExecution(){
+	if(state!=STATE_SUSPENDED || suspendedFCCs.empty())
+		throwException("resumeExecution: No suspended execution.");
+	state = STATE_NORMAL;
+	activeFCCs.swap(suspendedFCCs);
+	return continueExecution(activeFCCs.back());
+}
+
+void RuntimeInternals::abortSuspendedExecution(){
+	if(state==STATE_SUSPENDED){
+		state = STATE_NORMAL;
+		suspendedFCCs.clear();
+	}
+}
+
 // -------------------------------------------------------------
 // System calls
 
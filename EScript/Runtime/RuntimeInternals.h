@@ -7,6 +7,7 @@
 
 #include "FunctionCallContext.h"
 #include "Runtime.h"
+#include <chrono>
 
 namespace EScript {
 class Function;
@@ -19,7 +20,9 @@ class RuntimeInternals  {
 	//	@{
 		RuntimeInternals(RuntimeInternals & other); // = delete
 	public:
-		RuntimeInternals(Runtime & rt);
+		/*! The globals are initialized with a clone of baseGlobals or, if nullptr, with a copy-on-write
+			overlay over SGLOBALS (see Namespace::createOverlay).	*/
+		RuntimeInternals(Runtime & rt,Namespace * baseGlobals = nullptr);
 		~RuntimeInternals();
 
 		void warn(const std::string & message)const;
@@ -41,6 +44,18 @@ class RuntimeInternals  {
 
 		ObjRef executeFunctionCallContext(_Ptr<FunctionCallContext> fcc);
 
+		/*! (internal) Counts the nested executions started by the Runtime (executeFunction, createInstance,
+			yieldNext, resumeExecution). Only the outermost execution can be suspended.	*/
+		class ExecutionEntry{
+				RuntimeInternals & ri;
+			public:
+				ExecutionEntry(RuntimeInternals & _ri,bool suspendable) : ri(_ri){
+					if(++ri.executionDepth==1)
+						ri.suspendableExecution = suspendable;
+				}
+				~ExecutionEntry()								{	--ri.executionDepth;	}
+		};
+
 		ObjPtr getCallingObject()const							{	return activeFCCs.empty() ? nullptr : activeFCCs.back()->getCaller();	}
 		size_t getStackSize()const								{	return activeFCCs.size();	}
 		size_t _getStackSizeLimit()const						{	return stackSizeLimit;	}
@@ -49,6 +64,10 @@ class RuntimeInternals  {
 	private:
 		std::vector<_CountedRef<FunctionCallContext> > activeFCCs;
 		size_t stackSizeLimit;
+		uint32_t executionDepth;
+		bool suspendableExecution;
+
+		ObjRef continueExecution(_Ptr<FunctionCallContext> fcc);
 
 		static bool checkParameterConstraint(Runtime & rt,const RtValue & value,const ObjPtr & constraint);
 		_Ptr<FunctionCallContext> getActiveFCC()const			{	return activeFCCs.empty() ? nullptr : activeFCCs.back();	}
@@ -56,6 +75,7 @@ class RuntimeInternals  {
 		void pushActiveFCC(const _Ptr<FunctionCallContext> & fcc) {
 			activeFCCs.push_back(fcc);
 			if(activeFCCs.size()>stackSizeLimit) stackSizeError();
+			if(activeFCCs.size()>metrics.maxStackSize) metrics.maxStackSize = activeFCCs.size();
 		}
 		void popActiveFCC()										{	activeFCCs.pop_back();	}
 		void stackSizeError();
@@ -89,7 +109,7 @@ class RuntimeInternals  {
 	//! @name Internal state / Exceptions
 	//	@{
 	public:
-		enum state_t{	STATE_NORMAL,STATE_EXITING,STATE_EXCEPTION	};
+		enum state_t{	STATE_NORMAL,STATE_EXITING,STATE_EXCEPTION,STATE_SUSPENDED	};
 		bool checkNormalState()const					{	return state==STATE_NORMAL;	}
 		
 		ObjRef fetchAndClearException(){
@@ -135,6 +155,7 @@ class RuntimeInternals  {
 		void setExceptionState(ObjRef value) {
 			resultValue = std::move(value);
 			state = STATE_EXCEPTION;
+			++metrics.exceptionsThrown;
 		}
 
 	private:
@@ -145,6 +166,44 @@ class RuntimeInternals  {
 
 	// --------------------
 
+	//! @name Metrics
+	//	@{
+	public:
+		Runtime::Metrics & getMetrics()					{	return metrics;	}
+		const Runtime::Metrics & getMetrics()const		{	return metrics;	}
+		void resetMetrics();
+	private:
+		Runtime::Metrics metrics;
+	//	@}
+
+	// --------------------
+
+	//! @name Execution budget
+	//	@{
+	public:
+		void setExecutionBudget(uint64_t maxInstructions,double maxSeconds,Runtime::budgetAction_t action);
+		void clearExecutionBudget();
+
+		bool isSuspended()const							{	return state==STATE_SUSPENDED;	}
+		ObjRef resumeExecution();
+		void abortSuspendedExecution();
+	private:
+		/*! The budget is checked on jumps and user function calls when metrics.instructionsExecuted reaches
+			budgetCheckpoint; without a budget, the checkpoint is never reached.	*/
+		uint64_t budgetCheckpoint;
+		uint64_t budgetInstructionLimit;
+		bool budgetHasDeadline;
+		std::chrono::steady_clock::time_point budgetDeadline;
+		Runtime::budgetAction_t budgetAction;
+		std::vector<_CountedRef<FunctionCallContext> > suspendedFCCs;
+
+		bool isBudgetCheckpointReached()const			{	return metrics.instructionsExecuted>=budgetCheckpoint;	}
+		//! Called at a checkpoint; sets the exception or the suspended state if the budget is exceeded.
+		void checkBudget();
+	//	@}
+
+	// --------------------
+
 	//! @name System calls
 	//	@{
 	//! (interna) Used by the Runtime.
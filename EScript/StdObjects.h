@@ -7,6 +7,10 @@
 
 #include "Objects/Collections/Array.h"
 #include "Objects/Collections/Map.h"
+#include "Objects/Collections/PriorityQueue.h"
+#include "Objects/Collections/SortedMap.h"
+#include "Objects/Collections/TypedArray.h"
+#include "Objects/Collections/Set.h"
 #include "Objects/Values/Number.h"
 #include "Objects/Values/Bool.h"
 #include "Objects/Values/String.h"
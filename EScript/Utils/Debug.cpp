@@ -31,6 +31,10 @@ void Debug::unRegisterObj(Object * v) {
 	--debug_objects_counter;
 	//std::cout << "-"<<&debug_objects;
 }
+bool Debug::isRegistered(Object * v) {
+	const auto it = debug_objects.find(reinterpret_cast<void *>(v));
+	return it==debug_objects.end() || it->second!=nullptr;
+}
 void Debug::showObjects() {
 	if(debug_objects_counter==0) return;
 	for(const auto & obj : debug_objects) {
@@ -14,6 +14,8 @@ class Debug {
 	public:
 		static void registerObj(Object * v);
 		static void unRegisterObj(Object * v);
+		//! Returns false iff @p v has been registered and unregistered since.
+		static bool isRegistered(Object * v);
 		static void showObjects();
 		static void clearObjects();
 };
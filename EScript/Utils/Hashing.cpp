@@ -6,12 +6,13 @@
 
 #include <cstddef>
 #include <functional>
-#include <map>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 
 namespace EScript{
 
-typedef std::map<identifierId,std::string> identifierDB;
+typedef std::unordered_map<identifierId,std::string> identifierDB;
 
 /**
  * (static) Returns the identifier database.
@@ -23,26 +24,33 @@ static identifierDB & getIdentifierDB(){
 	static identifierDB _identifier;
 	return _identifier;
 }
+
+//! (static) Guards the identifier database, as scripts may be parsed on several threads.
+static std::mutex & getIdentifierDBMutex(){
+	static std::mutex mutex;
+	return mutex;
+}
 const std::string ES_UNKNOWN_IDENTIFIER="[?]";
 
 //! (internal)
 hashvalue _hash( const std::string &  s) {
 	hashvalue h = 0;
-	for(size_t i = 0;i<s.length();++i)
-		h^=(((s.at(i)+h)*1234393)% 0xffffff);
+	for(const char c : s)
+		h^=(((c+h)*1234393)% 0xffffff);
 	return h;
 }
 
 identifierId stringToIdentifierId(const std::string & s){
+	std::lock_guard<std::mutex> lock(getIdentifierDBMutex());
 	identifierDB & db = getIdentifierDB();
 	identifierId id = _hash(s);
 	while(true){
-		identifierDB::iterator lbIt = db.lower_bound(id);
-		if(lbIt==db.end() || db.key_comp()(id, lbIt->first) ){
+		const identifierDB::const_iterator it = db.find(id);
+		if(it==db.end()){
 			// id not found -> insert it
-			db.insert(lbIt,std::make_pair(id,s));
+			db.emplace(id,s);
 			break;
-		}else if( s==lbIt->second){
+		}else if( s==it->second){
 			// same string already inserted
 			break;
 		}else {
@@ -54,7 +62,8 @@ identifierId stringToIdentifierId(const std::string & s){
 }
 
 const std::string & identifierIdToString(identifierId id){
-	 identifierDB & db = getIdentifierDB();
+	std::lock_guard<std::mutex> lock(getIdentifierDBMutex());
+	identifierDB & db = getIdentifierDB();
 
 	identifierDB::const_iterator it = db.find(id);
 	if(it == db.end() )
@@ -0,0 +1,43 @@
+// AbstractFileHandle.h
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifndef ABSTRACTFILEHANDLE_H
+#define ABSTRACTFILEHANDLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ios>
+
+namespace EScript{
+namespace IO{
+
+enum openMode_t{
+	MODE_READ,			//!< read an existing file
+	MODE_WRITE,			//!< create or truncate the file and write to it
+	MODE_APPEND,		//!< create the file or write at its end
+	MODE_READ_WRITE		//!< read and write an existing file
+};
+
+/*! Open file created by AbstractFileSystemHandler::openFile(...).
+	The file is closed when the handle is deleted.
+	All operations throw std::ios_base::failure on failure.	*/
+class AbstractFileHandle  {
+protected:
+	AbstractFileHandle(){}
+public:
+	virtual ~AbstractFileHandle(){}
+
+	//! Read up to size bytes into buffer. Returns the number of bytes read (0 at the end of the file).
+	virtual size_t read(char * buffer, size_t size) = 0;
+	virtual void write(const char * data, size_t size) = 0;
+	//! Set the position (in bytes from the beginning of the file).
+	virtual void seek(uint64_t position) = 0;
+	virtual uint64_t tell() = 0;
+	//! ---o
+	virtual void flush(){}
+};
+}
+}
+
+#endif // ABSTRACTFILEHANDLE_H
@@ -6,6 +6,7 @@
 #define ABSTRACTFILESYSTEMHANDLER_H
 
 #include "../StringData.h"
+#include "AbstractFileHandle.h"
 #include "IOBase.h"
 #include <cstddef>
 #include <cstdint>
@@ -24,7 +25,6 @@ namespace IO{
 	all operations to certain folders).
 	\todo
 		 - (?) add flush()
-		 - add streaming support
 	*/
 class AbstractFileSystemHandler  {
 protected:
@@ -45,6 +45,27 @@ public:
 	virtual std::vector<std::string> dir(const std::string & /*dirname*/, uint8_t /*flags*/) {
 		throw std::ios_base::failure("unsupported operation");
 	}
+	/*!	---o
+	 * Returns the entries of the directory (not recursive) together with their infos.
+	 * Like dir(...), entries whose names start with '.' are skipped.
+	 * The default implementation uses dir(...) and getEntryInfo(...).
+	 * \note If isThreadSafe() returns true, this function may be called by several threads at the
+	 *		same time (by an IO::DirectoryWalker with threads).
+	 * @throw std::ios_base::failure on failure.	*/
+	virtual std::vector<DirectoryEntry> readDir(const std::string & dirname) {
+		std::vector<DirectoryEntry> entries;
+		for(auto & path : dir(dirname,3)){
+			const EntryInfo info = getEntryInfo(path);
+			entries.emplace_back(std::move(path),info);
+		}
+		return entries;
+	}
+	/*!	---o
+	 * Returns true iff readDir(...) (and the functions it uses) may be called by several threads
+	 * at the same time. Otherwise, an IO::DirectoryWalker reads all directories in the calling thread.	*/
+	virtual bool isThreadSafe()const{
+		return false;
+	}
 	//! ---o
 	virtual entryType_t getEntryType(const std::string & path){
 		return getEntryInfo(path).type;
@@ -70,6 +91,12 @@ public:
 	virtual void makeDir(const std::string &){
 		throw std::ios_base::failure("unsupported operation");
 	}
+	/*!	---o
+	 * Open the file for streaming; the returned handle is owned by the caller.
+	 * @throw std::ios_base::failure on failure.	*/
+	virtual AbstractFileHandle * openFile(const std::string &, openMode_t /*mode*/){
+		throw std::ios_base::failure("unsupported operation");
+	}
 	//! ---o
 	virtual StringData loadFile(const std::string &){
 		throw std::ios_base::failure("unsupported operation");
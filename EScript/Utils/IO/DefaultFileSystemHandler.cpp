@@ -3,6 +3,7 @@
 // See copyright notice in EScript.h
 // ------------------------------------------------------
 #include "DefaultFileSystemHandler.h"
+#include <cstdio>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -14,44 +15,170 @@
 #include <dirent.h>
 #endif
 
+#if defined(__unix__) || defined(__APPLE__)
+#define ES_USE_POSIX_READ
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 
 namespace EScript{
 
 namespace IO{
 
+//! ---|> AbstractFileSystemHandler
+void DefaultFileSystemHandler::deleteFile(const std::string & filename){
+	if(getEntryType(filename)!=TYPE_FILE || std::remove(filename.c_str())!=0)
+		throw std::ios_base::failure(std::string("Could not delete file: '"+filename+'\''));
+}
+
 std::vector<std::string> DefaultFileSystemHandler::dir(const std::string & dirname, uint8_t flags) {
+	std::vector<std::string> files;
+	for(auto & entry : readDir(dirname)) {
+		const entryType_t type = entry.info.type;
+		if( (type==IO::TYPE_DIRECTORY && (flags & 2)) ||
+				( type==IO::TYPE_FILE && (flags & 1) )) {
+			files.push_back(entry.path);
+		}
+
+		if(type==IO::TYPE_DIRECTORY && (flags & 4)) { // recursive
+			const auto filesRecursive = dir(entry.path, flags);
+			files.insert(files.end(), filesRecursive.begin(), filesRecursive.end());
+		}
+	}
+	return files;
+}
 
+//! ---|> AbstractFileSystemHandler
+std::vector<DirectoryEntry> DefaultFileSystemHandler::readDir(const std::string & dirname) {
 	DIR *directoryHandle = opendir(dirname.c_str());
 	if(!directoryHandle)
 		throw std::ios_base::failure( std::string("Could not open dir: '"+dirname+'\''));
 
-	std::vector<std::string> files;
+	std::vector<DirectoryEntry> entries;
 	for( dirent * entry = readdir(directoryHandle) ; entry!=nullptr ; entry = readdir(directoryHandle)){
 		if(entry->d_name[0] == '.')
 			continue;
+		std::string entryName( dirname+'/'+entry->d_name );
+		const EntryInfo info = getEntryInfo(entryName);
+		entries.emplace_back(std::move(entryName),info);
+	}
+	closedir(directoryHandle);
+	return entries;
+}
 
-		const std::string entryName( dirname+'/'+entry->d_name );
-		const entryType_t type = getEntryType(entryName);
+//! (internal) DefaultFileHandle ---|> AbstractFileHandle
+class DefaultFileHandle : public AbstractFileHandle {
+	FILE * file;
+	const std::string filename;
+	enum { NONE, READING, WRITING } lastOperation;
+
+	/*! Switching between reading and writing requires a positioning operation
+		in between (C standard 7.21.5.3).	*/
+	void beginOperation(decltype(lastOperation) operation){
+		if(lastOperation!=operation && lastOperation!=NONE)
+			seek(tell());
+		lastOperation = operation;
+	}
+public:
+	DefaultFileHandle(FILE * _file,const std::string & _filename) :
+			file(_file),filename(_filename),lastOperation(NONE){}
+	virtual ~DefaultFileHandle(){
+		fclose(file);
+	}
 
-		if( (type==IO::TYPE_DIRECTORY && (flags & 2)) ||
-				( type==IO::TYPE_FILE && (flags & 1) )) {
-			files.push_back(entryName);
-		}
+	//! ---|> AbstractFileHandle
+	virtual size_t read(char * buffer, size_t size){
+		beginOperation(READING);
+		const size_t count = fread(buffer,1,size,file);
+		if(count<size && ferror(file))
+			throw std::ios_base::failure(std::string("Could not read from file: '"+filename+'\''));
+		return count;
+	}
+	//! ---|> AbstractFileHandle
+	virtual void write(const char * data, size_t size){
+		beginOperation(WRITING);
+		if(fwrite(data,1,size,file)!=size)
+			throw std::ios_base::failure(std::string("Could not write to file: '"+filename+'\''));
+	}
+	//! ---|> AbstractFileHandle
+	virtual void seek(uint64_t position){
+#if defined(_MSC_VER)
+		const int result = _fseeki64(file,static_cast<__int64>(position),SEEK_SET);
+#else
+		const int result = fseeko(file,static_cast<off_t>(position),SEEK_SET);
+#endif
+		if(result!=0)
+			throw std::ios_base::failure(std::string("Could not set the position in file: '"+filename+'\''));
+		lastOperation = NONE;
+	}
+	//! ---|> AbstractFileHandle
+	virtual uint64_t tell(){
+#if defined(_MSC_VER)
+		const int64_t position = _ftelli64(file);
+#else
+		const int64_t position = ftello(file);
+#endif
+		if(position<0)
+			throw std::ios_base::failure(std::string("Could not get the position in file: '"+filename+'\''));
+		return static_cast<uint64_t>(position);
+	}
+	//! ---|> AbstractFileHandle
+	virtual void flush(){
+		if(fflush(file)!=0)
+			throw std::ios_base::failure(std::string("Could not write to file: '"+filename+'\''));
+	}
+};
 
-		if(type==IO::TYPE_DIRECTORY && (flags & 4)) { // recursive
-			// std::cout << "Recusrive dir:"<<entryName<<"\n";
-			const auto filesRecursive = dir(entryName, flags);
-			files.insert(files.end(), filesRecursive.begin(), filesRecursive.end());
-		}
+//! ---|> AbstractFileSystemHandler
+AbstractFileHandle * DefaultFileSystemHandler::openFile(const std::string & filename, openMode_t mode){
+	const char * modeString = "rb";
+	switch(mode){
+		case MODE_WRITE:		modeString = "wb";	break;
+		case MODE_APPEND:		modeString = "ab";	break;
+		case MODE_READ_WRITE:	modeString = "r+b";	break;
+		case MODE_READ:
+		default:
+			break;
 	}
-	closedir(directoryHandle);
-	return files;
+	if(getEntryType(filename)==TYPE_DIRECTORY)
+		throw std::ios_base::failure(std::string("Could not open file: '"+filename+"' is a directory."));
+	FILE * file = fopen(filename.c_str(),modeString);
+	if(file==nullptr)
+		throw std::ios_base::failure(std::string("Could not open file: '"+filename+'\''));
+	return new DefaultFileHandle(file,filename);
 }
 
-
 //! ---|> AbstractFileSystemHandler
 StringData DefaultFileSystemHandler::loadFile(const std::string & filename){
-
+#if defined(ES_USE_POSIX_READ)
+	const int fd = ::open(filename.c_str(), O_RDONLY);
+	struct stat fileStat;
+	if( fd<0 || fstat(fd,&fileStat)!=0 || !S_ISREG(fileStat.st_mode) ){
+		if(fd>=0)
+			::close(fd);
+		throw std::ios_base::failure(std::string("Could not open file for reading: '"+filename+'\''));
+	}
+	const size_t size = static_cast<size_t>(fileStat.st_size);
+	std::string content(size,'\0');
+	size_t cursor = 0;
+	while(cursor<size){
+		const ssize_t count = ::read(fd, &content[cursor], size-cursor);
+		if(count<0){
+			if(errno==EINTR) // interrupted by a signal -> retry
+				continue;
+			::close(fd);
+			throw std::ios_base::failure(std::string("Could not read file: '"+filename+'\''));
+		}
+		if(count==0) // the file has been truncated
+			break;
+		cursor += static_cast<size_t>(count);
+	}
+	content.resize(cursor);
+	::close(fd);
+	return StringData(std::move(content));
+#else
 	std::ifstream inputFile( filename.c_str(), std::ios::in | std::ios::binary);
 	if( inputFile.fail())
 		throw std::ios_base::failure(std::string("Could not open file for reading: '"+filename+'\''));
@@ -64,12 +191,12 @@ StringData DefaultFileSystemHandler::loadFile(const std::string & filename){
 		return StringData();
 	}
 
-	char *pBuffer = new char[size+1];
-	inputFile.read( pBuffer, size );
+	std::string content(size,'\0');
+	inputFile.read( &content[0], size );
+	content.resize( static_cast<size_t>(inputFile.gcount()) );
 	inputFile.close();
-	StringData result(pBuffer,size);
-	delete [] pBuffer;
-	return result;
+	return StringData(std::move(content));
+#endif
 }
 
 //! ---|> AbstractFileSystemHandler
@@ -17,13 +17,26 @@ public:
 	DefaultFileSystemHandler(){}
 	virtual ~DefaultFileSystemHandler(){}
 
+	//! ---|> AbstractFileSystemHandler
+	virtual void deleteFile(const std::string &);
+
 	//! ---|> AbstractFileSystemHandler
 	virtual std::vector<std::string> dir(const std::string &, uint8_t);
 
+	//! ---|> AbstractFileSystemHandler
+	virtual std::vector<DirectoryEntry> readDir(const std::string &);
+
+	//! ---|> AbstractFileSystemHandler
+	virtual bool isThreadSafe()const	{	return true;	}
+
 	//! ---|> AbstractFileSystemHandler
 	virtual EntryInfo getEntryInfo(const std::string &);
 
 	//! ---|> AbstractFileSystemHandler
+	virtual AbstractFileHandle * openFile(const std::string &, openMode_t);
+
+	/*! ---|> AbstractFileSystemHandler
+		The file is read directly into the resulting StringData.	*/
 	virtual StringData loadFile(const std::string &);
 
 	//! ---|> AbstractFileSystemHandler
@@ -0,0 +1,211 @@
+// DirectoryWalker.cpp
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#include "DirectoryWalker.h"
+#include "AbstractFileSystemHandler.h"
+#include "IO.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace EScript{
+namespace IO{
+
+static const uint32_t MAX_NUM_THREADS = 16;
+//! Workers pause while more than this number of entries are waiting to be fetched.
+static const size_t MAX_QUEUED_ENTRIES = 1<<16;
+
+//! (internal) Reads the directories using several threads.
+struct DirectoryWalker::ParallelWalk{
+	const DirectoryWalker & walker;
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::deque<std::string> pendingDirectories;
+	std::deque<DirectoryEntry> entries;
+	uint32_t numBusyWorkers;
+	bool stop;
+	std::vector<std::thread> workers;
+
+	ParallelWalk(const DirectoryWalker & _walker) : walker(_walker),numBusyWorkers(0),stop(false){}
+	~ParallelWalk(){
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stop = true;
+		}
+		condition.notify_all();
+		for(auto & worker : workers)
+			worker.join();
+	}
+	bool isFinished()const{
+		return pendingDirectories.empty() && numBusyWorkers==0;
+	}
+	//! Called with locked mutex.
+	void addEntries(std::vector<DirectoryEntry> && newEntries){
+		for(auto & entry : newEntries){
+			if(entry.info.type==TYPE_DIRECTORY && (walker.flags & 4))
+				pendingDirectories.push_back(entry.path);
+			if(walker.isRequested(entry))
+				entries.push_back(std::move(entry));
+		}
+	}
+	void work(){
+		std::unique_lock<std::mutex> lock(mutex);
+		while(true){
+			condition.wait(lock,[this]{
+				return stop || isFinished() || (!pendingDirectories.empty() && entries.size()<MAX_QUEUED_ENTRIES);
+			});
+			if(stop || isFinished())
+				break;
+			const std::string dirname = std::move(pendingDirectories.front());
+			pendingDirectories.pop_front();
+			++numBusyWorkers;
+			lock.unlock();
+			std::vector<DirectoryEntry> newEntries;
+			try{
+				newEntries = getFileSystemHandler()->readDir(dirname);
+			}catch(const std::ios_base::failure &){ // skip unreadable directories
+			}
+			lock.lock();
+			addEntries(std::move(newEntries));
+			--numBusyWorkers;
+			condition.notify_all();
+		}
+		condition.notify_all();
+	}
+	bool next(DirectoryEntry & entry){
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock,[this]{	return !entries.empty() || isFinished();	});
+		if(entries.empty())
+			return false;
+		entry = std::move(entries.front());
+		entries.pop_front();
+		if(entries.size()+1==MAX_QUEUED_ENTRIES)
+			condition.notify_all();
+		return true;
+	}
+};
+
+DirectoryWalker::DirectoryWalker(const std::string & dirname,uint8_t _flags,const std::string & _pattern,uint32_t numThreads) :
+		flags(_flags),pattern(_pattern){
+	AbstractFileSystemHandler * handler = getFileSystemHandler();
+	std::vector<DirectoryEntry> entries = handler->readDir(dirname);
+	if(numThreads==0 || !handler->isThreadSafe()){
+		stack.emplace_back(std::move(entries));
+	}else{
+		parallelWalk.reset(new ParallelWalk(*this));
+		parallelWalk->addEntries(std::move(entries));
+		if(!parallelWalk->pendingDirectories.empty()){
+			for(uint32_t i=0; i<std::min(numThreads,MAX_NUM_THREADS); ++i)
+				parallelWalk->workers.emplace_back(&ParallelWalk::work,parallelWalk.get());
+		}
+	}
+}
+
+DirectoryWalker::~DirectoryWalker() = default;
+
+//! (internal)
+bool DirectoryWalker::isRequested(const DirectoryEntry & entry)const{
+	if( !( (entry.info.type==TYPE_FILE && (flags & 1)) || (entry.info.type==TYPE_DIRECTORY && (flags & 2)) ) )
+		return false;
+	if(pattern.empty())
+		return true;
+	const size_t slash = entry.path.find_last_of('/');
+	return matchesPattern(pattern, slash==std::string::npos ? entry.path : entry.path.substr(slash+1));
+}
+
+bool DirectoryWalker::next(DirectoryEntry & entry){
+	if(parallelWalk)
+		return parallelWalk->next(entry);
+	while(!stack.empty()){
+		Frame & frame = stack.back();
+		if(frame.index>=frame.entries.size()){
+			stack.pop_back();
+			continue;
+		}
+		DirectoryEntry & current = frame.entries[frame.index++];
+		const bool recurse = current.info.type==TYPE_DIRECTORY && (flags & 4);
+		const std::string subdirectory = recurse ? current.path : std::string();
+		const bool requested = isRequested(current);
+		if(requested)
+			entry = std::move(current);
+		if(recurse){
+			try{
+				stack.emplace_back(getFileSystemHandler()->readDir(subdirectory)); // invalidates frame and current
+			}catch(const std::ios_base::failure &){ // skip unreadable directories
+			}
+		}
+		if(requested)
+			return true;
+	}
+	return false;
+}
+
+//! (internal) Matches c against the set starting at pattern[pos]=='['; pos is moved behind the set.
+static bool matchesSet(const std::string & pattern,size_t & pos,char c){
+	size_t cursor = pos+1;
+	const bool negated = cursor<pattern.size() && pattern[cursor]=='!';
+	if(negated)
+		++cursor;
+	bool found = false;
+	bool first = true;
+	for(; cursor<pattern.size() && (first || pattern[cursor]!=']'); ++cursor,first=false){
+		if(cursor+2<pattern.size() && pattern[cursor+1]=='-' && pattern[cursor+2]!=']'){
+			found |= (c>=pattern[cursor] && c<=pattern[cursor+2]);
+			cursor += 2;
+		}else{
+			found |= (c==pattern[cursor]);
+		}
+	}
+	if(cursor>=pattern.size()){ // no closing ']' -> match '[' literally
+		++pos;
+		return c=='[';
+	}
+	pos = cursor+1;
+	return found!=negated;
+}
+
+//! (static)
+bool DirectoryWalker::matchesPattern(const std::string & pattern,const std::string & name){
+	size_t p = 0, n = 0;
+	size_t starP = std::string::npos, starN = 0; // position after the last '*' and the matching name position
+	while(n<name.size()){
+		if(p<pattern.size()){
+			const char pc = pattern[p];
+			if(pc=='*'){
+				starP = ++p;
+				starN = n;
+				continue;
+			}
+			size_t nextP = p;
+			bool matches;
+			if(pc=='?'){
+				matches = true;
+				++nextP;
+			}else if(pc=='['){
+				matches = matchesSet(pattern,nextP,name[n]);
+			}else{
+				matches = pc==name[n];
+				++nextP;
+			}
+			if(matches){
+				p = nextP;
+				++n;
+				continue;
+			}
+		}
+		if(starP==std::string::npos)
+			return false;
+		// let the last '*' consume one more character
+		p = starP;
+		n = ++starN;
+	}
+	while(p<pattern.size() && pattern[p]=='*')
+		++p;
+	return p==pattern.size();
+}
+
+}
+}
@@ -0,0 +1,62 @@
+// DirectoryWalker.h
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifndef DIRECTORYWALKER_H
+#define DIRECTORYWALKER_H
+
+#include "IOBase.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace EScript{
+namespace IO{
+
+/*! Lazily enumerates the entries of a directory (and its subdirectories) using the
+	AbstractFileSystemHandler::readDir(...) of the current file system handler.
+	Only the directories that are currently needed are read, so arbitrarily large trees
+	can be traversed with bounded memory.
+	- flags: 1 ... Files, 2 ... Directories, 4 ... Recurse Subdirectories (like IO::getFilesInDir)
+	- pattern: if not empty, only entries whose name (the part after the last '/') matches the
+		glob pattern are returned (see matchesPattern). Subdirectories are traversed nevertheless.
+	- numThreads: if >0, the directories are read by the given number of threads and the entries
+		are returned in an unspecified order. Otherwise, the order is the same as IO::getFilesInDir.
+		\note The threads call readDir(...) of the file system handler at the same time. This is only
+		done if the handler's isThreadSafe() returns true; otherwise, numThreads is ignored and the
+		directories are read sequentially in the calling thread.
+	Subdirectories that can not be read are skipped.	*/
+class DirectoryWalker{
+	public:
+		/*! @throw std::ios_base::failure if the directory can not be read.	*/
+		DirectoryWalker(const std::string & dirname,uint8_t flags,const std::string & pattern = "",uint32_t numThreads = 0);
+		~DirectoryWalker();
+
+		//! Get the next entry. Returns false if all entries have been returned.
+		bool next(DirectoryEntry & entry);
+
+		/*! Glob matching:	'*' matches any sequence of characters, '?' any single character,
+			'[abc]', '[a-z]' and '[!abc]' a character of (or not of) the given set.	*/
+		static bool matchesPattern(const std::string & pattern,const std::string & name);
+
+	private:
+		const uint8_t flags;
+		const std::string pattern;
+
+		struct Frame{
+			std::vector<DirectoryEntry> entries;
+			size_t index;
+			Frame(std::vector<DirectoryEntry> && _entries) : entries(std::move(_entries)),index(0){}
+		};
+		std::vector<Frame> stack; //!< sequential mode
+
+		struct ParallelWalk;
+		std::unique_ptr<ParallelWalk> parallelWalk;
+
+		bool isRequested(const DirectoryEntry & entry)const;
+};
+}
+}
+
+#endif // DIRECTORYWALKER_H
@@ -28,11 +28,21 @@ StringData IO::loadFile(const std::string & filename) {
 	return getFileSystemHandler()->loadFile(filename);
 }
 
+//! (static)
+IO::AbstractFileHandle * IO::openFile(const std::string & filename,openMode_t mode) {
+	return getFileSystemHandler()->openFile(filename,mode);
+}
+
 //! (static)
 void IO::saveFile(const std::string & filename,const std::string & content,bool overwrite){
 	getFileSystemHandler()->saveFile(filename,content,overwrite);
 }
 
+//! (static)
+void IO::deleteFile(const std::string & filename){
+	getFileSystemHandler()->deleteFile(filename);
+}
+
 //! (static)
 uint32_t IO::getFileMTime(const std::string& filename) {
 	return getFileSystemHandler()->getFileMTime(filename);
@@ -6,6 +6,7 @@
 #define UTILS_IO_H
 
 #include "../StringData.h"
+#include "AbstractFileHandle.h"
 #include "IOBase.h"
 #include <cstddef>
 #include <cstdint>
@@ -23,8 +24,15 @@ void setFileSystemHandler(AbstractFileSystemHandler * handler);
 AbstractFileSystemHandler * getFileSystemHandler();
 
 StringData loadFile(const std::string & filename);
+
+/*! Open the file for streaming; the returned handle is owned by the caller.
+ * @throw std::ios_base::failure on failure.	*/
+AbstractFileHandle * openFile(const std::string & filename,openMode_t mode);
 void saveFile(const std::string & filename,const std::string & content,bool overwrite=true);
 
+/*! @throw std::ios_base::failure on failure.	*/
+void deleteFile(const std::string & filename);
+
 /*! @param filename
  *	@return file modification Time	*/
 uint32_t getFileMTime(const std::string& filename);
@@ -6,6 +6,7 @@
 #define IOBASE_H_INCLUDED
 #include <cstddef>
 #include <cstdint>
+#include <string>
 
 namespace EScript {
 namespace IO {
@@ -23,6 +24,12 @@ struct EntryInfo{
 	uint32_t cTime;
 	EntryInfo():fileSize(0),type(TYPE_UNKNOWN),mTime(0),cTime(0){}
 };
+struct DirectoryEntry{
+	std::string path;
+	EntryInfo info;
+	DirectoryEntry(){}
+	DirectoryEntry(std::string _path,const EntryInfo & _info):path(std::move(_path)),info(_info){}
+};
 
 
 }
@@ -0,0 +1,227 @@
+// OrderedHashTable.h
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifndef ES_ORDERED_HASH_TABLE_H
+#define ES_ORDERED_HASH_TABLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace EScript {
+
+/*! [OrderedHashTable]
+	Hash table (open addressing, linear probing) whose entries are stored in insertion order.
+	- Key_T has to provide 'size_t getHash()const' and 'operator=='.
+	- The entries are addressed by a position (0...getEndPosition()) that is stable until the table is rehashed
+		after removing many entries. Removed entries leave a gap that is skipped by the iteration.
+	- Whenever the positions of the entries change (compaction, sorting, clearing, swapping), the layout version
+		is increased.	*/
+template<typename Key_T, typename Value_T>
+class OrderedHashTable{
+	public:
+		struct Entry{
+			Key_T key;
+			Value_T value;
+			size_t hash;
+			bool removed;
+			Entry(const Key_T & _key,size_t _hash) : key(_key),value(),hash(_hash),removed(false){}
+		};
+
+		template<typename Table_T, typename ValueRef_T>
+		class _Iterator{
+				Table_T * table;
+				size_t pos;
+			public:
+				_Iterator(Table_T * _table,size_t _pos) : table(_table),pos(_table->skipRemoved(_pos)){}
+				ValueRef_T operator*()const					{	return table->entries[pos].value;	}
+				const Key_T & key()const					{	return table->entries[pos].key;	}
+				size_t getPosition()const					{	return pos;	}
+				_Iterator & operator++()					{	pos = table->skipRemoved(pos+1); return *this;	}
+				bool operator==(const _Iterator & other)const	{	return pos==other.pos;	}
+				bool operator!=(const _Iterator & other)const	{	return pos!=other.pos;	}
+		};
+		typedef _Iterator<OrderedHashTable,Value_T&> iterator;
+		typedef _Iterator<const OrderedHashTable,const Value_T&> const_iterator;
+		typedef size_t size_type;
+		static const size_t INVALID_POSITION = static_cast<size_t>(-1);
+
+	private:
+		enum : uint32_t{
+			BUCKET_EMPTY = 0,
+			BUCKET_REMOVED = 1,
+			BUCKET_OFFSET = 2 //!< buckets[i] := entry position + BUCKET_OFFSET
+		};
+
+		std::vector<Entry> entries;
+		std::vector<uint32_t> buckets; //!< size is 0 or a power of two
+		size_t numRemovedEntries;
+		size_t numRemovedBuckets;
+		size_t layoutVersion;
+
+		size_t findBucket(const Key_T & key,size_t hash)const{
+			if(buckets.empty())
+				return INVALID_POSITION;
+			const size_t mask = buckets.size()-1;
+			for(size_t i = hash&mask; ; i = (i+1)&mask){
+				const uint32_t b = buckets[i];
+				if(b==BUCKET_EMPTY)
+					return INVALID_POSITION;
+				if(b!=BUCKET_REMOVED){
+					const Entry & entry = entries[b-BUCKET_OFFSET];
+					if(entry.hash==hash && entry.key==key)
+						return i;
+				}
+			}
+		}
+		void insertIntoBuckets(size_t hash,size_t pos){
+			const size_t mask = buckets.size()-1;
+			size_t i = hash&mask;
+			while(buckets[i]!=BUCKET_EMPTY && buckets[i]!=BUCKET_REMOVED)
+				i = (i+1)&mask;
+			if(buckets[i]==BUCKET_REMOVED)
+				--numRemovedBuckets;
+			buckets[i] = static_cast<uint32_t>(pos+BUCKET_OFFSET);
+		}
+		/*! Remove the gaps (if there are many and @p compact is true) and recreate the buckets for
+			at least @p minCapacity entries.	*/
+		void rehash(size_t minCapacity,bool compact = true){
+			if(compact && numRemovedEntries>0 && numRemovedEntries*2 >= entries.size()){
+				std::vector<Entry> compacted;
+				compacted.reserve(entries.size()-numRemovedEntries);
+				for(auto & entry : entries){
+					if(!entry.removed)
+						compacted.emplace_back(std::move(entry));
+				}
+				entries.swap(compacted);
+				numRemovedEntries = 0;
+				++layoutVersion;
+			}
+			size_t numBuckets = 8;
+			while(numBuckets*3 < minCapacity*4)
+				numBuckets *= 2;
+			buckets.assign(numBuckets,static_cast<uint32_t>(BUCKET_EMPTY));
+			numRemovedBuckets = 0;
+			for(size_t pos = 0; pos<entries.size(); ++pos){
+				if(!entries[pos].removed)
+					insertIntoBuckets(entries[pos].hash,pos);
+			}
+		}
+		size_t skipRemoved(size_t pos)const{
+			while(pos<entries.size() && entries[pos].removed)
+				++pos;
+			return pos;
+		}
+
+	public:
+		OrderedHashTable() : numRemovedEntries(0),numRemovedBuckets(0),layoutVersion(0){}
+
+		iterator begin()							{	return iterator(this,0);	}
+		const_iterator begin()const					{	return const_iterator(this,0);	}
+		iterator end()								{	return iterator(this,entries.size());	}
+		const_iterator end()const					{	return const_iterator(this,entries.size());	}
+
+		bool empty()const							{	return size()==0;	}
+		size_t size()const							{	return entries.size()-numRemovedEntries;	}
+		size_t getLayoutVersion()const				{	return layoutVersion;	}
+
+		void clear(){
+			entries.clear();
+			buckets.clear();
+			numRemovedEntries = 0;
+			numRemovedBuckets = 0;
+			++layoutVersion;
+		}
+		void reserve(size_t capacity){
+			entries.reserve(capacity);
+			if(buckets.size()*3 < capacity*4)
+				rehash(capacity);
+		}
+		void swap(OrderedHashTable & other){
+			entries.swap(other.entries);
+			buckets.swap(other.buckets);
+			std::swap(numRemovedEntries,other.numRemovedEntries);
+			std::swap(numRemovedBuckets,other.numRemovedBuckets);
+			++layoutVersion;
+			++other.layoutVersion;
+		}
+
+		//! Returns the position of the entry with the given key or INVALID_POSITION.
+		size_t find(const Key_T & key)const{
+			const size_t bucket = findBucket(key,key.getHash());
+			return bucket==INVALID_POSITION ? INVALID_POSITION : buckets[bucket]-BUCKET_OFFSET;
+		}
+		Value_T * findValue(const Key_T & key){
+			const size_t pos = find(key);
+			return pos==INVALID_POSITION ? nullptr : &entries[pos].value;
+		}
+		const Value_T * findValue(const Key_T & key)const{
+			const size_t pos = find(key);
+			return pos==INVALID_POSITION ? nullptr : &entries[pos].value;
+		}
+
+		/*! Returns the value of the entry with the given key; if no such entry exists, a new entry with a
+			default constructed value is appended. The second value is true iff the entry is new.
+			If @p compact is false, the positions of the existing entries are not changed.	*/
+		std::pair<Value_T*,bool> insert(const Key_T & key,bool compact = true){
+			const size_t hash = key.getHash();
+			const size_t bucket = findBucket(key,hash);
+			if(bucket!=INVALID_POSITION)
+				return std::make_pair(&entries[buckets[bucket]-BUCKET_OFFSET].value,false);
+			if( (size()+numRemovedBuckets+1)*4 > buckets.size()*3 )
+				rehash(size()+1,compact);
+			entries.emplace_back(key,hash);
+			insertIntoBuckets(hash,entries.size()-1);
+			return std::make_pair(&entries.back().value,true);
+		}
+
+		//! Reorder the entries by comparing their keys using @p less; the positions of all entries change.
+		template<typename Compare_T>
+		void sortByKey(Compare_T less){
+			std::vector<Entry> sorted;
+			sorted.reserve(size());
+			for(auto & entry : entries){
+				if(!entry.removed)
+					sorted.emplace_back(std::move(entry));
+			}
+			std::sort(sorted.begin(),sorted.end(),[&less](const Entry & a,const Entry & b){	return less(a.key,b.key);	});
+			entries.swap(sorted);
+			numRemovedEntries = 0;
+			++layoutVersion;
+			rehash(entries.size());
+		}
+
+		/*! Returns true iff an entry has been removed.
+			If @p compact is false, the positions of the remaining entries are not changed.	*/
+		bool erase(const Key_T & key,bool compact = true){
+			const size_t bucket = findBucket(key,key.getHash());
+			if(bucket==INVALID_POSITION)
+				return false;
+			Entry & entry = entries[buckets[bucket]-BUCKET_OFFSET];
+			buckets[bucket] = BUCKET_REMOVED;
+			++numRemovedBuckets;
+			entry.removed = true;
+			entry.key = Key_T();
+			entry.value = Value_T();
+			++numRemovedEntries;
+			if(size()==0 && compact)
+				clear();
+			return true;
+		}
+
+		//! @name Position based access (used by iterators of the scripting objects)
+		// @{
+		size_t getEndPosition()const							{	return entries.size();	}
+		//! Returns the first position >= pos of an entry that has not been removed (or getEndPosition()).
+		size_t getValidPosition(size_t pos)const				{	return skipRemoved(pos);	}
+		const Key_T & getKey(size_t pos)const					{	return entries[pos].key;	}
+		Value_T & getValue(size_t pos)							{	return entries[pos].value;	}
+		const Value_T & getValue(size_t pos)const				{	return entries[pos].value;	}
+		// @}
+};
+
+}
+#endif // ES_ORDERED_HASH_TABLE_H
@@ -7,11 +7,19 @@
 
 #include "../Objects/Callables/UserFunction.h"
 #include "../Objects/Exception.h"
+#include "../Compiler/AST/Block.h"
 #include "../Compiler/Compiler.h"
+#include "../Compiler/Parser.h"
 #include "../Runtime/Runtime.h"
 #include "IO/IO.h"
+#include "IO/AbstractFileSystemHandler.h"
 #include "../Consts.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <sstream>
+#include <system_error>
+#include <thread>
 
 namespace EScript {
 
@@ -73,8 +81,12 @@ ObjRef callFunction(Runtime & runtime, Object * function, const ParameterValues
 
 //! (static)
 ObjRef _eval(Runtime & runtime, const CodeFragment & code){
-	Compiler compiler(runtime.getLogger());
-	ERef<UserFunction> script = compiler.compile(code);
+	ERef<UserFunction> script;
+	{
+		Runtime::CompilationTimer timer(runtime);
+		Compiler compiler(runtime.getLogger());
+		script = compiler.compile(code);
+	}
 	if(script.isNull())
 		return nullptr;
 	return runtime.executeFunction(script.get(),nullptr,ParameterValues());
@@ -104,6 +116,107 @@ std::pair<bool, ObjRef> loadAndExecute(Runtime & runtime, const std::string & fi
 //		return std::make_pair(false, result.detachAndDecrease());
 }
 
+static const uint32_t MAX_NUM_PARSER_THREADS = 16;
+
+//! (internal) Keeps the messages of a parser running on a worker thread until they can be passed to the runtime's logger.
+class RecordingLogger : public Logger {
+	public:
+		std::vector<std::pair<level_t,std::string>> messages;
+	private:
+		//! ---|> Logger
+		virtual void doLog(level_t l,const std::string & msg)	{	messages.emplace_back(l,msg);	}
+};
+
+//! (internal) A file that is loaded and parsed by precompileFiles(...).
+struct ParsedFile{
+	CodeFragment code;
+	ERef<AST::Block> syntaxTree;
+	_CountedRef<RecordingLogger> logger;
+	std::exception_ptr error;
+	double parsingTime; //!< seconds
+	ParsedFile() : logger(new RecordingLogger),parsingTime(0.0){}
+};
+
+//! (static,internal) May be called on a worker thread if the file system handler is thread safe.
+static void load(const std::string & filename,ParsedFile & file){
+	try{
+		file.code = CodeFragment(StringId(filename),IO::loadFile(filename));
+	}catch(...){
+		file.error = std::current_exception();
+	}
+}
+
+//! (static,internal) Called on a worker thread; must not create or access Objects (except for the parser's exceptions).
+static void parse(ParsedFile & file){
+	if(file.error)
+		return;
+	const auto start = std::chrono::steady_clock::now();
+	try{
+		Parser parser(file.logger.get());
+		file.syntaxTree = parser.parse(file.code);
+	}catch(...){
+		file.error = std::current_exception();
+	}
+	file.parsingTime = std::chrono::duration<double>(std::chrono::steady_clock::now()-start).count();
+}
+
+//! (static)
+std::vector<std::pair<ObjRef,std::exception_ptr>> precompileFiles(Runtime & runtime, const std::vector<std::string> & filenames, uint32_t numThreads){
+	std::vector<ParsedFile> files(filenames.size());
+	// files can only be loaded by the worker threads if the file system handler supports it
+	const bool parallelLoading = IO::getFileSystemHandler()->isThreadSafe();
+	if(!parallelLoading){
+		for(size_t i = 0; i<files.size(); ++i)
+			load(filenames[i],files[i]);
+	}
+	{	// (load and) parse
+		if(numThreads==0)
+			numThreads = std::max(std::thread::hardware_concurrency(),1u);
+		numThreads = std::min(numThreads,std::min(MAX_NUM_PARSER_THREADS,static_cast<uint32_t>(filenames.size())));
+		std::atomic<size_t> nextFile(0);
+		auto work = [&](){
+			for(size_t i = nextFile++; i<files.size(); i = nextFile++){
+				if(parallelLoading)
+					load(filenames[i],files[i]);
+				parse(files[i]);
+			}
+		};
+		std::vector<std::thread> workers;
+		try{
+			for(uint32_t i=1; i<numThreads; ++i)
+				workers.emplace_back(work);
+		}catch(const std::system_error &){ // no more threads available -> continue with the running ones
+		}
+		work();
+		for(auto & worker : workers)
+			worker.join();
+	}
+	// only the parsing counts as compilation time (summed over all threads), not the loading of the files
+	double parsingTime = 0.0;
+	for(const auto & file : files)
+		parsingTime += file.parsingTime;
+	runtime._addCompilationTime(parsingTime);
+
+	// compile the syntax trees on this thread; Objects must only be created by the runtime's thread.
+	Runtime::CompilationTimer timer(runtime);
+	std::vector<std::pair<ObjRef,std::exception_ptr>> results;
+	results.reserve(files.size());
+	Compiler compiler(runtime.getLogger());
+	for(auto & file : files){
+		for(const auto & message : file.logger->messages)
+			runtime.log(message.first,message.second);
+		if(file.error){
+			results.emplace_back(nullptr,file.error);
+			continue;
+		}
+		try{
+			results.emplace_back(compiler.compile(file.code,file.syntaxTree.get()),nullptr);
+		}catch(...){
+			results.emplace_back(nullptr,std::current_exception());
+		}
+	}
+	return results;
+}
 
 //! (static)
 std::pair<bool, ObjRef> eval(Runtime & runtime, const StringData & code,const StringId & fileId) {
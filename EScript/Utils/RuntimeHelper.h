@@ -7,9 +7,12 @@
 
 #include "StringId.h"
 #include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <iosfwd>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace EScript {
 // ------------------------------------------
@@ -89,6 +92,17 @@ ObjRef _loadAndExecute(Runtime & runtime, const std::string & filename);
 //! @return (success, result)
 std::pair<bool, ObjRef> loadAndExecute(Runtime & runtime, const std::string & filename);
 
+/*! Load, tokenize and parse the given files on up to @p numThreads threads (0: one per hardware thread; the
+	calling thread takes part) and then compile them one after another on the calling thread.
+	The parser's messages are passed to the runtime's logger in the order of the files.
+	For each file, (compiled script, void) or (void, error) is returned; the script is a UserFunction that can be
+	executed by runtime.executeFunction(script,nullptr,ParameterValues()), the error (e.g. an Exception Object* or
+	a std::ios_base::failure) can be thrown again by std::rethrow_exception. A thrown Exception Object is owned
+	by the caller, who has to release it (e.g. by catching it as ObjRef) if it is not thrown again.
+	\note The files are only loaded concurrently if the file system handler is thread safe; otherwise, they
+		are loaded one after another on the calling thread and only the parsing is done in parallel.	*/
+std::vector<std::pair<ObjRef,std::exception_ptr>> precompileFiles(Runtime & runtime, const std::vector<std::string> & filenames, uint32_t numThreads = 0);
+
 //! creates and throws an Exception objects.
 void throwRuntimeException(const std::string & what);
 
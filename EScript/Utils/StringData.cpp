@@ -3,6 +3,9 @@
 // See copyright notice in EScript.h
 // ------------------------------------------------------
 #include "StringData.h"
+#include "UTF8.h"
+#include <algorithm>
+#include <functional>
 #include <iostream>
 #include <cassert>
 
@@ -11,52 +14,29 @@ namespace EScript{
 
 // (internals)
 
-std::stack<StringData::Data*> StringData::dataPool;
-
 //! (static,internal)
 StringData::Data * StringData::createData(const std::string & s){
-	if(s.empty())
-		return getEmptyData();
-	else if(dataPool.empty()){
-		return new Data(s,Data::UNKNOWN_UNICODE);
-	}else{
-		Data * d = dataPool.top();
-		dataPool.pop();
-		d->s = s;
-		d->dataType = Data::UNKNOWN_UNICODE;
-		d->numCodePoints = 0;
-		return d;
-	}
+	return s.empty() ? getEmptyData() : new Data(s,Data::UNKNOWN_UNICODE);
+}
+//! (static,internal)
+StringData::Data * StringData::createData(std::string && s){
+	return s.empty() ? getEmptyData() : new Data(std::move(s),Data::UNKNOWN_UNICODE);
 }
 //! (static,internal)
 StringData::Data * StringData::createData(const char * c,size_t size){
-	if(size==0)
-		return getEmptyData();
-	else if(dataPool.empty()){
-		return new Data(c,size,Data::UNKNOWN_UNICODE);
-	}else{
-		Data * d = dataPool.top();
-		dataPool.pop();
-		std::string s(c,size);
-		d->s.swap(s);
-		d->dataType = Data::UNKNOWN_UNICODE;
-		d->numCodePoints = 0;
-		return d;
-	}
+	return size==0 ? getEmptyData() : new Data(c,size,Data::UNKNOWN_UNICODE);
 }
 
 //! (static,internal)
 void StringData::releaseData(Data * data){
-	data->s.clear();
-	dataPool.push(data);
+	delete data;
 }
 
 //! (internal)
 void StringData::setData(Data * newData){
 	if(newData!=data){
-		if(--data->referenceCounter <=0 )
-			releaseData(data);
-		++newData->referenceCounter;
+		removeReference(data);
+		addReference(newData);
 		data = newData;
 	}
 }
@@ -66,7 +46,9 @@ StringData::Data * StringData::getEmptyData(){
 	struct UndeletableEmptyStringFactory{
 		static Data * create(){
 			Data * emptyString = new Data("",Data::ASCII);
-			++emptyString->referenceCounter;
+			emptyString->referenceCounter = -1;
+			const size_t h = std::hash<std::string>()(emptyString->s); // not calculated lazily, as the data is shared
+			emptyString->hashValue = h==0 ? 1 : h;
 			return emptyString;
 		}
 	};
@@ -74,30 +56,9 @@ StringData::Data * StringData::getEmptyData(){
 	return emptyString;
 }
 
-//! (internal)
-static size_t getUTF8CodePointLength(const char* cursor){
-	const uint8_t byte0 = static_cast<uint8_t>(*cursor);
-	if(byte0<0x80){ // 1 byte
-		return 1;
-	}else if(byte0<0xE0){ // 2 byte sequence
-		if(byte0<0xC2 ) // INVALID CHARACTER!!
-			return 1;
-		return 2;
-	}else if(byte0<0xF0){ // 3 byte sequence
-		return 3;
-	}else if(byte0<0xF5){ // 4 byte sequence
-		return 4;
-	}else{
-		return 1; // INVALID CHARACTER!!
-	}
-}
-
 size_t StringData::getNumCodepoints()const{
 	if(data->dataType == Data::UNKNOWN_UNICODE){
-		size_t codePointCounter = 0;
-		const char * const end = data->s.c_str()+getDataSize();
-		for(const char * cursor = data->s.c_str(); cursor<end; cursor += getUTF8CodePointLength(cursor) )
-			++codePointCounter;
+		const size_t codePointCounter = UTF8::countCodePoints(data->s.data(),getDataSize());
 		data->numCodePoints = codePointCounter;
 		if(codePointCounter == getDataSize())
 			data->dataType = Data::ASCII;
@@ -108,21 +69,41 @@ size_t StringData::getNumCodepoints()const{
 	return data->numCodePoints;
 }
 
+void StringData::append(const std::string & s){
+	if(s.empty())
+		return;
+	if(data->referenceCounter!=1){ // shared (or the empty data) -> copy on write
+		setData(createData(str()+s));
+		return;
+	}
+	const Data::dataType_t oldType = data->dataType;
+	data->s.append(s);
+	// an ascii string stays ascii if only ascii characters are appended; otherwise, the infos are recreated on demand
+	if(oldType == Data::ASCII && UTF8::isASCII(s.data(),s.length())){
+		data->numCodePoints += s.length();
+		data->hashValue = 0;
+	}else{
+		data->dataType = Data::UNKNOWN_UNICODE;
+		data->numCodePoints = 0;
+		data->hashValue = 0;
+		data->jumpTable.reset();
+	}
+}
+
+size_t StringData::getHash()const{
+	if(data->hashValue==0){
+		const size_t h = std::hash<std::string>()(str());
+		data->hashValue = h==0 ? 1 : h;
+	}
+	return data->hashValue;
+}
+
 static const uint32_t JUMP_TABLE_STEP_SIZE = 8;
 	
 //! (internal)
 void StringData::initJumpTable()const{
 	std::vector<size_t> jumpTable;
-	size_t codePointCursor = 0;
-	const size_t numBytes = getDataSize();
-	for(size_t byteCursor = 0; byteCursor<numBytes; 
-			byteCursor += getUTF8CodePointLength(data->s.c_str()+byteCursor) ){
-
-		if( (codePointCursor%JUMP_TABLE_STEP_SIZE)==0 && byteCursor>0) // skip the initial 0
-			jumpTable.emplace_back(byteCursor);
-		
-		++codePointCursor;
-	}
+	const size_t codePointCursor = UTF8::createJumpTable(data->s.data(),getDataSize(),JUMP_TABLE_STEP_SIZE,jumpTable);
 	data->numCodePoints = codePointCursor;
 	
 	if(codePointCursor == getDataSize()){
@@ -158,7 +139,7 @@ size_t StringData::codePointToBytePos(const size_t codePointIdx)const{
 		while(codePointCursor<codePointIdx){
 			if(byteCursor>=getDataSize())
 				return std::string::npos;
-			byteCursor += getUTF8CodePointLength(data->s.c_str()+byteCursor);
+			byteCursor += UTF8::getCodePointLength(data->s.c_str()+byteCursor);
 			++codePointCursor;
 		}
 		return byteCursor;
@@ -187,16 +168,18 @@ size_t StringData::find(const std::string& subj,const size_t codePointStart)cons
 	if(data->dataType == Data::RAW || data->dataType == Data::ASCII)
 		return str().find(subj,codePointStart);
 	
-	// perform linear search
+	// search the bytes and count the code points in between; matches not starting at a code point are skipped.
 	size_t byteCursor = codePointToBytePos(codePointStart);
 	size_t codePointCursor = codePointStart;
-	
-	const size_t endByte = str().length() - subj.length();
-	while(byteCursor<endByte){
-		if( str().compare(byteCursor,subjLength,subj)==0 )
+	while(byteCursor<getDataSize()){
+		const size_t matchPos = str().find(subj,byteCursor);
+		if(matchPos==std::string::npos)
+			return std::string::npos;
+		size_t codePointsEnd;
+		codePointCursor += UTF8::countCodePoints(data->s.data()+byteCursor,matchPos-byteCursor,&codePointsEnd);
+		byteCursor += codePointsEnd;
+		if(byteCursor==matchPos)
 			return codePointCursor;
-		byteCursor += getUTF8CodePointLength(data->s.c_str()+byteCursor);
-		++codePointCursor;
 	}
 	return std::string::npos;
 }
@@ -215,18 +198,29 @@ size_t StringData::rFind(const std::string& subj,const size_t codePointStart)con
 	if(data->dataType == Data::RAW || data->dataType == Data::ASCII)
 		return str().rfind(subj,codePointStart);
 
-	const size_t bytePos = str().rfind(subj,codePointToBytePos(codePointStart));
-	if(bytePos==std::string::npos)
-		return std::string::npos;
-	
-	// find code point for byte pos
-	size_t codePointCursor = codePointStart;
-	for(size_t byteCursor = codePointToBytePos(codePointStart); byteCursor>bytePos; --byteCursor){
-		const uint8_t c = static_cast<uint8_t>(str().at(byteCursor));
-		if(c<0x80 || c>0xBF )
-			--codePointCursor;
+	const size_t startByte = codePointStart<data->numCodePoints ? codePointToBytePos(codePointStart) : std::string::npos;
+	size_t bytePos = str().rfind(subj,startByte);
+	while(bytePos!=std::string::npos){
+		// count the code points up to the match, starting at the closest jump table entry
+		size_t byteCursor = 0;
+		size_t codePointCursor = 0;
+		if(data->jumpTable){
+			const std::vector<size_t> & jumpTable = *data->jumpTable.get();
+			const auto it = std::upper_bound(jumpTable.begin(),jumpTable.end(),bytePos);
+			if(it!=jumpTable.begin()){
+				byteCursor = *(it-1);
+				codePointCursor = static_cast<size_t>(it-jumpTable.begin()) * JUMP_TABLE_STEP_SIZE;
+			}
+		}
+		size_t codePointsEnd;
+		codePointCursor += UTF8::countCodePoints(data->s.data()+byteCursor,bytePos-byteCursor,&codePointsEnd);
+		if(byteCursor+codePointsEnd==bytePos)
+			return codePointCursor;
+		if(bytePos==0) // the match does not start at a code point
+			break;
+		bytePos = str().rfind(subj,bytePos-1);
 	}
-	return codePointCursor;
+	return std::string::npos;
 }
 
 		
@@ -8,7 +8,6 @@
 #include <string>
 #include <memory>
 #include <vector>
-#include <stack>
 
 namespace EScript {
 
@@ -29,36 +28,45 @@ class StringData{
 			} dataType;
 			std::unique_ptr<std::vector<size_t>> jumpTable; //!< jumpTable[i] := strPos of codePoint( (i+1)*JUMP_TABLE_STEP_SIZE)
 			size_t numCodePoints;
+			size_t hashValue; //!< 0 if not calculated yet
 
 			Data(const std::string & _s,dataType_t t) : 
-				s(_s),referenceCounter(0),dataType(t),numCodePoints(0){}
+				s(_s),referenceCounter(0),dataType(t),numCodePoints(0),hashValue(0){}
+			Data(std::string && _s,dataType_t t) : 
+				s(std::move(_s)),referenceCounter(0),dataType(t),numCodePoints(0),hashValue(0){}
 			Data(const char * c,size_t size,dataType_t t) : 
-				s(c,size),referenceCounter(0),dataType(t),numCodePoints(0){}
+				s(c,size),referenceCounter(0),dataType(t),numCodePoints(0),hashValue(0){}
 			Data(Data &&) = default;
 			Data(const Data &) = delete;
 			void initJumpTable();
 
 		};
 		static Data * createData(const std::string & s);
+		static Data * createData(std::string && s);
 		static Data * createData(const char * c,size_t size);
 		static void releaseData(Data * data);
 
 		void setData(Data * newData);
 		Data * data;
+
+		/*! The empty Data is shared by all empty strings. Its reference counter is negative and is never
+			changed, so that empty strings can be created and destroyed on several threads.	*/
 		static Data * getEmptyData();
-		static std::stack<Data*> dataPool;
+		static void addReference(Data * d)				{	if(d->referenceCounter>=0)	++d->referenceCounter;	}
+		static void removeReference(Data * d){
+			if(d->referenceCounter>0 && (--d->referenceCounter)==0 )
+				releaseData(d);
+		}
 		
 		void initJumpTable()const;
 	public:
-		StringData() : data(getEmptyData())								{	++data->referenceCounter;	}
-		explicit StringData(const std::string & s) : data(createData(s)){	++data->referenceCounter;	}
-		explicit StringData(const char * c,size_t size) : data(createData(c,size)){	++data->referenceCounter;	}
-		StringData(const StringData & other) : data(other.data)			{	++data->referenceCounter;	}
+		StringData() : data(getEmptyData())								{	}
+		explicit StringData(const std::string & s) : data(createData(s)){	addReference(data);	}
+		explicit StringData(std::string && s) : data(createData(std::move(s))){	addReference(data);	}
+		explicit StringData(const char * c,size_t size) : data(createData(c,size)){	addReference(data);	}
+		StringData(const StringData & other) : data(other.data)			{	addReference(data);	}
 
-		~StringData(){
-			if( (--data->referenceCounter) <=0 )
-				releaseData(data);
-		}
+		~StringData()									{	removeReference(data);	}
 		/*! Returns the byte index of the given codePointIdx in the utf8 encoded string.
 			If the codePoint is invalid, std::string::npos is returned. */
 		size_t codePointToBytePos(const size_t codePointNr)const;
@@ -66,6 +74,8 @@ class StringData{
 		
 		size_t getDataSize()const						{	return str().length();	}
 		size_t getNumCodepoints()const;
+		//! Hash value of the bytes; the value is cached until the data is changed.
+		size_t getHash()const;
 		std::string getSubStr(const size_t codePointStart, const size_t numCodePoints)const;
 		
 		size_t find(const std::string& subj,const size_t codePointStart=0)const;
@@ -80,6 +90,9 @@ class StringData{
 			setData(createData(s));
 			return *this;
 		}
+		/*! Append @p s to the string. If the data is not shared with another StringData, the bytes are
+			appended in place (amortized O(1) per byte); otherwise the data is copied once (copy on write). */
+		void append(const std::string & s);
 		void set(const StringData & other)				{	setData(other.data);	}
 		void set(const std::string & s)					{	setData(createData(s));	}
 		const std::string & str()const					{	return data->s;	}
@@ -3,6 +3,7 @@
 // See copyright notice in EScript.h
 // ------------------------------------------------------
 #include "StringUtils.h"
+#include "UTF8.h"
 #include <cstdlib>
 #include <cstdio>
 #include <iomanip>
@@ -296,4 +297,8 @@ std::string StringUtils::getLine(const std::string &s,const int lineIndex){
 	}
 	return s.substr(cursor, s.find('\n',cursor)-cursor );
 }
+
+size_t StringUtils::countCodePoints(const std::string& str_u8){
+	return UTF8::countCodePoints(str_u8.data(),str_u8.length());
+}
 }
@@ -0,0 +1,248 @@
+// UTF8.cpp
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#include "UTF8.h"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define ES_UTF8_X86
+#include <immintrin.h>
+#endif
+
+namespace EScript{
+namespace UTF8{
+
+// ------------------------------------------------------------------
+// scalar implementation
+
+//! (internal)
+static bool isASCII_scalar(const char * s, size_t numBytes){
+	size_t i = 0;
+	for(; i+8<=numBytes; i+=8){
+		uint64_t word;
+		std::memcpy(&word,s+i,8);
+		if( (word & 0x8080808080808080ULL) != 0)
+			return false;
+	}
+	for(; i<numBytes; ++i){
+		if( static_cast<uint8_t>(s[i])>=0x80 )
+			return false;
+	}
+	return true;
+}
+
+//! (internal)
+static size_t countCodePoints_scalar(const char * s, size_t numBytes, size_t * endPos){
+	size_t codePointCounter = 0;
+	size_t cursor = 0;
+	for(; cursor<numBytes; cursor += getCodePointLength(s+cursor) )
+		++codePointCounter;
+	if(endPos)
+		*endPos = cursor;
+	return codePointCounter;
+}
+
+//! (internal)
+static size_t createJumpTable_scalar(const char * s, size_t numBytes, size_t stepSize, std::vector<size_t> & jumpTable){
+	size_t codePointCursor = 0;
+	for(size_t byteCursor = 0; byteCursor<numBytes; byteCursor += getCodePointLength(s+byteCursor) ){
+		if( (codePointCursor%stepSize)==0 && byteCursor>0) // skip the initial 0
+			jumpTable.emplace_back(byteCursor);
+		++codePointCursor;
+	}
+	return codePointCursor;
+}
+
+#ifdef ES_UTF8_X86
+// ------------------------------------------------------------------
+// block implementation (x86)
+
+/*! Bit i of each mask corresponds to byte i of a block of 64 bytes.
+	The comparisons are unsigned: geXX := (byte >= 0xXX)	*/
+struct BlockMasks{
+	uint64_t geC0, geC2, geE0, geF0, geF5, high;
+};
+typedef void (*getBlockMasks_t)(const uint8_t *, BlockMasks &);
+
+//! (internal) ( v >= c ) for unsigned bytes
+static inline __m128i greaterEqual_sse2(__m128i v, __m128i c){
+	return _mm_cmpeq_epi8(_mm_max_epu8(v,c),v);
+}
+
+//! (internal)
+static void getBlockMasks_sse2(const uint8_t * block, BlockMasks & m){
+	const __m128i cC0 = _mm_set1_epi8(static_cast<char>(0xC0));
+	const __m128i cC2 = _mm_set1_epi8(static_cast<char>(0xC2));
+	const __m128i cE0 = _mm_set1_epi8(static_cast<char>(0xE0));
+	const __m128i cF0 = _mm_set1_epi8(static_cast<char>(0xF0));
+	const __m128i cF5 = _mm_set1_epi8(static_cast<char>(0xF5));
+	m = BlockMasks();
+	for(int i = 0; i<4; ++i){
+		const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block+i*16));
+		const int shift = i*16;
+		m.high |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(v))) << shift;
+		m.geC0 |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(greaterEqual_sse2(v,cC0)))) << shift;
+		m.geC2 |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(greaterEqual_sse2(v,cC2)))) << shift;
+		m.geE0 |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(greaterEqual_sse2(v,cE0)))) << shift;
+		m.geF0 |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(greaterEqual_sse2(v,cF0)))) << shift;
+		m.geF5 |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(greaterEqual_sse2(v,cF5)))) << shift;
+	}
+}
+
+//! (internal)
+static bool isASCII_sse2(const char * s, size_t numBytes){
+	size_t i = 0;
+	__m128i acc = _mm_setzero_si128();
+	for(; i+16<=numBytes; i+=16)
+		acc = _mm_or_si128(acc,_mm_loadu_si128(reinterpret_cast<const __m128i*>(s+i)));
+	return _mm_movemask_epi8(acc)==0 && isASCII_scalar(s+i,numBytes-i);
+}
+
+//! (internal) ( v >= c ) for unsigned bytes
+__attribute__((target("avx2")))
+static inline __m256i greaterEqual_avx2(__m256i v, __m256i c){
+	return _mm256_cmpeq_epi8(_mm256_max_epu8(v,c),v);
+}
+
+//! (internal)
+__attribute__((target("avx2")))
+static void getBlockMasks_avx2(const uint8_t * block, BlockMasks & m){
+	const __m256i cC0 = _mm256_set1_epi8(static_cast<char>(0xC0));
+	const __m256i cC2 = _mm256_set1_epi8(static_cast<char>(0xC2));
+	const __m256i cE0 = _mm256_set1_epi8(static_cast<char>(0xE0));
+	const __m256i cF0 = _mm256_set1_epi8(static_cast<char>(0xF0));
+	const __m256i cF5 = _mm256_set1_epi8(static_cast<char>(0xF5));
+	m = BlockMasks();
+	for(int i = 0; i<2; ++i){
+		const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block+i*32));
+		const int shift = i*32;
+		m.high |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(v))) << shift;
+		m.geC0 |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(greaterEqual_avx2(v,cC0)))) << shift;
+		m.geC2 |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(greaterEqual_avx2(v,cC2)))) << shift;
+		m.geE0 |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(greaterEqual_avx2(v,cE0)))) << shift;
+		m.geF0 |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(greaterEqual_avx2(v,cF0)))) << shift;
+		m.geF5 |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(greaterEqual_avx2(v,cF5)))) << shift;
+	}
+}
+
+//! (internal)
+__attribute__((target("avx2")))
+static bool isASCII_avx2(const char * s, size_t numBytes){
+	size_t i = 0;
+	__m256i acc = _mm256_setzero_si256();
+	for(; i+32<=numBytes; i+=32)
+		acc = _mm256_or_si256(acc,_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s+i)));
+	return _mm256_movemask_epi8(acc)==0 && isASCII_scalar(s+i,numBytes-i);
+}
+
+struct Implementation{
+	getBlockMasks_t getBlockMasks;
+	bool (*isASCII)(const char *, size_t);
+};
+
+//! (internal) The implementation is selected once by the features of the executing cpu.
+static const Implementation & getImplementation(){
+	struct Factory{
+		static Implementation create(){
+			Implementation impl;
+			__builtin_cpu_init();
+			if(__builtin_cpu_supports("avx2")){
+				impl.getBlockMasks = getBlockMasks_avx2;
+				impl.isASCII = isASCII_avx2;
+			}else{
+				impl.getBlockMasks = getBlockMasks_sse2;
+				impl.isASCII = isASCII_sse2;
+			}
+			return impl;
+		}
+	};
+	static const Implementation impl = Factory::create();
+	return impl;
+}
+
+/*! (internal) Count the code points block-wise: The code point starts are all bytes that are no continuation
+	bytes (10xxxxxx). This is equivalent to the byte-wise walk iff the continuation bytes are exactly the bytes
+	expected after the lead bytes. If this does not hold (invalid utf8), false is returned and the caller
+	has to use the scalar implementation.
+	If @p jumpTable is not nullptr, the positions of every @p stepSize'th code point are added. */
+static bool scanBlocks(const char * s, size_t numBytes, size_t stepSize, std::vector<size_t> * jumpTable, size_t & numCodePoints){
+	const getBlockMasks_t getBlockMasks = getImplementation().getBlockMasks;
+	uint64_t carry = 0; // expected continuation bytes at the beginning of the next block
+	size_t codePointCounter = 0;
+	size_t nextJumpTableEntry = stepSize;
+	for(size_t blockStart = 0; blockStart<numBytes; blockStart += 64){
+		const size_t blockSize = numBytes-blockStart < 64 ? numBytes-blockStart : 64;
+		BlockMasks m;
+		if(blockSize==64){
+			getBlockMasks(reinterpret_cast<const uint8_t*>(s+blockStart),m);
+		}else{ // the padding bytes are treated as ascii
+			uint8_t buffer[64] = {0};
+			std::memcpy(buffer,s+blockStart,blockSize);
+			getBlockMasks(buffer,m);
+		}
+		const uint64_t continuations = m.high & ~m.geC0;
+		const uint64_t leads2 = m.geC2 & ~m.geF5;	// 2,3 or 4 byte sequence
+		const uint64_t leads3 = m.geE0 & ~m.geF5;	// 3 or 4 byte sequence
+		const uint64_t leads4 = m.geF0 & ~m.geF5;	// 4 byte sequence
+		const uint64_t expectedContinuations = (leads2<<1) | (leads3<<2) | (leads4<<3) | carry;
+		if(expectedContinuations!=continuations)
+			return false;
+		carry = (leads2>>63) | (leads3>>62) | (leads4>>61);
+
+		const uint64_t validBits = blockSize==64 ? ~0ULL : ((1ULL<<blockSize)-1);
+		const uint64_t starts = ~continuations & validBits;
+		const size_t numStarts = static_cast<size_t>(__builtin_popcountll(starts));
+		if(jumpTable){
+			uint64_t remainingStarts = starts;
+			size_t remainingIndex = codePointCounter;
+			while(nextJumpTableEntry < codePointCounter+numStarts){
+				for(; remainingIndex<nextJumpTableEntry; ++remainingIndex)
+					remainingStarts &= remainingStarts-1; // remove lowest bit
+				jumpTable->emplace_back(blockStart + static_cast<size_t>(__builtin_ctzll(remainingStarts)));
+				nextJumpTableEntry += stepSize;
+			}
+		}
+		codePointCounter += numStarts;
+	}
+	if(carry!=0) // truncated sequence at the end
+		return false;
+	numCodePoints = codePointCounter;
+	return true;
+}
+#endif // ES_UTF8_X86
+
+// ------------------------------------------------------------------
+
+bool isASCII(const char * s, size_t numBytes){
+#ifdef ES_UTF8_X86
+	return getImplementation().isASCII(s,numBytes);
+#else
+	return isASCII_scalar(s,numBytes);
+#endif
+}
+
+size_t countCodePoints(const char * s, size_t numBytes, size_t * endPos){
+#ifdef ES_UTF8_X86
+	size_t numCodePoints;
+	if(scanBlocks(s,numBytes,1,nullptr,numCodePoints)){
+		if(endPos)
+			*endPos = numBytes;
+		return numCodePoints;
+	}
+#endif
+	return countCodePoints_scalar(s,numBytes,endPos);
+}
+
+size_t createJumpTable(const char * s, size_t numBytes, size_t stepSize, std::vector<size_t> & jumpTable){
+#ifdef ES_UTF8_X86
+	size_t numCodePoints;
+	if(scanBlocks(s,numBytes,stepSize,&jumpTable,numCodePoints))
+		return numCodePoints;
+	jumpTable.clear();
+#endif
+	return createJumpTable_scalar(s,numBytes,stepSize,jumpTable);
+}
+
+}
+}
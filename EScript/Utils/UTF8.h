@@ -0,0 +1,54 @@
+// UTF8.h
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifndef ES_UTF8_H
+#define ES_UTF8_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace EScript {
+
+/*! [UTF8]
+	Scanning functions for utf8 encoded byte sequences used by StringData.
+	Code points are counted by stepping from lead byte to lead byte (see getCodePointLength(...)); invalid
+	sequences therefore yield the same results as the byte-wise walk.
+	On x86 cpus, blocks of 64 bytes are processed using SSE2 or AVX2 (selected at runtime); other
+	platforms and invalid sequences use the scalar implementation.	*/
+namespace UTF8 {
+
+//! Returns the number of bytes of the code point starting with the given lead byte (1 for invalid bytes).
+inline size_t getCodePointLength(const char* cursor){
+	const uint8_t byte0 = static_cast<uint8_t>(*cursor);
+	if(byte0<0x80){ // 1 byte
+		return 1;
+	}else if(byte0<0xE0){ // 2 byte sequence
+		if(byte0<0xC2 ) // INVALID CHARACTER!!
+			return 1;
+		return 2;
+	}else if(byte0<0xF0){ // 3 byte sequence
+		return 3;
+	}else if(byte0<0xF5){ // 4 byte sequence
+		return 4;
+	}else{
+		return 1; // INVALID CHARACTER!!
+	}
+}
+
+//! Returns true iff all bytes are < 128.
+bool isASCII(const char * s, size_t numBytes);
+
+/*! Count the code points in the given bytes.
+	If @p endPos is given, it is set to the byte position after the last counted code point
+	(this is > numBytes if the last code point is truncated). */
+size_t countCodePoints(const char * s, size_t numBytes, size_t * endPos = nullptr);
+
+/*! Count the code points and store the byte position of every @p stepSize'th code point
+	(starting with code point @p stepSize) in @p jumpTable. Returns the number of code points.	*/
+size_t createJumpTable(const char * s, size_t numBytes, size_t stepSize, std::vector<size_t> & jumpTable);
+
+}
+}
+#endif // ES_UTF8_H
@@ -3,6 +3,8 @@
 // See copyright notice in EScript.h
 // ------------------------------------------------------
 #include "IOLib.h"
+#include "ext/DirectoryIterator.h"
+#include "ext/File.h"
 #include "../EScript/Basics.h"
 #include "../EScript/StdObjects.h"
 #include "../EScript/Utils/IO/IO.h"
@@ -62,6 +64,16 @@ void IOLib::init(EScript::Namespace * o) {
 	})
 	declareConstant(lib,"filePutContents",lib->getAttribute("saveTextFile").getValue()); //! \deprecated alias
 
+	//! [ESF] void deleteFile(string filename)
+	ES_FUNCTION(lib,"deleteFile",1,1,{
+		try{
+			IO::deleteFile(parameter[0].toString());
+		}catch(const std::ios::failure & e){
+			rt.setException(e.what());
+		}
+		return nullptr;
+	})
+
 	//! [ESF] array dir(string dirname[,int flags])
 	ES_FUNCTION(lib,"dir",1,2, {
 		try {
@@ -72,6 +84,20 @@ void IOLib::init(EScript::Namespace * o) {
 		}
 	})
 
+	/*! [ESF] DirectoryIterator walkDir(string dirname[,int flags=DIR_FILES [,string pattern [,int numThreads=0]]])
+		Lazily iterate the entries (path -> {"type","size","mTime"}) of the directory. Only the entries whose
+		name matches the glob pattern (*, ?, [a-z]) are returned. If numThreads>0 (and the file system handler
+		is thread safe), the (sub)directories are read in parallel and the entries are returned in an unspecified order.	*/
+	ES_FUNCTION(lib,"walkDir",1,4, {
+		try {
+			return new DirectoryIterator(parameter[0].toString(), parameter[1].toInt(E_DIR_FILES),
+											parameter[2].toString(""), parameter[3].toUInt(0));
+		} catch (const std::ios::failure & e) {
+			rt.setException(e.what());
+			return nullptr;
+		}
+	})
+
 	//! [ESF] string condensePath(string path)
 	ES_FUN(lib,"condensePath",1,1,IO::condensePath(parameter[0].toString()))
 
@@ -97,5 +123,12 @@ void IOLib::init(EScript::Namespace * o) {
 	declareConstant(lib,"DIR_BOTH",			static_cast<uint32_t>(E_DIR_BOTH));
 	declareConstant(lib,"DIR_RECURSIVE",	static_cast<uint32_t>(E_DIR_RECURSIVE));
 
+	declareConstant(lib,"TYPE_FILE",		static_cast<int>(IO::TYPE_FILE));
+	declareConstant(lib,"TYPE_DIRECTORY",	static_cast<int>(IO::TYPE_DIRECTORY));
+	declareConstant(lib,"TYPE_UNKNOWN",		static_cast<int>(IO::TYPE_UNKNOWN));
+
+	DirectoryIterator::init(*lib);
+	File::init(*lib);
+
 }
 }
@@ -13,6 +13,7 @@
 #include "../EScript/Consts.h"
 #include "ext/JSON.h"
 
+#include <algorithm>
 #include <sstream>
 #include <stdlib.h>
 #include <ctime>
@@ -99,37 +100,63 @@ void StdLib::print_r(Object * o,int maxLevel,int level) {
 	std::cout.flush();
 }
 
+//! (internal) Map filename -> location of the files found by findFile(...); nullptr if not created yet.
+static Map * getFileLocationCache(Runtime & runtime, bool createIfMissing){
+	static const StringId cacheId("__findFile_cache");
+	Map * cache = dynamic_cast<Map*>(runtime.getAttribute(cacheId).getValue());
+	if(cache == nullptr && createIfMissing){
+		cache = Map::create();
+		runtime.setAttribute(cacheId, Attribute(cache));
+	}
+	return cache;
+}
+
 /*! Tries to locate the given __filename__ with the current searchPath set in the runtime.
-	@return the path to the file or the original __filename__ if the file could not be found.	*/
+	The locations of found files are cached until the search paths are changed by addSearchPath(...).
+	@return the (condensed) path to the file or the original __filename__ if the file could not be found.	*/
 static std::string findFile(Runtime & runtime, const std::string & filename){
 	static const StringId seachPathsId("__searchPaths");
 
+	if(Map * cache = getFileLocationCache(runtime,false)){
+		if(Object * location = cache->getValue(filename))
+			return location->toString();
+	}
+
 	std::string file(IO::condensePath(filename));
-	if( IO::getEntryType(file)!=IO::TYPE_FILE ){
+	bool found = IO::getEntryType(file)==IO::TYPE_FILE;
+	if( !found ){
 		if(Array * searchPaths = dynamic_cast<Array*>(runtime.getAttribute(seachPathsId).getValue())){
 			for(ERef<Iterator> itRef = searchPaths->getIterator();!itRef->end();itRef->next()){
 				ObjRef valueRef = itRef->value();
 				std::string s(IO::condensePath(valueRef.toString()+'/'+filename));
 				if( IO::getEntryType(s)==IO::TYPE_FILE ){
 					file = s;
+					found = true;
 					break;
 				}
 			}
 		}
 	}
+	if(found)
+		getFileLocationCache(runtime,true)->setValue(create(filename), create(file));
 	return file;
 }
 
-//! (static)
-ObjRef StdLib::loadOnce(Runtime & runtime,const std::string & filename){
+//! (internal) Map filename -> true of the files loaded by loadOnce(...).
+static Map * getLoadedFiles(Runtime & runtime){
 	static const StringId mapId("__loadOnce_loadedFiles");
-
-	std::string condensedFilename( IO::condensePath(findFile(runtime,filename)) );
 	Map * m = dynamic_cast<Map*>(runtime.getAttribute(mapId).getValue());
 	if(m==nullptr){
 		m = Map::create();
 		runtime.setAttribute(mapId, Attribute(m));
 	}
+	return m;
+}
+
+//! (static)
+ObjRef StdLib::loadOnce(Runtime & runtime,const std::string & filename){
+	const std::string condensedFilename( findFile(runtime,filename) );
+	Map * m = getLoadedFiles(runtime);
 	ObjRef obj = m->getValue(condensedFilename);
 	if(obj.toBool()){ // already loaded?
 		return nullptr;
@@ -138,6 +165,41 @@ ObjRef StdLib::loadOnce(Runtime & runtime,const std::string & filename){
 	return _loadAndExecute(runtime,condensedFilename);
 }
 
+//! (static)
+void StdLib::loadOnceAll(Runtime & runtime,const std::vector<std::string> & filenames){
+	ERef<Map> m = getLoadedFiles(runtime); // the executed files may replace the runtime's attribute
+	auto isLoaded = [&m](const std::string & file){	return ObjRef(m->getValue(file)).toBool();	};
+	std::vector<std::string> files;
+	for(const auto & filename : filenames){
+		std::string condensedFilename( findFile(runtime,filename) );
+		if(!isLoaded(condensedFilename) && std::find(files.begin(),files.end(),condensedFilename)==files.end())
+			files.emplace_back(std::move(condensedFilename));
+	}
+	const auto scripts = precompileFiles(runtime,files);
+	// take the ownership of the thrown Exceptions; the ones that are not thrown again are released on return.
+	std::vector<ObjRef> errors(files.size());
+	for(size_t i=0; i<files.size(); ++i){
+		if(scripts[i].second){
+			try{
+				std::rethrow_exception(scripts[i].second);
+			}catch(Object * error){
+				errors[i] = error;
+			}catch(...){
+			}
+		}
+	}
+	for(size_t i=0; i<files.size() && runtime.checkNormalState(); ++i){
+		if(isLoaded(files[i])) // loaded by one of the preceding files?
+			continue;
+		m->setValue(create(files[i]), create(true));
+		if(errors[i].isNotNull())
+			throw errors[i].detachAndDecrease();
+		if(scripts[i].second)
+			std::rethrow_exception(scripts[i].second);
+		runtime.executeFunction(scripts[i].first.get(),nullptr,ParameterValues());
+	}
+}
+
 #if defined(_WIN32)
 static LARGE_INTEGER _getPerformanceCounter();
 
@@ -167,6 +229,8 @@ void StdLib::init(EScript::Namespace * globals) {
 			rt.setAttribute(seachPathsId, Attribute(searchPaths));
 		}
 		searchPaths->pushBack(String::create(parameter[0].toString()));
+		if(Map * cache = getFileLocationCache(rt,false)) // the cached locations depend on the search paths
+			cache->clear();
 		return nullptr;
 	})
 
@@ -244,6 +308,16 @@ void StdLib::init(EScript::Namespace * globals) {
 	//!	[ESF] mixed loadOnce(string filename)
 	ES_FUN(globals,"loadOnce",1,1,StdLib::loadOnce(rt,parameter[0].toString()))
 
+	/*!	[ESF] void loadOnceAll(Array filenames)
+		Like calling loadOnce(...) for each of the files, but the files are loaded and parsed in parallel.	*/
+	ES_FUNCTION(globals,"loadOnceAll",1,1,{
+		std::vector<std::string> filenames;
+		for(const auto & filename : *assertType<Array>(rt,parameter[0]))
+			filenames.emplace_back(filename.toString());
+		StdLib::loadOnceAll(rt,filenames);
+		return nullptr;
+	})
+
 	//! [ESF]  Number ord(String)                  UNICODE_TODO !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 	ES_FUN(globals,"ord",1,1,static_cast<int>(parameter[0].toString().c_str()[0] ))
 
@@ -269,13 +343,45 @@ void StdLib::init(EScript::Namespace * globals) {
 	ES_FUNCTION(globals,"parse",1,1, {
 		ERef<UserFunction> script;
 
+		Runtime::CompilationTimer timer(rt);
 		Compiler compiler(rt.getLogger());
 		script = compiler.compile(CodeFragment(Consts::FILENAME_INLINE, StringData(parameter[0].toString())));
 
 		return script.detachAndDecrease();
 	})
-	//! [ESF]  obj parseJSON(string)
-	ES_FUN(globals,"parseJSON",1,1,JSON::parseJSON(parameter[0].toString()))
+	/*! [ESF]  obj parseJSON(string [,Bool strict = false])
+		On a syntax error, an exception is thrown if strict is true; otherwise a warning is
+		issued (unless the string is empty) and the string itself is returned.	*/
+	ES_FUNCTION(globals,"parseJSON",1,2,{
+		const String * str = parameter[0].toType<String>(); // avoid copying large strings
+		const std::string convertedString = str ? std::string() : parameter[0].toString();
+		const std::string & s = str ? str->getString() : convertedString;
+		JSON::ParseError error;
+		Object * result = JSON::parse(s.data(),s.data()+s.length(),error);
+		if(result)
+			return result;
+		if(parameter[1].toBool(false)){
+			rt.setException(error.toString());
+			return nullptr;
+		}
+		if(!s.empty())
+			rt.warn(error.toString());
+		return create(s);
+	})
+
+	/*! [ESF]  void parseJSONEvents(string,callback)
+		Read the JSON data without creating the values' containers.
+		callback(event,value) is called for the events "startMap", "key", "endMap", "startArray",
+		"endArray" and "value". Syntax errors throw an exception.	*/
+	ES_FUNCTION(globals,"parseJSONEvents",2,2,{
+		const String * str = parameter[0].toType<String>();
+		const std::string convertedString = str ? std::string() : parameter[0].toString();
+		const std::string & s = str ? str->getString() : convertedString;
+		JSON::ParseError error;
+		if(!JSON::rt_parse(rt,s.data(),s.data()+s.length(),parameter[1],error) && error.isSet())
+			rt.setException(error.toString());
+		return nullptr;
+	})
 
 	//! [ESF] void print_r(...)
 	ES_FUNCTION(globals,"print_r",0,-1, {
@@ -6,6 +6,7 @@
 #define STDLIB_H
 #include "../EScript/Utils/ObjRef.h"
 #include <string>
+#include <vector>
 
 namespace EScript{
 class Namespace;
@@ -24,6 +25,13 @@ void init(EScript::Namespace * o);
  */
 ObjRef loadOnce(Runtime & runtime,const std::string & filename);
 
+/*! Loads and executes the scripts from the given files (in the given order) if they have not already been loaded
+	by loadOnce(...). The files are loaded and parsed on several threads (see precompileFiles(...)).
+	If a file can not be loaded or compiled, the preceding files are executed and the error is thrown.
+	\note May throw 'Object *' on error!
+ */
+void loadOnceAll(Runtime & runtime,const std::vector<std::string> & filenames);
+
 //! formatted output
 void print_r(Object * o,int maxLevel = 7,int level = 1);
 
@@ -0,0 +1,67 @@
+// DirectoryIterator.cpp
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#include "DirectoryIterator.h"
+#include "../../EScript/Basics.h"
+#include "../../EScript/StdObjects.h"
+
+namespace EScript{
+
+//! (static)
+Type * DirectoryIterator::getTypeObject(){
+	static Type * typeObject = new Type(Iterator::getTypeObject()); // ---|> Iterator
+	return typeObject;
+}
+
+//! initMembers
+void DirectoryIterator::init(EScript::Namespace & lib) {
+	Type * typeObject = getTypeObject();
+	initPrintableName(typeObject,"IO.DirectoryIterator");
+
+	declareConstant(&lib,getClassName(),typeObject);
+
+	//! [ESMF] thisObj DirectoryIterator.getIterator()	(allows using the iterator in foreach)
+	ES_FUN(typeObject,"getIterator",0,0,thisEObj)
+}
+
+DirectoryIterator::DirectoryIterator(const std::string & _dirname,uint8_t _flags,const std::string & _pattern,uint32_t _numThreads) :
+		Iterator(getTypeObject()),dirname(_dirname),flags(_flags),pattern(_pattern),numThreads(_numThreads),
+		walker(new IO::DirectoryWalker(dirname,flags,pattern,numThreads)),valid(false){
+	valid = walker->next(entry);
+}
+
+//! ---|> [Iterator]
+Object * DirectoryIterator::key() {
+	return valid ? create(entry.path) : nullptr;
+}
+
+//! ---|> [Iterator]
+Object * DirectoryIterator::value() {
+	if(!valid)
+		return nullptr;
+	Map * info = Map::create();
+	info->setValue(create("type"),create(static_cast<int>(entry.info.type)));
+	info->setValue(create("size"),create(static_cast<double>(entry.info.fileSize)));
+	info->setValue(create("mTime"),create(entry.info.mTime));
+	return info;
+}
+
+//! ---|> [Iterator]
+void DirectoryIterator::next() {
+	if(valid)
+		valid = walker->next(entry);
+}
+
+//! ---|> [Iterator]
+void DirectoryIterator::reset() {
+	try{
+		walker.reset(); // stop the old walk before starting a new one
+		walker.reset(new IO::DirectoryWalker(dirname,flags,pattern,numThreads));
+		valid = walker->next(entry);
+	}catch(const std::ios_base::failure &){
+		valid = false;
+	}
+}
+
+}
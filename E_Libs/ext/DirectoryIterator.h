@@ -0,0 +1,48 @@
+// DirectoryIterator.h
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifndef ES_DIRECTORYITERATOR_H
+#define ES_DIRECTORYITERATOR_H
+
+#include "../../EScript/Objects/Iterator.h"
+#include "../../EScript/Utils/IO/DirectoryWalker.h"
+#include <memory>
+#include <string>
+
+namespace EScript {
+
+/*! [DirectoryIterator] ---|> [Iterator] ---|> [Object]
+	Lazily iterates the entries of a directory using an IO::DirectoryWalker (IO.DirectoryIterator in EScript).
+	key: the entry's path; value: Map {"type" : IO.TYPE_FILE|IO.TYPE_DIRECTORY, "size" : Number, "mTime" : Number}	*/
+class DirectoryIterator : public Iterator {
+		ES_PROVIDES_TYPE_NAME(DirectoryIterator)
+	public:
+		static Type* getTypeObject();
+		static void init(EScript::Namespace & lib);
+
+		//! @throw std::ios_base::failure if the directory can not be read.
+		DirectoryIterator(const std::string & dirname,uint8_t flags,const std::string & pattern,uint32_t numThreads);
+		virtual ~DirectoryIterator(){}
+
+		const IO::DirectoryEntry & getEntry()const	{	return entry;	}
+
+		//! ---|> [Iterator]
+		virtual Object * key();
+		virtual Object * value();
+		//! Restart the traversal.
+		virtual void reset();
+		virtual void next();
+		virtual bool end()					{	return !valid;	}
+	private:
+		const std::string dirname;
+		const uint8_t flags;
+		const std::string pattern;
+		const uint32_t numThreads;
+		std::unique_ptr<IO::DirectoryWalker> walker;
+		IO::DirectoryEntry entry;
+		bool valid;
+};
+}
+
+#endif // ES_DIRECTORYITERATOR_H
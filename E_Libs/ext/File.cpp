@@ -0,0 +1,329 @@
+// File.cpp
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#include "File.h"
+#include "../../EScript/Basics.h"
+#include "../../EScript/StdObjects.h"
+#include "../../EScript/Utils/IO/IO.h"
+#include <algorithm>
+#include <cstring>
+
+namespace EScript{
+
+//! (static)
+Type * File::getTypeObject(){
+	static Type * typeObject = new Type(Object::getTypeObject()); // ---|> Object
+	return typeObject;
+}
+
+//! (static,internal)
+static IO::openMode_t toOpenMode(Runtime & rt,const std::string & mode){
+	if(mode=="r")
+		return IO::MODE_READ;
+	else if(mode=="w")
+		return IO::MODE_WRITE;
+	else if(mode=="a")
+		return IO::MODE_APPEND;
+	else if(mode=="r+")
+		return IO::MODE_READ_WRITE;
+	rt.setException("IO.File: Unknown mode '"+mode+"' (expected 'r', 'w', 'a' or 'r+').");
+	return IO::MODE_READ;
+}
+
+//! initMembers
+void File::init(EScript::Namespace & lib) {
+	Type * typeObject = getTypeObject();
+	initPrintableName(typeObject,"IO.File");
+
+	declareConstant(&lib,getClassName(),typeObject);
+
+	/*! [ESMF] File new IO.File( String filename [,String mode="r"] )
+		Modes:	"r" read; "w" create or truncate and write; "a" append; "r+" read and write	*/
+	ES_CONSTRUCTOR(typeObject,1,2, {
+		const IO::openMode_t mode = toOpenMode(rt,parameter[1].toString("r"));
+		if(!rt.checkNormalState())
+			return nullptr;
+		try{
+			return File::open(parameter[0].toString(),mode,thisType);
+		}catch(const std::ios_base::failure & e){
+			rt.setException(e.what());
+			return nullptr;
+		}
+	})
+
+	//! [ESMF] thisObj File.close()
+	ES_MFUNCTION(typeObject,File,"close",0,0,{
+		try{
+			thisObj->close();
+		}catch(const std::ios_base::failure & e){
+			rt.setException(e.what());
+		}
+		return thisEObj;
+	})
+
+	//! [ESMF] thisObj File.flush()
+	ES_MFUNCTION(typeObject,File,"flush",0,0,{
+		try{
+			thisObj->flush();
+		}catch(const std::ios_base::failure & e){
+			rt.setException(e.what());
+		}
+		return thisEObj;
+	})
+
+	//! [ESMF] File.LineIterator File.getIterator()
+	ES_MFUNCTION(typeObject,File,"getIterator",0,0,{
+		try{
+			return new LineIterator(thisObj);
+		}catch(const std::ios_base::failure & e){
+			rt.setException(e.what());
+			return nullptr;
+		}
+	})
+
+	//! [ESMF] String File.getFilename()
+	ES_MFUN(typeObject,const File,"getFilename",0,0,	thisObj->getFilename())
+
+	//! [ESMF] Bool File.isEOF()
+	ES_MFUNCTION(typeObject,File,"isEOF",0,0,{
+		try{
+			return thisObj->isEOF();
+		}catch(const std::ios_base::failure & e){
+			rt.setException(e.what());
+			return nullptr;
+		}
+	})
+
+	//! [ESMF] Bool File.isOpen()
+	ES_MFUN(typeObject,const File,"isOpen",0,0,			thisObj->isOpen())
+
+	/*! [ESMF] String File.read( [Number size] )
+		Read up to size bytes or, without a size, the remaining bytes. Returns "" at the end of the file.	*/
+	ES_MFUNCTION(typeObject,File,"read",0,1,{
+		try{
+			if(parameter.count()==0)
+				return thisObj->readAll();
+			return thisObj->read(parameter[0].to<uint32_t>(rt));
+		}catch(const std::ios_base::failure & e){
+			rt.setException(e.what());
+			return nullptr;
+		}
+	})
+
+	/*! [ESMF] String|void File.readLine()
+		Read the next line without its line break. Returns void at the end of the file.	*/
+	ES_MFUNCTION(typeObject,File,"readLine",0,0,{
+		try{
+			std::string line;
+			if(thisObj->readLine(line))
+				return line;
+			return nullptr;
+		}catch(const std::ios_base::failure & e){
+			rt.setException(e.what());
+			return nullptr;
+		}
+	})
+
+	//! [ESMF] thisObj File.seek( Number position )
+	ES_MFUNCTION(typeObject,File,"seek",1,1,{
+		try{
+			thisObj->seek(static_cast<uint64_t>(parameter[0].to<double>(rt)));
+		}catch(const std::ios_base::failure & e){
+			rt.setException(e.what());
+		}
+		return thisEObj;
+	})
+
+	//! [ESMF] Number File.tell()
+	ES_MFUNCTION(typeObject,File,"tell",0,0,{
+		try{
+			return static_cast<double>(thisObj->tell());
+		}catch(const std::ios_base::failure & e){
+			rt.setException(e.what());
+			return nullptr;
+		}
+	})
+
+	//! [ESMF] thisObj File.write( String data )
+	ES_MFUNCTION(typeObject,File,"write",1,1,{
+		try{
+			const String * s = parameter[0].toType<String>();
+			if(s!=nullptr)
+				thisObj->write(s->getString());
+			else
+				thisObj->write(parameter[0].toString());
+		}catch(const std::ios_base::failure & e){
+			rt.setException(e.what());
+		}
+		return thisEObj;
+	})
+}
+
+//---
+
+//! (static)
+File * File::open(const std::string & filename,IO::openMode_t mode,Type * type){
+	return new File(filename,IO::openFile(filename,mode),type);
+}
+
+//! (dtor)
+File::~File(){
+	try{
+		close();
+	}catch(const std::ios_base::failure &){
+	}
+}
+
+//! (internal)
+IO::AbstractFileHandle & File::getHandle(){
+	if(!handle)
+		throw std::ios_base::failure("IO.File: The file is closed: '"+filename+'\'');
+	return *handle;
+}
+
+//! (internal) Move the handle's position back to the logical position and drop the unread bytes.
+void File::discardReadBuffer(){
+	if(readCursor<readBuffer.size())
+		getHandle().seek(getHandle().tell()-(readBuffer.size()-readCursor));
+	readBuffer.clear();
+	readCursor = 0;
+}
+
+//! (internal) Returns false at the end of the file.
+bool File::fillReadBuffer(){
+	flushWriteBuffer();
+	readBuffer.resize(BUFFER_SIZE);
+	readBuffer.resize(getHandle().read(&readBuffer[0],BUFFER_SIZE));
+	readCursor = 0;
+	return !readBuffer.empty();
+}
+
+//! (internal)
+void File::flushWriteBuffer(){
+	if(!writeBuffer.empty()){
+		getHandle().write(writeBuffer.data(),writeBuffer.size());
+		writeBuffer.clear();
+	}
+}
+
+void File::close(){
+	if(handle){
+		flushWriteBuffer();
+		handle.reset();
+		readBuffer.clear();
+		readCursor = 0;
+	}
+}
+
+void File::flush(){
+	flushWriteBuffer();
+	getHandle().flush();
+}
+
+bool File::isEOF(){
+	return readCursor>=readBuffer.size() && !fillReadBuffer();
+}
+
+bool File::readLine(std::string & line){
+	line.clear();
+	bool found = false;
+	while(readCursor<readBuffer.size() || fillReadBuffer()){
+		found = true;
+		const char * begin = readBuffer.data()+readCursor;
+		const size_t available = readBuffer.size()-readCursor;
+		const char * lineEnd = static_cast<const char*>(std::memchr(begin,'\n',available));
+		if(lineEnd!=nullptr){
+			line.append(begin,lineEnd);
+			readCursor += static_cast<size_t>(lineEnd-begin)+1;
+			if(!line.empty() && line.back()=='\r')
+				line.pop_back();
+			return true;
+		}
+		line.append(begin,available);
+		readCursor = readBuffer.size();
+	}
+	if(!line.empty() && line.back()=='\r')
+		line.pop_back();
+	return found;
+}
+
+std::string File::read(size_t size){
+	std::string result;
+	while(result.size()<size && (readCursor<readBuffer.size() || fillReadBuffer())){
+		const size_t count = std::min(size-result.size(),readBuffer.size()-readCursor);
+		result.append(readBuffer,readCursor,count);
+		readCursor += count;
+	}
+	return result;
+}
+
+std::string File::readAll(){
+	std::string result;
+	while(readCursor<readBuffer.size() || fillReadBuffer()){
+		result.append(readBuffer,readCursor,std::string::npos);
+		readCursor = readBuffer.size();
+	}
+	return result;
+}
+
+void File::seek(uint64_t position){
+	flushWriteBuffer();
+	readBuffer.clear();
+	readCursor = 0;
+	getHandle().seek(position);
+}
+
+uint64_t File::tell(){
+	return getHandle().tell()-(readBuffer.size()-readCursor)+writeBuffer.size();
+}
+
+void File::write(const char * data,size_t size){
+	discardReadBuffer();
+	writeBuffer.append(data,size);
+	if(writeBuffer.size()>=BUFFER_SIZE)
+		flushWriteBuffer();
+}
+
+// -----------------------------------------------------------
+// LineIterator
+
+File::LineIterator::LineIterator(File * file) :
+		Iterator(),fileRef(file),startPosition(file->tell()),lineNumber(0),valid(false){
+	valid = fileRef->readLine(line);
+}
+
+//! ---|> [Iterator]
+Object * File::LineIterator::key() {
+	return valid ? create(static_cast<uint32_t>(lineNumber)) : nullptr;
+}
+
+//! ---|> [Iterator]
+Object * File::LineIterator::value() {
+	return valid ? create(line) : nullptr;
+}
+
+//! ---|> [Iterator]
+void File::LineIterator::next() {
+	if(!valid)
+		return;
+	++lineNumber;
+	try{
+		valid = fileRef->readLine(line);
+	}catch(const std::ios_base::failure &){ // e.g. the file has been closed
+		valid = false;
+	}
+}
+
+//! ---|> [Iterator]
+void File::LineIterator::reset() {
+	lineNumber = 0;
+	try{
+		fileRef->seek(startPosition);
+		valid = fileRef->readLine(line);
+	}catch(const std::ios_base::failure &){
+		valid = false;
+	}
+}
+
+}
@@ -0,0 +1,105 @@
+// File.h
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifndef ES_FILE_H
+#define ES_FILE_H
+
+#include "../../EScript/Objects/Iterator.h"
+#include "../../EScript/Utils/IO/AbstractFileHandle.h"
+#include <memory>
+#include <string>
+
+namespace EScript {
+
+/*! [File] ---|> [Object]
+	Buffered stream on a file opened by the IO::AbstractFileSystemHandler (IO.File in EScript).
+	Reading and writing go through an internal buffer of BUFFER_SIZE bytes, so a file can be processed
+	line by line using constant memory. Iterating over a File (foreach) yields its lines starting
+	at the current position.
+	All operations throw std::ios_base::failure on failure or if the file has been closed.	*/
+class File : public Object {
+		ES_PROVIDES_TYPE_NAME(File)
+
+	//! @name Types
+	// @{
+	public:
+		//!	[File.LineIterator] ---|> [Iterator]	key: line number (starting at 0); value: line
+		class LineIterator : public Iterator {
+				ES_PROVIDES_TYPE_NAME(FileLineIterator)
+			public:
+				LineIterator(File * file);
+				virtual ~LineIterator(){}
+
+				//! ---|> [Iterator]
+				virtual Object * key();
+				virtual Object * value();
+				//! Continue at the position where the iteration started.
+				virtual void reset();
+				virtual void next();
+				virtual bool end()			{	return !valid;	}
+			private:
+				ERef<File> fileRef;
+				uint64_t startPosition;
+				size_t lineNumber;
+				std::string line;
+				bool valid;
+		};
+	//	@}
+
+	//! @name Creation
+	// @{
+	public:
+		//! Opens the file using the current IO::AbstractFileSystemHandler.
+		static File * open(const std::string & filename,IO::openMode_t mode,Type * type = nullptr);
+		File(const std::string & _filename,IO::AbstractFileHandle * _handle,Type * type = nullptr) :
+				Object(type?type:getTypeObject()),filename(_filename),handle(_handle),readCursor(0){}
+		//! Writes pending data; errors are ignored (call close() to detect them).
+		virtual ~File();
+	//	@}
+
+	//! @name TypeObject
+	// @{
+	public:
+		static Type* getTypeObject();
+		static void init(EScript::Namespace & lib);
+	//	@}
+
+	//! @name Data
+	// @{
+	public:
+		static const size_t BUFFER_SIZE = 1<<16;
+	private:
+		std::string filename;
+		std::unique_ptr<IO::AbstractFileHandle> handle; //!< nullptr iff closed
+		std::string readBuffer;
+		size_t readCursor;		//!< position of the next unread byte in the readBuffer
+		std::string writeBuffer;
+
+		IO::AbstractFileHandle & getHandle();
+		void discardReadBuffer();
+		bool fillReadBuffer();
+		void flushWriteBuffer();
+	public:
+		const std::string & getFilename()const	{	return filename;	}
+		bool isOpen()const						{	return handle!=nullptr;	}
+		void close();
+		void flush();
+		//! Returns true iff there are no more bytes to read.
+		bool isEOF();
+		/*! Read the next line (without the line break "\n" or "\r\n").
+			Returns false if the end of the file has been reached before reading anything.	*/
+		bool readLine(std::string & line);
+		//! Read up to size bytes (fewer at the end of the file).
+		std::string read(size_t size);
+		//! Read the remaining bytes.
+		std::string readAll();
+		void seek(uint64_t position);
+		uint64_t tell();
+		void write(const char * data,size_t size);
+		void write(const std::string & s)		{	write(s.data(),s.length());	}
+	//	@}
+};
+}
+
+#endif // ES_FILE_H
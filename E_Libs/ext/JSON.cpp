@@ -7,236 +7,653 @@
 #include "../../EScript/Basics.h"
 #include "../../EScript/StdObjects.h"
 #include "../../EScript/Utils/StringUtils.h"
-#include "../../EScript/Compiler/Tokenizer.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define ES_JSON_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace EScript{
 
-//! (static)
-std::string JSON::toJSON(Object * obj,bool formatted/*=true*/){
-	std::ostringstream s;
-	JSON::toJSON(s,obj,formatted);
-	return s.str();
-}
+// ------------------------------------------------------------------
+// serialization
 
-//! (static)
-void JSON::toJSON(std::ostringstream & out,Object * obj,bool formatted/*=true*/,int level/*=0*/){
-	if(dynamic_cast<Void *>(obj) || (obj==nullptr) ){
-		out<<"null";
-	}else if(Object * number = dynamic_cast<Number *>(obj)){
-		out<<number->toFloat();
-	}else if(Bool * b = dynamic_cast<Bool *>(obj)){
-		out<<b->toString();
-	}else if(String * s = dynamic_cast<String *>(obj)){
-		out<<"\""<<StringUtils::escape(s->toString())<<"\"";
-	}else if(Array * a = dynamic_cast<Array *>(obj)){
-		ERef<Iterator> itRef = dynamic_cast<Iterator *>(a->getIterator());
-
-		out<<"[";
-		if(formatted){
-			out<<"\n";
-		}
-		bool first = true;
-		while( (!itRef.isNull()) && (! itRef->end())) {
-			ObjRef valueRef = itRef->value();
-			if(first){
-				first = false;
-			}else{
-				out<<",";
-				if(formatted){
-					out<<"\n";
-				}
-			}
-			if(formatted){
-				for(int j = 0;j<level+1;++j)
-					out <<"\t";
-			}
-			toJSON(out,valueRef.get(),formatted,level+1);
-			itRef->next();
-		}
-		if(formatted){
-			out <<"\n";
-			for(int j = 0;j<level;++j)
-				out <<"\t";
-		}
-		out<<"]";
-	}else if(Map * m = dynamic_cast<Map *>(obj)){
-		ERef<Iterator> itRef = dynamic_cast<Iterator *>(m->getIterator());
-		out<<"{";
-		if(formatted){
-			out<<"\n";
-		}
-		bool first = true;
-		while( (!itRef.isNull()) && (! itRef->end())) {
-
-			ObjRef keyRef = itRef->key();
-			ObjRef valueRef = itRef->value();
-			if(first){
-				first = false;
-			}else{
-				out<<",";
-				if(formatted){
-					out<<"\n";
-				}
+namespace JSONSerialization{
+
+/*! (internal) Writes the JSON representation of objects into a growable buffer.
+	If an output stream is given, the buffer is flushed whenever it exceeds FLUSH_SIZE.	*/
+class Writer{
+		static const size_t FLUSH_SIZE = 1<<16;
+		std::string & buffer;
+		std::ostream * out;
+		const bool formatted;
+
+		void indent(int level){
+			buffer += '\n';
+			buffer.append(static_cast<size_t>(level),'\t');
+		}
+		void writeString(const std::string & s);
+		void writeNumber(double value);
+		void writeArray(const Array * a,int level);
+		void writeMap(Map * m,int level);
+	public:
+		Writer(std::string & _buffer,std::ostream * _out,bool _formatted) :
+				buffer(_buffer),out(_out),formatted(_formatted){}
+		void write(Object * obj,int level);
+		void flush(){
+			if(out!=nullptr && !buffer.empty()){
+				out->write(buffer.data(),static_cast<std::streamsize>(buffer.size()));
+				buffer.clear();
 			}
-			if(formatted){
-				for(int j = 0;j<level+1;++j)
-					out <<"\t";
+		}
+};
+
+//! (internal) Characters that have to be escaped: '"', '\\' and the control characters.
+static inline bool needsEscape(uint8_t c){
+	return c<0x20 || c=='"' || c=='\\';
+}
+
+void Writer::writeString(const std::string & s){
+	static const char * hexDigits = "0123456789abcdef";
+	buffer += '"';
+	const char * cursor = s.data();
+	const char * const end = cursor+s.length();
+	while(cursor<end){
+		// copy the unescaped characters in one block
+		const char * blockEnd = cursor;
+		while(blockEnd<end && !needsEscape(static_cast<uint8_t>(*blockEnd)))
+			++blockEnd;
+		buffer.append(cursor,blockEnd);
+		if(blockEnd==end)
+			break;
+		const char c = *blockEnd;
+		switch(c){
+			case '"':	buffer += "\\\"";	break;
+			case '\\':	buffer += "\\\\";	break;
+			case '\b':	buffer += "\\b";	break;
+			case '\f':	buffer += "\\f";	break;
+			case '\n':	buffer += "\\n";	break;
+			case '\r':	buffer += "\\r";	break;
+			case '\t':	buffer += "\\t";	break;
+			default:{
+				const char escaped[6] = {'\\','u','0','0',hexDigits[(c>>4)&0x0F],hexDigits[c&0x0F]};
+				buffer.append(escaped,6);
 			}
-			out<<"\""<<keyRef.toString()<<"\":"; // TODO! Escape
-			toJSON(out,valueRef.get(),formatted,level+1);
+		}
+		cursor = blockEnd+1;
+	}
+	buffer += '"';
+}
 
-			itRef->next();
+/*! Integral values are written without exponent; all other values with the shortest
+	representation (up to 17 significant digits) that is read back as the same double.
+	Non-finite values are not representable in JSON and are written as null.	*/
+void Writer::writeNumber(double value){
+	if(value!=value || value-value!=0.0){ // NaN or infinite
+		buffer += "null";
+		return;
+	}
+	char digits[32];
+	if(value>-1.0e15 && value<1.0e15 && value==static_cast<double>(static_cast<int64_t>(value))){
+		int64_t i = static_cast<int64_t>(value);
+		char * cursor = digits+sizeof(digits);
+		const bool negative = i<0;
+		if(negative)
+			i = -i;
+		do{
+			*--cursor = static_cast<char>('0'+i%10);
+			i /= 10;
+		}while(i!=0);
+		if(negative)
+			*--cursor = '-';
+		buffer.append(cursor,digits+sizeof(digits));
+		return;
+	}
+	for(int precision=15; precision<=17; ++precision){
+		const int length = snprintf(digits,sizeof(digits),"%.*g",precision,value);
+		if(precision==17 || std::strtod(digits,nullptr)==value){
+			buffer.append(digits,static_cast<size_t>(length));
+			return;
 		}
-		if(formatted){
-			out <<"\n";
-			for(int j = 0;j<level;++j)
-				out <<"\t";
+	}
+}
+
+void Writer::writeArray(const Array * a,int level){
+	buffer += '[';
+	if(formatted)
+		buffer += '\n';
+	bool first = true;
+	for(size_t i=0,size=a->size(); i<size; ++i){
+		if(first){
+			first = false;
+		}else{
+			buffer += ',';
+			if(formatted)
+				buffer += '\n';
 		}
-		out<<"}";
-	}//  todo Object
-	else {
-		out<<"\""<<obj->toString()<<"\"";
+		if(formatted)
+			buffer.append(static_cast<size_t>(level+1),'\t');
+		write(a->get(i),level+1);
 	}
+	if(formatted)
+		indent(level);
+	buffer += ']';
 }
 
-//! helper
-static Object * _parseJSON(Tokenizer::tokenList_t::iterator & cursor,const Tokenizer::tokenList_t::iterator end){
-	if(cursor==end)
-		return nullptr;
-	Token * token=(*cursor).get();
-	if( Token::isA<TOperator>(token)&& token->toString()=="_-"){ /// unary minus
-		++cursor;
-		TValueNumber * tObj = Token::cast<TValueNumber>(*cursor);
-		if(tObj==nullptr ){
-			std::cout << "Number expected! \n";
-			return nullptr;
+void Writer::writeMap(Map * m,int level){
+	buffer += '{';
+	if(formatted)
+		buffer += '\n';
+	bool first = true;
+	for(const auto & entry : **m){
+		if(first){
+			first = false;
+		}else{
+			buffer += ',';
+			if(formatted)
+				buffer += '\n';
 		}
-		++cursor;
+		if(formatted)
+			buffer.append(static_cast<size_t>(level+1),'\t');
+		const Object * key = entry.key.get();
+		if(key!=nullptr && key->_getInternalTypeId()==_TypeIds::TYPE_STRING){
+			writeString(static_cast<const String*>(key)->getString());
+		}else{
+			writeString(entry.key.toString());
+		}
+		buffer += ':';
+		write(entry.value.get(),level+1);
+	}
+	if(formatted)
+		indent(level);
+	buffer += '}';
+}
 
-		return create(-tObj->getValue());
-	}else if(TValueBool * tb = Token::cast<TValueBool>(token)){
-		++cursor;
-		return create(tb->getValue());
-	}else if(TValueNumber * tn = Token::cast<TValueNumber>(token)){
-		++cursor;
-		return create(tn->getValue());
-	}else if(TValueString * ts = Token::cast<TValueString>(token)){
-		++cursor;
-		return create(ts->getValue());
-	}else if(Token::isA<TValueVoid>(token)){
-		++cursor;
-		return create(nullptr);
-	}else if(Token::isA<TStartBlock>(token)){
-		Map *m = Map::create();
+void Writer::write(Object * obj,int level){
+	if(obj==nullptr){
+		buffer += "null";
+		return;
+	}
+	switch(obj->_getInternalTypeId()){
+		case _TypeIds::TYPE_VOID:
+			buffer += "null";
+			break;
+		case _TypeIds::TYPE_NUMBER:
+			writeNumber(obj->toDouble());
+			break;
+		case _TypeIds::TYPE_BOOL:
+			buffer += obj->toBool() ? "true" : "false";
+			break;
+		case _TypeIds::TYPE_STRING:
+			writeString(static_cast<String*>(obj)->getString());
+			break;
+		case _TypeIds::TYPE_ARRAY:
+			writeArray(static_cast<Array*>(obj),level);
+			break;
+		case _TypeIds::TYPE_MAP:
+			writeMap(static_cast<Map*>(obj),level);
+			break;
+		default:	//  todo Object
+			writeString(obj->toString());
+	}
+	if(buffer.size()>=FLUSH_SIZE)
+		flush();
+}
+
+}
+
+//! (static)
+std::string JSON::toJSON(Object * obj,bool formatted/*=true*/){
+	std::string buffer;
+	JSONSerialization::Writer(buffer,nullptr,formatted).write(obj,0);
+	return buffer;
+}
+
+//! (static)
+void JSON::toJSON(std::ostream & out,Object * obj,bool formatted/*=true*/){
+	std::string buffer;
+	JSONSerialization::Writer writer(buffer,&out,formatted);
+	writer.write(obj,0);
+	writer.flush();
+}
+
+// ------------------------------------------------------------------
+// parsing
+
+namespace JSONParsing{
+
+static const size_t MAX_DEPTH = 1000;
+
+//! (internal) Returns the position of the first '"' or '\\' in [cursor,end) or end.
+static const char * findQuoteOrBackslash(const char * cursor,const char * end){
+#ifdef ES_JSON_SSE2
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	for(; cursor+16<=end; cursor+=16){
+		const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+		const int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block,quote),_mm_cmpeq_epi8(block,backslash)));
+		if(mask!=0)
+			return cursor+__builtin_ctz(mask);
+	}
+#endif
+	while(cursor<end && *cursor!='"' && *cursor!='\\')
 		++cursor;
-		while( true){
-			if(cursor==end){
-				std::cout << "M1 \n";
-				break;
-			}else  if( Token::isA<TEndBlock>(*cursor)){
-				++cursor;
-				break;
-			}
-			TValueString * key= Token::cast<TValueString>(*cursor); 
-			if(!key){
-				std::cout << "string expected \n";
-				break;
+	return cursor;
+}
+
+//! (internal)
+static void appendUTF8(std::string & s,uint32_t codePoint){
+	if(codePoint<0x80){
+		s += static_cast<char>(codePoint);
+	}else if(codePoint<0x800){
+		s += static_cast<char>(0xC0 | (codePoint>>6));
+		s += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}else if(codePoint<0x10000){
+		s += static_cast<char>(0xE0 | (codePoint>>12));
+		s += static_cast<char>(0x80 | ((codePoint>>6) & 0x3F));
+		s += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}else{
+		s += static_cast<char>(0xF0 | (codePoint>>18));
+		s += static_cast<char>(0x80 | ((codePoint>>12) & 0x3F));
+		s += static_cast<char>(0x80 | ((codePoint>>6) & 0x3F));
+		s += static_cast<char>(0x80 | (codePoint & 0x3F));
+	}
+}
+
+/*! (internal) Single pass recursive descent parser.
+	Handler_T has to provide the methods of JSON::Handler; they are called without virtual dispatch
+	if Handler_T is not JSON::Handler itself.	*/
+template<class Handler_T>
+class Parser{
+		const char * const begin;
+		const char * const end;
+		const char * cursor;
+		Handler_T & handler;
+		JSON::ParseError & error;
+		std::string buffer;
+		size_t depth;
+
+		bool fail(const std::string & message){
+			error.message = message;
+			error.line = 1;
+			const char * lineBegin = begin;
+			for(const char * c = begin; c<cursor; ++c){
+				if(*c=='\n'){
+					++error.line;
+					lineBegin = c+1;
+				}
 			}
-			++cursor;
-			if(cursor==end){
-				std::cout << "M3! \n";
-				break;
-			}else if(!Token::isA<TColon>(*cursor)){
-				std::cout << "':' expected \n";
-				break;
+			error.column = static_cast<size_t>(cursor-lineBegin)+1;
+			return false;
+		}
+		bool failUnexpected(const char * expected){
+			if(cursor>=end)
+				return fail(std::string("Unexpected end of data; expected ")+expected+".");
+			return fail(std::string("Unexpected character '")+*cursor+"'; expected "+expected+".");
+		}
+		void skipWhitespace(){
+			while(cursor<end && (*cursor==' ' || *cursor=='\n' || *cursor=='\t' || *cursor=='\r'))
+				++cursor;
+		}
+		bool readWord(const char * word,size_t length){
+			if(static_cast<size_t>(end-cursor)<length || std::memcmp(cursor,word,length)!=0)
+				return false;
+			cursor += length;
+			return true;
+		}
+		bool readHex4(uint32_t & value){
+			if(end-cursor<4)
+				return fail("Incomplete unicode escape sequence.");
+			value = 0;
+			for(int i = 0; i<4; ++i,++cursor){
+				const char c = *cursor;
+				value <<= 4;
+				if(c>='0' && c<='9')		value |= static_cast<uint32_t>(c-'0');
+				else if(c>='a' && c<='f')	value |= static_cast<uint32_t>(c-'a'+10);
+				else if(c>='A' && c<='F')	value |= static_cast<uint32_t>(c-'A'+10);
+				else return fail("Invalid unicode escape sequence.");
 			}
+			return true;
+		}
+		//! Reads the string starting at the cursor (pointing to the quote) into buffer.
+		bool readString(){
+			const char quote = *cursor;
 			++cursor;
-			if(cursor==end){
-				std::cout << "M4! \n";
-				break;
-			}
-			Object * o = _parseJSON(cursor,end);
-			if(!o){
-
-				std::cout << "M5! \n"<<(*cursor)->toString()<<"\n";
-				break;
-			}
-			m->setValue(String::create(key->getValue()),o);
-//            ++cursor;
-			if(cursor==end){
-				std::cout << "unexpected ending. \n";
-				break;
-			}else  if(Token::isA<TEndBlock>(*cursor)){
+			buffer.clear();
+			while(true){
+				const char * stop = quote=='"' ? findQuoteOrBackslash(cursor,end) : cursor;
+				while(stop<end && *stop!=quote && *stop!='\\')
+					++stop;
+				buffer.append(cursor,stop);
+				cursor = stop;
+				if(cursor>=end)
+					return fail("Unterminated string.");
+				if(*cursor==quote){
+					++cursor;
+					return true;
+				}
+				// escape sequence
 				++cursor;
-				break;
-			}else if(Token::isA<TDelimiter>(*cursor)){
+				if(cursor>=end)
+					return fail("Unterminated string.");
+				switch(*cursor){
+					case '"':	buffer += '"';	break;
+					case '\\':	buffer += '\\';	break;
+					case '/':	buffer += '/';	break;
+					case 'b':	buffer += '\b';	break;
+					case 'f':	buffer += '\f';	break;
+					case 'n':	buffer += '\n';	break;
+					case 'r':	buffer += '\r';	break;
+					case 't':	buffer += '\t';	break;
+					case '0':	buffer += '\0';	break;	// legacy
+					case 'a':	buffer += '\a';	break;	// legacy
+					case '\'':	buffer += '\'';	break;	// legacy
+					case 'u':{
+						++cursor;
+						uint32_t codePoint;
+						if(!readHex4(codePoint))
+							return false;
+						if(codePoint>=0xD800 && codePoint<0xDC00 && end-cursor>=6 && cursor[0]=='\\' && cursor[1]=='u'){ // surrogate pair
+							const char * lowBegin = cursor;
+							cursor += 2;
+							uint32_t low;
+							if(!readHex4(low))
+								return false;
+							if(low>=0xDC00 && low<0xE000){
+								codePoint = 0x10000 + ((codePoint-0xD800)<<10) + (low-0xDC00);
+							}else{
+								cursor = lowBegin;
+							}
+						}
+						if(codePoint>=0xD800 && codePoint<0xE000) // lone surrogate
+							codePoint = 0xFFFD;
+						appendUTF8(buffer,codePoint);
+						continue;
+					}
+					default:
+						return fail(std::string("Invalid escape sequence '\\")+*cursor+"'.");
+				}
 				++cursor;
-				continue;
 			}
-			std::cout << "',' or '}' expected \n";
-			std::cout <<(*cursor)->toString()<<"\n";
-			break;
 		}
-		return m;
-	}else if(Token::isA<TStartIndex>(token)){
-		Array *a = Array::create();
-		++cursor;
-		while( true){
-			if(cursor==end){
-				std::cout << "A1! \n";
-				break;
-			}else if(Token::isA<TEndIndex>(*cursor)){
+		bool readNumber(){
+			static const double powersOf10[] = { 1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+												1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22 };
+			const char * numberBegin = cursor;
+			const bool negative = *cursor=='-';
+			if(negative)
+				++cursor;
+			if(cursor>=end || *cursor<'0' || *cursor>'9')
+				return failUnexpected("a digit");
+			uint64_t mantissa = 0;
+			int numDigits = 0;
+			int exponent = 0;
+			if(*cursor=='0'){
 				++cursor;
-				break;
+			}else{
+				for(; cursor<end && *cursor>='0' && *cursor<='9'; ++cursor,++numDigits)
+					mantissa = mantissa*10 + static_cast<uint64_t>(*cursor-'0');
 			}
-			Object * o = _parseJSON(cursor,end);
-			if(!o){
-				std::cout << "A2! \n";
-				break;
+			if(cursor<end && *cursor=='.'){
+				++cursor;
+				if(cursor>=end || *cursor<'0' || *cursor>'9')
+					return failUnexpected("a digit");
+				for(; cursor<end && *cursor>='0' && *cursor<='9'; ++cursor){
+					if(mantissa!=0 || *cursor!='0')
+						++numDigits;
+					mantissa = mantissa*10 + static_cast<uint64_t>(*cursor-'0');
+					--exponent;
+				}
 			}
-			a->pushBack(o);
-//            ++cursor;
-			if(cursor==end){
-				std::cout << "A3! \n";
-				break;
-			}else  if(Token::isA<TEndIndex>(*cursor)){
+			if(cursor<end && (*cursor=='e' || *cursor=='E')){
 				++cursor;
-				break;
-			}else if(Token::isA<TDelimiter>(*cursor)){
+				bool negativeExponent = false;
+				if(cursor<end && (*cursor=='+' || *cursor=='-')){
+					negativeExponent = *cursor=='-';
+					++cursor;
+				}
+				if(cursor>=end || *cursor<'0' || *cursor>'9')
+					return failUnexpected("a digit");
+				int e = 0;
+				for(; cursor<end && *cursor>='0' && *cursor<='9'; ++cursor){
+					if(e<100000)
+						e = e*10 + (*cursor-'0');
+				}
+				exponent += negativeExponent ? -e : e;
+			}
+			double value;
+			if(numDigits<=15 && exponent>=-22 && exponent<=22){ // exact: mantissa and 10^|exponent| are representable
+				value = static_cast<double>(mantissa);
+				value = exponent<0 ? value/powersOf10[-exponent] : value*powersOf10[exponent];
+				if(negative)
+					value = -value;
+			}else{
+				value = std::strtod(std::string(numberBegin,cursor).c_str(),nullptr);
+			}
+			return handler.onNumber(value);
+		}
+		bool readMap(){
+			++cursor; // '{'
+			if(!handler.onStartMap())
+				return false;
+			while(true){
+				skipWhitespace();
+				if(cursor<end && *cursor=='}')
+					break;
+				if(cursor>=end || (*cursor!='"' && *cursor!='\''))
+					return failUnexpected("a string as key or '}'");
+				if(!readString() || !handler.onKey(buffer))
+					return false;
+				skipWhitespace();
+				if(cursor>=end || *cursor!=':')
+					return failUnexpected("':'");
 				++cursor;
-				continue;
+				if(!readValue())
+					return false;
+				skipWhitespace();
+				if(cursor<end && *cursor==','){
+					++cursor;
+					continue;
+				}else if(cursor<end && *cursor=='}'){
+					break;
+				}
+				return failUnexpected("',' or '}'");
 			}
-			std::cout << "A4! \n";
-			std::cout <<(*cursor)->toString()<<"\n";
-			break;
+			++cursor; // '}'
+			return handler.onEndMap();
 		}
-		return a;
-	}
-	else if(TIdentifier* ti = Token::cast<TIdentifier>(token)){
-		std::cout << "Unknown Identifier: "<<ti->toString()<<"\n";
-		return nullptr;
+		bool readArray(){
+			++cursor; // '['
+			if(!handler.onStartArray())
+				return false;
+			while(true){
+				skipWhitespace();
+				if(cursor<end && *cursor==']')
+					break;
+				if(!readValue())
+					return false;
+				skipWhitespace();
+				if(cursor<end && *cursor==','){
+					++cursor;
+					continue;
+				}else if(cursor<end && *cursor==']'){
+					break;
+				}
+				return failUnexpected("',' or ']'");
+			}
+			++cursor; // ']'
+			return handler.onEndArray();
+		}
+		bool readValue(){
+			skipWhitespace();
+			if(cursor>=end)
+				return failUnexpected("a value");
+			switch(*cursor){
+				case '{':
+				case '[':{
+					if(++depth>MAX_DEPTH)
+						return fail("Maximum nesting depth exceeded.");
+					const bool result = *cursor=='{' ? readMap() : readArray();
+					--depth;
+					return result;
+				}
+				case '"':
+				case '\'':
+					return readString() && handler.onString(buffer);
+				case 't':
+					if(readWord("true",4))
+						return handler.onBool(true);
+					break;
+				case 'f':
+					if(readWord("false",5))
+						return handler.onBool(false);
+					break;
+				case 'n':
+					if(readWord("null",4))
+						return handler.onNull();
+					break;
+				case 'v':
+					if(readWord("void",4))	// legacy
+						return handler.onNull();
+					break;
+				default:
+					if(*cursor=='-' || (*cursor>='0' && *cursor<='9'))
+						return readNumber();
+			}
+			return failUnexpected("a value");
+		}
+	public:
+		Parser(const char * _begin,const char * _end,Handler_T & _handler,JSON::ParseError & _error) :
+				begin(_begin),end(_end),cursor(_begin),handler(_handler),error(_error),depth(0){}
 
-	}
-	return nullptr;
+		bool run(){
+			if(!readValue())
+				return false;
+			skipWhitespace();
+			if(cursor<end)
+				return fail(std::string("Unexpected character '")+*cursor+"' after the value.");
+			return true;
+		}
+};
+
+//! (internal) Handler creating the corresponding objects.
+class ObjectBuilder{
+		struct Level{
+			ObjRef container;
+			Array * array;	//!< nullptr if the container is a Map
+			ObjRef key;
+			Level(Array * a) : container(a),array(a){}
+			Level(Map * m) : container(m),array(nullptr){}
+		};
+		std::vector<Level> levels;
+		ObjRef result;
+
+		bool add(Object * value){
+			if(levels.empty()){
+				result = value;
+			}else{
+				Level & level = levels.back();
+				if(level.array)
+					level.array->pushBack(value);
+				else
+					static_cast<Map*>(level.container.get())->setValue(level.key,value);
+			}
+			return true;
+		}
+	public:
+		Object * detachResult()					{	return result.detachAndDecrease();	}
+
+		bool onNull()							{	return add(Void::get());	}
+		bool onBool(bool value)					{	return add(Bool::create(value));	}
+		bool onNumber(double value)				{	return add(Number::create(value));	}
+		bool onString(const std::string & value){	return add(String::create(value));	}
+		bool onKey(const std::string & key){
+			levels.back().key = String::create(key);
+			return true;
+		}
+		bool onStartMap(){
+			Map * m = Map::create();
+			add(m);
+			levels.emplace_back(m);
+			return true;
+		}
+		bool onEndMap(){
+			levels.pop_back();
+			return true;
+		}
+		bool onStartArray(){
+			Array * a = Array::create();
+			add(a);
+			levels.emplace_back(a);
+			return true;
+		}
+		bool onEndArray(){
+			levels.pop_back();
+			return true;
+		}
+};
+
+//! (internal) Handler passing the events to a script function.
+class CallbackHandler : public JSON::Handler{
+		Runtime & runtime;
+		ObjRef callback;
+
+		bool call(const char * event,Object * value){
+			callFunction(runtime,callback.get(),ParameterValues(String::create(event),value));
+			return runtime.checkNormalState();
+		}
+	public:
+		CallbackHandler(Runtime & _runtime,const ObjPtr & _callback) : runtime(_runtime),callback(_callback.get()){}
+		virtual ~CallbackHandler(){}
+
+		virtual bool onNull()							{	return call("value",Void::get());	}
+		virtual bool onBool(bool value)					{	return call("value",Bool::create(value));	}
+		virtual bool onNumber(double value)				{	return call("value",Number::create(value));	}
+		virtual bool onString(const std::string & value){	return call("value",String::create(value));	}
+		virtual bool onKey(const std::string & key)		{	return call("key",String::create(key));	}
+		virtual bool onStartMap()						{	return call("startMap",Void::get());	}
+		virtual bool onEndMap()							{	return call("endMap",Void::get());	}
+		virtual bool onStartArray()						{	return call("startArray",Void::get());	}
+		virtual bool onEndArray()						{	return call("endArray",Void::get());	}
+};
+
+}
+
+std::string JSON::ParseError::toString()const{
+	std::ostringstream s;
+	s << "JSON: " << message << " (line " << line << ", column " << column << ")";
+	return s.str();
+}
+
+//! (static)
+bool JSON::parse(const char * begin,const char * end,Handler & handler,ParseError & error){
+	return JSONParsing::Parser<Handler>(begin,end,handler,error).run();
+}
+
+//! (static)
+Object * JSON::parse(const char * begin,const char * end,ParseError & error){
+	JSONParsing::ObjectBuilder builder;
+	if(!JSONParsing::Parser<JSONParsing::ObjectBuilder>(begin,end,builder,error).run())
+		return nullptr; // the partial result is released by the builder
+	return builder.detachResult();
+}
+
+//! (static)
+bool JSON::rt_parse(Runtime & runtime,const char * begin,const char * end,const ObjPtr & callback,ParseError & error){
+	JSONParsing::CallbackHandler handler(runtime,callback);
+	return parse(begin,end,handler,error);
 }
 
 //! (static)
 Object* JSON::parseJSON(const std::string &s){
-	Tokenizer t;
-
-	Tokenizer::tokenList_t tokens;
-	t.getTokens(s.c_str(),tokens);
-	Tokenizer::tokenList_t::iterator it = tokens.begin();
-	Object * result= _parseJSON(it,tokens.end());
-	if(it!=tokens.end() && !Token::isA<TEndScript>(*it)){
-		std::cout << "JSON Syntax Error\n";
-	}
-	if(result==nullptr){
-		result = create(s);
-	}
-//	for(it = tokens.begin();it!=tokens.end();++it){
-//		Token::removeReference(*it);
-//	}
-	return result;
+	ParseError error;
+	Object * result = parse(s.data(),s.data()+s.length(),error);
+	return result ? result : create(s);
 }
 }
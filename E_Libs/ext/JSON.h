@@ -4,19 +4,77 @@
 // ------------------------------------------------------
 #ifndef ESCRIPT_JSON_H
 #define ESCRIPT_JSON_H
+#include "../../EScript/Utils/ObjRef.h"
+#include <cstddef>
 #include <string>
-#include <sstream>
+#include <iosfwd>
 
 namespace EScript {
 class Object;
+class Runtime;
 
 /**
  *	JSON support for EScript
  *	[static-helper]
+ *
+ *	The parser reads standard JSON (RFC 8259) in a single pass. For compatibility with the
+ *	former Tokenizer based parser, it additionally accepts 'void' (as null), single quoted strings,
+ *	the escape sequences \0, \a and \' and a trailing comma in arrays and maps.
  */
 struct JSON	{
-	static void toJSON(std::ostringstream & out,Object * obj,bool formatted = true,int level = 0);
+	/*! Receiver of the values read by JSON::parse(...) (SAX style).
+		If a method returns false, the parsing is stopped.	*/
+	class Handler{
+		public:
+			virtual ~Handler(){}
+			virtual bool onNull() = 0;
+			virtual bool onBool(bool value) = 0;
+			virtual bool onNumber(double value) = 0;
+			virtual bool onString(const std::string & value) = 0;
+			//! The key of the following value inside of a map.
+			virtual bool onKey(const std::string & key) = 0;
+			virtual bool onStartMap() = 0;
+			virtual bool onEndMap() = 0;
+			virtual bool onStartArray() = 0;
+			virtual bool onEndArray() = 0;
+	};
+
+	//! Description of a syntax error.
+	struct ParseError{
+		std::string message;	//!< empty if there is no error
+		size_t line;			//!< starting at 1
+		size_t column;			//!< starting at 1; counted in bytes
+		ParseError() : line(0),column(0){}
+		bool isSet()const	{	return !message.empty();	}
+		//! "JSON: message (line l, column c)"
+		std::string toString()const;
+	};
+
+	/*! Returns the JSON representation of obj. Maps and Arrays are written recursively; other objects
+		are written as their (escaped) string representation. Numbers are written with the shortest
+		representation that is read back as the same value (non-finite values become null).
+		If formatted is false, no whitespace is written.	*/
 	static std::string toJSON(Object * obj,bool formatted = true);
+	//! Write the JSON representation of obj to the stream (in blocks of 64k).
+	static void toJSON(std::ostream & out,Object * obj,bool formatted = true);
+
+	/*! Read the JSON data in [begin,end) and pass the values to the handler.
+		\return true iff the data has been read completely. If false is returned and
+				the error is not set, the parsing has been stopped by the handler.	*/
+	static bool parse(const char * begin,const char * end,Handler & handler,ParseError & error);
+
+	/*! Read the JSON data in [begin,end) and create the corresponding objects
+		(Map, Array, String, Number, Bool or Void).
+		\return the value or nullptr on a syntax error	*/
+	static Object * parse(const char * begin,const char * end,ParseError & error);
+
+	/*! Read the JSON data in [begin,end) and call callback(event,value) for each event.
+		The events are "startMap", "key" (value is the key), "endMap", "startArray", "endArray" and
+		"value" (value is the String, Number, Bool or void). An exception thrown by the callback
+		stops the parsing.	*/
+	static bool rt_parse(Runtime & runtime,const char * begin,const char * end,const ObjPtr & callback,ParseError & error);
+
+	//! Returns the value or, on a syntax error, a String containing s.
 	static Object* parseJSON(const std::string &s);
 };
 
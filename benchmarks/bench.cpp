@@ -0,0 +1,270 @@
+// bench.cpp
+// This file is part of the EScript programming language.
+// See copyright notice in EScript.h
+// ------------------------------------------------------
+#ifdef ES_BUILD_BENCHMARK_APPLICATION
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../EScript/EScript.h"
+#include "../EScript/Utils/IO/IO.h"
+#include "../E_Libs/ext/JSON.h"
+
+using namespace EScript;
+
+/*! escript_bench
+	Runs the workloads in the benchmark directory and reports the timings as JSON.
+	Each workload is a script 'micro_*.escript' or 'macro_*.escript' that prepares its data and returns
+	the function to measure. The function is called --warmup times without measuring and then --runs times.
+	For each workload, the minimum, median and 95th percentile of the durations (in ms) and the median
+	number of allocations (calls of operator new) per run are reported.
+	With --baseline, the medians are compared to those of a previously written result file; a workload
+	whose median is more than --threshold percent slower is reported as regression and the exit code is 1.
+
+	Usage: escript_bench [--dir path] [--warmup n] [--runs n] [--output file.json]
+						[--baseline file.json] [--threshold percent] [workload names...]	*/
+
+// ---------------------------------------------------------
+// allocation counting
+
+static std::atomic<uint64_t> allocationCounter(0);
+
+void * operator new(std::size_t size){
+	allocationCounter.fetch_add(1,std::memory_order_relaxed);
+	if(void * p = std::malloc(size==0 ? 1 : size))
+		return p;
+	throw std::bad_alloc();
+}
+void operator delete(void * p) noexcept{
+	std::free(p);
+}
+
+// ---------------------------------------------------------
+
+struct Options{
+	std::string dir;
+	uint32_t warmup;
+	uint32_t runs;
+	std::string outputFile;
+	std::string baselineFile;
+	double threshold; //!< in percent
+	std::vector<std::string> workloads;
+	Options() : dir(ES_BENCHMARK_DIR),warmup(3),runs(20),threshold(10.0){}
+};
+
+struct Result{
+	std::string name;
+	double minMs,medianMs,p95Ms;
+	uint64_t allocations;
+	std::string error; //!< empty on success
+	Result(const std::string & _name) : name(_name),minMs(0),medianMs(0),p95Ms(0),allocations(0){}
+};
+
+static std::string getWorkloadName(const std::string & filename){
+	const size_t slash = filename.find_last_of("/\\");
+	const std::string name = slash==std::string::npos ? filename : filename.substr(slash+1);
+	return name.substr(0,name.length()-std::string(".escript").length());
+}
+
+static bool isWorkloadFile(const std::string & filename){
+	static const std::string suffix(".escript");
+	const size_t slash = filename.find_last_of("/\\");
+	const std::string file = slash==std::string::npos ? filename : filename.substr(slash+1);
+	return file.length()>suffix.length() && file.compare(file.length()-suffix.length(),suffix.length(),suffix)==0 &&
+			(file.compare(0,6,"micro_")==0 || file.compare(0,6,"macro_")==0);
+}
+
+//! Nearest rank percentile of the sorted values.
+static double getPercentile(const std::vector<double> & sortedValues,double percent){
+	size_t rank = static_cast<size_t>(std::ceil(percent/100.0*sortedValues.size()));
+	return sortedValues[std::min(std::max(rank,static_cast<size_t>(1)),sortedValues.size())-1];
+}
+
+static Result runWorkload(const std::string & filename,const Options & options){
+	Result result(getWorkloadName(filename));
+	ERef<Runtime> rt(new Runtime);
+	const std::pair<bool,ObjRef> setup = loadAndExecute(*rt.get(),filename);
+	if(!setup.first || setup.second.isNull()){
+		result.error = "The workload does not return a function.";
+		return result;
+	}
+	const ObjRef fun = setup.second;
+	std::vector<double> durations;
+	std::vector<uint64_t> allocations;
+	try{
+		for(uint32_t i=0; i<options.warmup+options.runs; ++i){
+			const uint64_t allocationsBefore = allocationCounter.load();
+			const auto start = std::chrono::steady_clock::now();
+			rt->executeFunction(fun.get(),nullptr,ParameterValues());
+			const auto end = std::chrono::steady_clock::now();
+			if(i>=options.warmup){
+				durations.push_back(std::chrono::duration<double,std::milli>(end-start).count());
+				allocations.push_back(allocationCounter.load()-allocationsBefore);
+			}
+		}
+	}catch(Object * error){
+		result.error = error->toString();
+		return result;
+	}
+	std::sort(durations.begin(),durations.end());
+	std::sort(allocations.begin(),allocations.end());
+	result.minMs = durations.front();
+	result.medianMs = getPercentile(durations,50);
+	result.p95Ms = getPercentile(durations,95);
+	result.allocations = allocations[allocations.size()/2];
+	return result;
+}
+
+static std::string escapeJSON(const std::string & s){
+	std::string escaped;
+	for(const char c : s){
+		if(c=='"' || c=='\\'){
+			escaped += '\\';
+			escaped += c;
+		}else if(static_cast<unsigned char>(c)<0x20){
+			escaped += ' ';
+		}else{
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+static void writeJSON(std::ostream & out,const std::vector<Result> & results,const Options & options){
+	out << std::fixed << std::setprecision(4);
+	out << "{\n\t\"version\": " << ES_VERSION << ",\n\t\"warmup\": " << options.warmup << ",\n\t\"runs\": " << options.runs
+		<< ",\n\t\"workloads\": {";
+	for(size_t i=0; i<results.size(); ++i){
+		const Result & r = results[i];
+		out << (i==0 ? "\n" : ",\n") << "\t\t\"" << escapeJSON(r.name) << "\": {";
+		if(!r.error.empty()){
+			out << "\"error\": \"" << escapeJSON(r.error) << "\"}";
+		}else{
+			out << "\"min_ms\": " << r.minMs << ", \"median_ms\": " << r.medianMs << ", \"p95_ms\": " << r.p95Ms
+				<< ", \"allocations\": " << r.allocations << "}";
+		}
+	}
+	out << "\n\t}\n}\n";
+}
+
+/*! Compare the medians with the baseline and print a summary to std::cerr.
+	@return false if a workload is slower than allowed by the threshold.	*/
+static bool compareWithBaseline(const std::vector<Result> & results,const Options & options){
+	const std::string data = IO::loadFile(options.baselineFile).str();
+	JSON::ParseError parseError;
+	ObjRef baseline = JSON::parse(data.data(),data.data()+data.length(),parseError);
+	Map * root = dynamic_cast<Map*>(baseline.get());
+	Map * workloads = root==nullptr ? nullptr : dynamic_cast<Map*>(root->getValue("workloads"));
+	if(workloads==nullptr){
+		std::cerr << "Invalid baseline '" << options.baselineFile << "' " << parseError.toString() << "\n";
+		return false;
+	}
+	bool ok = true;
+	std::cerr << std::fixed << std::setprecision(3) << "\nComparison with '" << options.baselineFile << "' (threshold "
+			<< options.threshold << "%):\n";
+	for(const auto & r : results){
+		Map * entry = dynamic_cast<Map*>(workloads->getValue(r.name));
+		Object * baselineMedian = entry==nullptr ? nullptr : entry->getValue("median_ms");
+		std::cerr << "  " << std::left << std::setw(32) << r.name;
+		if(!r.error.empty() || baselineMedian==nullptr || baselineMedian->toDouble()<=0){
+			std::cerr << (r.error.empty() ? "no baseline\n" : "failed\n");
+			continue;
+		}
+		const double change = (r.medianMs/baselineMedian->toDouble()-1.0)*100.0;
+		const bool regression = change>options.threshold;
+		std::cerr << std::right << std::setw(10) << baselineMedian->toDouble() << " ms -> " << std::setw(10) << r.medianMs << " ms "
+				<< std::showpos << std::setw(8) << change << std::noshowpos << "%" << (regression ? "  REGRESSION" : "") << "\n";
+		ok &= !regression;
+	}
+	return ok;
+}
+
+static bool parseOptions(int argc,char * argv[],Options & options){
+	for(int i=1; i<argc; ++i){
+		const std::string arg(argv[i]);
+		const bool hasValue = i+1<argc;
+		if(arg=="--dir" && hasValue)
+			options.dir = argv[++i];
+		else if(arg=="--warmup" && hasValue)
+			options.warmup = static_cast<uint32_t>(std::strtoul(argv[++i],nullptr,10));
+		else if(arg=="--runs" && hasValue)
+			options.runs = std::max(static_cast<uint32_t>(std::strtoul(argv[++i],nullptr,10)),1u);
+		else if(arg=="--output" && hasValue)
+			options.outputFile = argv[++i];
+		else if(arg=="--baseline" && hasValue)
+			options.baselineFile = argv[++i];
+		else if(arg=="--threshold" && hasValue)
+			options.threshold = std::strtod(argv[++i],nullptr);
+		else if(arg.compare(0,2,"--")==0)
+			return false;
+		else
+			options.workloads.push_back(arg);
+	}
+	return true;
+}
+
+int main(int argc,char * argv[]) {
+	Options options;
+	if(!parseOptions(argc,argv,options)){
+		std::cerr << "Usage: escript_bench [--dir path] [--warmup n] [--runs n] [--output file.json]\n"
+				"                     [--baseline file.json] [--threshold percent] [workload names...]\n";
+		return 2;
+	}
+	EScript::init();
+
+	std::vector<std::string> files;
+	try{
+		for(const auto & file : IO::getFilesInDir(options.dir,1)){
+			if(isWorkloadFile(file) && (options.workloads.empty() ||
+					std::find(options.workloads.begin(),options.workloads.end(),getWorkloadName(file))!=options.workloads.end()))
+				files.push_back(file);
+		}
+	}catch(const std::ios_base::failure & e){
+		std::cerr << e.what() << "\n";
+		return 2;
+	}
+	std::sort(files.begin(),files.end());
+
+	std::vector<Result> results;
+	bool ok = true;
+	for(const auto & file : files){
+		std::cerr << std::left << std::setw(32) << getWorkloadName(file) << std::flush;
+		results.push_back(runWorkload(file,options));
+		const Result & r = results.back();
+		if(r.error.empty()){
+			std::cerr << std::fixed << std::setprecision(3) << "min " << r.minMs << " ms\tmedian " << r.medianMs
+					<< " ms\tp95 " << r.p95Ms << " ms\t" << r.allocations << " allocations\n";
+		}else{
+			std::cerr << "failed: " << r.error << "\n";
+			ok = false;
+		}
+	}
+
+	if(options.outputFile.empty()){
+		writeJSON(std::cout,results,options);
+	}else{
+		std::ofstream out(options.outputFile.c_str());
+		writeJSON(out,results,options);
+	}
+	if(!options.baselineFile.empty()){
+		try{
+			ok &= compareWithBaseline(results,options);
+		}catch(const std::ios_base::failure & e){
+			std::cerr << e.what() << "\n";
+			ok = false;
+		}
+	}
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+#endif // ES_BUILD_BENCHMARK_APPLICATION
@@ -97,6 +97,40 @@ int main(int argc,char * argv[]) {
 		std::cout << "\n\n --- "<<"\nResult: " << result.second.toString()<<"\n";
 	}
 
+	// --- Runtime created from a snapshot of the environment established by the tests
+	bool snapshotOk = false;
+	{
+		ERef<Runtime> rt2(new Runtime(Runtime::Snapshot(*rt.get())));
+		const std::pair<bool,ObjRef> r = EScript::eval(*rt2.get(),StringData(
+				"GLOBALS.snapshotTestVar := true;"
+				"testFunction(3)==9 && loadOnce('loadme.escript')===void && GLOBALS.GLOBALS==GLOBALS && SGLOBALS!=GLOBALS;"));
+		snapshotOk = r.first && r.second.toBool() && rt->getGlobals()->getAttribute("snapshotTestVar").isNull();
+	}
+	std::cout << "\nRuntime snapshot:\t" << (snapshotOk ? "ok" : "failed") << "\n";
+
+	// --- Execution suspended when the instruction budget is exceeded and resumed with a new budget
+	bool suspensionOk = false;
+	{
+		ERef<Runtime> rt2(new Runtime);
+		const std::pair<bool,ObjRef> f = EScript::eval(*rt2.get(),StringData(
+				"return fn(n){ var sum = 0; for(var i=0;i<n;++i) sum += (fn(x){return x*2;})(i); return sum; };"));
+		if(f.first && f.second.isNotNull()){
+			ParameterValues params(1);
+			params.set(0,EScript::create(1000));
+			rt2->setExecutionBudget(500,0,Runtime::BUDGET_SUSPEND);
+			ObjRef result = rt2->executeFunction(f.second,nullptr,params);
+			int suspensions = 0;
+			while(rt2->isSuspended() && suspensions<1000){
+				++suspensions;
+				rt2->setExecutionBudget(500,0,Runtime::BUDGET_SUSPEND);
+				result = rt2->resumeExecution();
+			}
+			suspensionOk = suspensions>5 && !rt2->isSuspended() && result.isNotNull() && result.toInt()==999000 &&
+					rt2->getStackSize()==0;
+		}
+	}
+	std::cout << "Runtime suspension:\t" << (suspensionOk ? "ok" : "failed") << "\n";
+
 	// --- cleanup
 	result.second = nullptr;
 	rt = nullptr;
@@ -104,6 +138,6 @@ int main(int argc,char * argv[]) {
 #ifdef ES_DEBUG_MEMORY
 	Debug::showObjects();
 #endif
-	return result.first ? EXIT_SUCCESS : EXIT_FAILURE;
+	return result.first && snapshotOk && suspensionOk ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 #endif // ES_BUILD_TEST_APPLICATION